@@ -30,6 +30,7 @@
 #include "battery.h"
 #include "timer.h"
 #include "common.h"
+#include "startup.h"
 
 gboolean bat1_has_font;
 PangoFontDescription *bat1_font_desc;
@@ -61,6 +62,8 @@ char *battery_rclick_command;
 char *battery_uwheel_command;
 char *battery_dwheel_command;
 gboolean battery_found;
+// TRUE until the batteries found at startup have been shown in the panels
+static gboolean battery_discovery_pending;
 gboolean battery_warn;
 gboolean battery_warn_red;
 
@@ -76,6 +79,7 @@ void default_battery()
     battery_enabled = FALSE;
     battery_tooltip_enabled = TRUE;
     battery_found = FALSE;
+    battery_discovery_pending = FALSE;
     percentage_hide = 101;
     battery_low_cmd_sent = FALSE;
     battery_full_cmd_sent = FALSE;
@@ -230,17 +234,34 @@ void battery_update_text(char *dest, char *format)
     }
 }
 
+static void discover_batteries(void *arg)
+{
+    battery_found = battery_os_init();
+    update_battery();
+}
+
+static void batteries_discovered(void *arg)
+{
+    battery_discovery_pending = FALSE;
+    update_battery_tick(NULL);
+}
+
 void init_battery()
 {
     if (!battery_enabled)
         return;
 
-    battery_found = battery_os_init();
+    if (!bat1_format && !bat2_format) {
+        bat1_format = strdup("%p");
+        bat2_format = strdup("%t");
+    }
 
     if (!battery_timer.enabled_)
         change_timer(&battery_timer, true, 30000, 30000, update_battery_tick, 0);
 
-    update_battery();
+    // Scanning sysfs does not need X, so at startup it runs on a worker thread
+    battery_discovery_pending = TRUE;
+    startup_task_run("battery", discover_batteries, batteries_discovered, NULL);
 }
 
 void reinit_battery()
@@ -281,11 +302,9 @@ void init_battery_panel(void *p)
         battery->area._get_tooltip_text = battery_get_tooltip;
     instantiate_area_gradients(&battery->area);
 
-    if (!bat1_format && !bat2_format) {
-        bat1_format = strdup("%p");
-        bat2_format = strdup("%t");
-    }
-    update_battery_tick(NULL);
+    // Otherwise batteries_discovered updates all the panels
+    if (!battery_discovery_pending)
+        update_battery_tick(NULL);
 }
 
 void battery_init_fonts()
@@ -347,12 +366,12 @@ void update_battery_tick(void *arg)
     gboolean old_warn = battery_warn;
 
     if (!battery_found) {
-        init_battery();
+        discover_batteries(NULL);
         old_ac_connected = battery_state.ac_connected;
     }
     if (update_battery() != 0) {
         // Try to reconfigure on failed update
-        init_battery();
+        discover_batteries(NULL);
     }
 
     if (old_ac_connected != battery_state.ac_connected) {
@@ -17,6 +17,7 @@
 #include "panel.h"
 #include "timer.h"
 #include "common.h"
+#include "icon-loader.h"
 
 char *button_get_tooltip(void *obj);
 void button_init_fonts();
@@ -52,6 +53,7 @@ void destroy_button(void *obj)
     Button *button = (Button *)obj;
     if (button->frontend) {
         // This is a frontend element
+        icon_loader_cancel(button);
         free_icon(button->frontend->icon);
         free_icon(button->frontend->icon_hover);
         free_icon(button->frontend->icon_pressed);
@@ -199,34 +201,15 @@ void button_default_font_changed()
     schedule_panel_redraw();
 }
 
-void button_reload_icon(Button *button)
+// Takes ownership of image (already scaled and adjusted)
+static void button_set_icon(Button *button, Imlib_Image image)
 {
     free_icon(button->frontend->icon);
     free_icon(button->frontend->icon_hover);
     free_icon(button->frontend->icon_pressed);
-    button->frontend->icon = NULL;
     button->frontend->icon_hover = NULL;
     button->frontend->icon_pressed = NULL;
-
-    button->frontend->icon_load_size = button->frontend->iconw;
-
-    if (!button->backend->icon_name)
-        return;
-
-    char *new_icon_path = get_icon_path(icon_theme_wrapper, button->backend->icon_name, button->frontend->iconw, TRUE);
-    if (new_icon_path)
-        button->frontend->icon = load_image(new_icon_path, TRUE);
-    free(new_icon_path);
-    // On loading error, fallback to default
-    if (!button->frontend->icon) {
-        new_icon_path = get_icon_path(icon_theme_wrapper, DEFAULT_ICON, button->frontend->iconw, TRUE);
-        if (new_icon_path)
-            button->frontend->icon = load_image(new_icon_path, TRUE);
-        free(new_icon_path);
-    }
-    Imlib_Image original = button->frontend->icon;
-    button->frontend->icon = scale_icon(button->frontend->icon, button->frontend->iconw);
-    free_icon(original);
+    button->frontend->icon = image ? image : scale_icon(NULL, button->frontend->iconw);
 
     if (panel_config.mouse_effects) {
         button->frontend->icon_hover = adjust_icon(button->frontend->icon,
@@ -241,6 +224,60 @@ void button_reload_icon(Button *button)
     schedule_redraw(&button->area);
 }
 
+static void button_icon_loaded(void *owner, Imlib_Image image, const char *path)
+{
+    button_set_icon((Button *)owner, image);
+}
+
+void button_reload_icon(Button *button)
+{
+    button->frontend->icon_load_size = button->frontend->iconw;
+
+    IconEffects effects = launcher_icon_effects();
+    if (button->backend->icon_name &&
+        icon_loader_request(button,
+                            icon_theme_wrapper,
+                            button->backend->icon_name,
+                            NULL,
+                            button->frontend->iconw,
+                            &effects,
+                            button_icon_loaded)) {
+        // Keep showing the current icon if it has the right size, otherwise a placeholder until the new one loads
+        if (button->frontend->icon) {
+            imlib_context_set_image(button->frontend->icon);
+            if (imlib_image_get_width() == button->frontend->iconw)
+                return;
+        }
+        free_icon(button->frontend->icon);
+        free_icon(button->frontend->icon_hover);
+        free_icon(button->frontend->icon_pressed);
+        button->frontend->icon = placeholder_icon(button->frontend->iconw);
+        button->frontend->icon_hover = NULL;
+        button->frontend->icon_pressed = NULL;
+        schedule_redraw(&button->area);
+        return;
+    }
+
+    icon_loader_cancel(button);
+    free_icon(button->frontend->icon);
+    free_icon(button->frontend->icon_hover);
+    free_icon(button->frontend->icon_pressed);
+    button->frontend->icon = NULL;
+    button->frontend->icon_hover = NULL;
+    button->frontend->icon_pressed = NULL;
+
+    if (!button->backend->icon_name)
+        return;
+
+    button_set_icon(button,
+                    icon_loader_load(icon_theme_wrapper,
+                                     button->backend->icon_name,
+                                     NULL,
+                                     button->frontend->iconw,
+                                     &effects,
+                                     NULL));
+}
+
 void button_default_icon_theme_changed()
 {
     for (int i = 0; i < num_panels; i++) {
@@ -252,13 +289,18 @@ void button_default_icon_theme_changed()
     schedule_panel_redraw();
 }
 
+void cleanup_button_panel(void *p)
+{
+    Panel *panel = (Panel *)p;
+    g_list_free_full(panel->button_list, destroy_button);
+    panel->button_list = NULL;
+}
+
 void cleanup_button()
 {
     // Cleanup frontends
-    for (int i = 0; i < num_panels; i++) {
-        g_list_free_full(panels[i].button_list, destroy_button);
-        panels[i].button_list = NULL;
-    }
+    for (int i = 0; i < num_panels; i++)
+        cleanup_button_panel(&panels[i]);
 
     // Cleanup backends
     g_list_free_full(panel_config.button_list, destroy_button);
@@ -89,6 +89,10 @@ void init_button();
 // At this point the Area has not been added yet to the GUI tree, but it will be added right away.
 void init_button_panel(void *panel);
 
+// Called before a panel is destroyed while the other panels are kept (e.g. when its monitor is unplugged).
+// Releases the frontends of the panel.
+void cleanup_button_panel(void *panel);
+
 // Called just before the panels are destroyed. Afterwards, tint2 exits or restarts and reads the config again.
 // Releases all frontends and then all the backends.
 // The frontend items are not freed by this function, only their members. The items are Areas which are freed in the
@@ -210,6 +210,21 @@ void init_clock_panel(void *p)
     }
 }
 
+void reinit_clock_panels()
+{
+    for (int i = 0; i < num_panels; i++) {
+        Panel *panel = &panels[i];
+        free_area(&panel->clock.area);
+        memcpy(&panel->clock, &panel_config.clock, sizeof(Clock));
+        if (strchr(panel_items_order, 'C'))
+            init_clock_panel(panel);
+        set_panel_items_order(panel);
+        set_panel_event_mask(panel);
+        panel->area.resize_needed = TRUE;
+    }
+    schedule_panel_redraw();
+}
+
 void clock_init_fonts()
 {
     if (!time1_font_desc) {
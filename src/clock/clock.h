@@ -48,6 +48,8 @@ void cleanup_clock();
 // initialize clock : y position, precision, ...
 void init_clock();
 void init_clock_panel(void *panel);
+// Replaces the clocks of all panels after the clock options have been read again
+void reinit_clock_panels();
 void clock_default_font_changed();
 
 void draw_clock(void *obj, cairo_t *c);
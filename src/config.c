@@ -35,6 +35,7 @@
 #include <Imlib2.h>
 
 #include "config.h"
+#include "config_keys.h"
 
 #ifndef TINT2CONF
 
@@ -78,12 +79,23 @@ static gboolean read_bg_color_press;
 static gboolean read_border_color_press;
 static gboolean read_panel_position;
 
+// An option as written in the config file
+typedef struct ConfigEntry {
+    ConfigKeyId id;
+    char *key;
+    char *value;
+} ConfigEntry;
+
+// The options of the running configuration, in file order, used to reload it incrementally
+static GPtrArray *config_entries;
+
 void default_config()
 {
     config_path = NULL;
     snapshot_path = NULL;
     new_config_file = FALSE;
     read_panel_position = FALSE;
+    config_entries = NULL;
 }
 
 void cleanup_config()
@@ -92,6 +104,9 @@ void cleanup_config()
     config_path = NULL;
     free(snapshot_path);
     snapshot_path = NULL;
+    if (config_entries)
+        g_ptr_array_free(config_entries, TRUE);
+    config_entries = NULL;
 }
 
 void get_action(char *event, MouseAction *action)
@@ -114,17 +129,23 @@ void get_action(char *event, MouseAction *action)
     #undef ACTION_BIND
 }
 
-int get_task_status(char *status)
+// Returns the task state configured by the options task[_state]_font_color, task[_state]_icon_asb and
+// task[_state]_background_id, or -1 if it is not supported.
+static int get_task_status_of_key(ConfigKeyId key_id)
 {
-    #define RETURNIF(name, value) if (strcmp(status, (name)) == 0) return value;
-
-    RETURNIF("active", TASK_ACTIVE);
-    RETURNIF("iconified", TASK_ICONIFIED);
-    RETURNIF("urgent", TASK_URGENT);
-
-    #undef RETURNIF
-
-    return -1;
+    switch (config_key_state(key_id)) {
+    case CONFIG_STATE_NONE:
+        return TASK_NORMAL;
+    case CONFIG_STATE_ACTIVE:
+        return TASK_ACTIVE;
+    case CONFIG_STATE_ICONIFIED:
+        return TASK_ICONIFIED;
+    case CONFIG_STATE_URGENT:
+        return TASK_URGENT;
+    default:
+        // task_normal_*: the normal state is configured by the options without a state
+        return -1;
+    }
 }
 
 int config_get_monitor(char *monitor)
@@ -167,7 +188,8 @@ static gint compare_strings(gconstpointer a, gconstpointer b)
     return strnatcasecmp((const char *)a, (const char *)b);
 }
 
-void load_launcher_app_dir(const char *path)
+// Prepends the desktop files found in path and its subdirectories to apps, in reverse order
+static void collect_launcher_app_dir(const char *path, GSList **apps)
 {
     GList *subdirs = NULL;
     GList *files = NULL;
@@ -177,10 +199,11 @@ void load_launcher_app_dir(const char *path)
         const gchar *name;
         while ((name = g_dir_read_name(d))) {
             gchar *file = g_build_filename(path, name, NULL);
-            if (!g_file_test(file, G_FILE_TEST_IS_DIR) && g_str_has_suffix(file, ".desktop")) {
-                files = g_list_append(files, file);
-            } else if (g_file_test(file, G_FILE_TEST_IS_DIR)) {
-                subdirs = g_list_append(subdirs, file);
+            gboolean is_dir = g_file_test(file, G_FILE_TEST_IS_DIR);
+            if (!is_dir && g_str_has_suffix(file, ".desktop")) {
+                files = g_list_prepend(files, file);
+            } else if (is_dir) {
+                subdirs = g_list_prepend(subdirs, file);
             } else {
                 g_free(file);
             }
@@ -192,7 +215,7 @@ void load_launcher_app_dir(const char *path)
     GList *l;
     for (l = subdirs; l; l = g_list_next(l)) {
         gchar *dir = (gchar *)l->data;
-        load_launcher_app_dir(dir);
+        collect_launcher_app_dir(dir, apps);
         g_free(dir);
     }
     g_list_free(subdirs);
@@ -200,12 +223,19 @@ void load_launcher_app_dir(const char *path)
     files = g_list_sort(files, compare_strings);
     for (l = files; l; l = g_list_next(l)) {
         gchar *file = (gchar *)l->data;
-        panel_config.launcher.list_apps = g_slist_append(panel_config.launcher.list_apps, strdup(file));
+        *apps = g_slist_prepend(*apps, strdup(file));
         g_free(file);
     }
     g_list_free(files);
 }
 
+void load_launcher_app_dir(const char *path)
+{
+    GSList *apps = NULL;
+    collect_launcher_app_dir(path, &apps);
+    panel_config.launcher.list_apps = g_slist_concat(panel_config.launcher.list_apps, g_slist_reverse(apps));
+}
+
 Separator *get_or_create_last_separator()
 {
     if (!panel_config.separator_list) {
@@ -233,63 +263,80 @@ Button *get_or_create_last_button()
     return (Button *)g_list_last(panel_config.button_list)->data;
 }
 
+// The hover and pressed colors of a background default to the normal ones
+static void finalize_bg()
+{
+    if (backgrounds->len == 0)
+        return;
+    Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
+    if (!read_bg_color_hover)
+        memcpy(&bg->fill_color_hover, &bg->fill_color, sizeof(Color));
+    if (!read_border_color_hover)
+        memcpy(&bg->border_color_hover, &bg->border, sizeof(Color));
+    if (!read_bg_color_press)
+        memcpy(&bg->fill_color_pressed, &bg->fill_color_hover, sizeof(Color));
+    if (!read_border_color_press)
+        memcpy(&bg->border_color_pressed, &bg->border_color_hover, sizeof(Color));
+}
+
+// Parses a font color option of the form "#rrggbb alpha", the alpha defaulting to 50%
+static void read_font_color(const char *value, Color *color)
+{
+    char *value1 = NULL, *value2 = NULL, *value3 = NULL;
+    extract_values(value, &value1, &value2, &value3);
+    get_color(value1, color->rgb);
+    color->alpha = value2 ? atoi(value2) / 100.0 : 0.5;
+    free(value1);
+    free(value2);
+    free(value3);
+}
+
 void add_entry(char *key, char *value)
 {
     char *value1 = 0, *value2 = 0, *value3 = 0;
 
-    #define KEY_IS(name) strcmp(key, (name)) == 0
-
     #define SET_BG_IDX(VALUE, VARNAME) {\
         int id = atoi((VALUE)); \
         id = (id < backgrounds->len && id >= 0) ? id : 0; \
         (VARNAME) = &g_array_index(backgrounds, Background, id);\
     }
 
-    #define SIMPLE_INT(KEY, VARIABLE) \
-        else if (KEY_IS((KEY))) { (VARIABLE) = atoi(value); }
-
     #define SET_STR(VARIABLE) \
         if (strlen(value) > 0) (VARIABLE) = strdup(value)
 
-    #define SIMPLE_STR(KEY, VARIABLE) \
-        else if (KEY_IS((KEY))) { SET_STR(VARIABLE); }
-
-    #define FREE_STR(KEY, VARIABLE) \
-        else if (KEY_IS((KEY))) { \
-            free_and_null(VARIABLE); \
-            SET_STR(VARIABLE); \
-        }
+    #define SET_BG(color_var) \
+        Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1); \
+        extract_values(value, &value1, &value2, &value3); \
+        get_color(value1, (color_var).rgb); \
+        if (value2) \
+            (color_var).alpha = (atoi(value2) / 100.0); \
+        else \
+            (color_var).alpha = 0.5;
 
-    #define FREE_STR_SET_FLAG(KEY, VARIABLE, FLAG) \
-        else if (KEY_IS((KEY))) { \
-            free_and_null(VARIABLE); \
-            if (strlen(value) > 0) { \
-                VARIABLE = strdup(value); \
-                FLAG = TRUE; \
-            } \
-        }
+    #define SET_BG_GRADIENT(type) \
+        Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1); \
+        int id = atoi(value); \
+        id = (id < gradients->len && id >= 0) ? id : -1; \
+        if (id >= 0) \
+            bg->gradients[(type)] = &g_array_index(gradients, GradientClass, id);
 
+    ConfigKeyId key_id = config_key_lookup(key);
+    if (key_id != CONFIG_KEY_UNKNOWN && !config_value_is_valid(key_id, value))
+        fprintf(stderr, YELLOW "tint2: invalid value for option \"%s\": \"%s\"" RESET "\n", key, value);
 
-    /* Background and border */
-    if (KEY_IS("scale_relative_to_dpi")) {
+    switch (key_id) {
+    /* Scaling */
+    case CONFIG_KEY_SCALE_RELATIVE_TO_DPI:
         ui_scale_dpi_ref = atof(value);
-
-    } else if (KEY_IS("scale_relative_to_screen_height")) {
+        break;
+    case CONFIG_KEY_SCALE_RELATIVE_TO_SCREEN_HEIGHT:
         ui_scale_monitor_size_ref = atof(value);
+        break;
 
-    } else if (KEY_IS("rounded")) {
+    /* Background and border */
+    case CONFIG_KEY_ROUNDED: {
         // 'rounded' is the first parameter => alloc a new background
-        if (backgrounds->len > 0) {
-            Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
-            if (!read_bg_color_hover)
-                memcpy(&bg->fill_color_hover, &bg->fill_color, sizeof(Color));
-            if (!read_border_color_hover)
-                memcpy(&bg->border_color_hover, &bg->border, sizeof(Color));
-            if (!read_bg_color_press)
-                memcpy(&bg->fill_color_pressed, &bg->fill_color_hover, sizeof(Color));
-            if (!read_border_color_press)
-                memcpy(&bg->border_color_pressed, &bg->border_color_hover, sizeof(Color));
-        }
+        finalize_bg();
         Background bg;
         init_background(&bg);
         bg.border.radius = atoi(value);
@@ -298,11 +345,12 @@ void add_entry(char *key, char *value)
         read_border_color_hover = FALSE;
         read_bg_color_press = FALSE;
         read_border_color_press = FALSE;
-
-    } else if (KEY_IS("border_width")) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_WIDTH:
         g_array_index(backgrounds, Background, backgrounds->len - 1).border.width = atoi(value);
-
-    } else if (KEY_IS("border_sides")) {
+        break;
+    case CONFIG_KEY_BORDER_SIDES: {
         Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
         bg->border.mask = 0;
 
@@ -318,72 +366,68 @@ void add_entry(char *key, char *value)
 
         if (!bg->border.mask)
             bg->border.width = 0;
-
-    #define SET_BG(color_var) \
-        Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1); \
-        extract_values(value, &value1, &value2, &value3); \
-        get_color(value1, (color_var).rgb); \
-        if (value2) \
-            (color_var).alpha = (atoi(value2) / 100.0); \
-        else \
-            (color_var).alpha = 0.5;
-
-    } else if (KEY_IS("background_color")) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_COLOR: {
         SET_BG(bg->fill_color);
-
-    } else if (KEY_IS("border_color")) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR: {
         SET_BG(bg->border.color);
-
-    } else if (KEY_IS("background_color_hover")) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_COLOR_HOVER: {
         SET_BG(bg->fill_color_hover);
         read_bg_color_hover = 1;
-
-    } else if (KEY_IS("border_color_hover")) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR_HOVER: {
         SET_BG(bg->border_color_hover);
         read_border_color_hover = 1;
-
-    } else if (KEY_IS("background_color_pressed")) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_COLOR_PRESSED: {
         SET_BG(bg->fill_color_pressed);
         read_bg_color_press = 1;
-
-    } else if (KEY_IS("border_color_pressed")) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR_PRESSED: {
         SET_BG(bg->border_color_pressed);
         read_border_color_press = 1;
-    #undef SET_BG
-
-    #define SET_BG_GRADIENT(type) \
-        Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1); \
-        int id = atoi(value); \
-        id = (id < gradients->len && id >= 0) ? id : -1; \
-        if (id >= 0) \
-            bg->gradients[(type)] = &g_array_index(gradients, GradientClass, id);
-
-    } else if (KEY_IS("gradient_id")) {
+        break;
+    }
+    case CONFIG_KEY_GRADIENT_ID: {
         SET_BG_GRADIENT(MOUSE_NORMAL);
-
-    } else if (KEY_IS("gradient_id_hover") || KEY_IS("hover_gradient_id")) {
+        break;
+    }
+    case CONFIG_KEY_GRADIENT_ID_HOVER: {
         SET_BG_GRADIENT(MOUSE_OVER);
-
-    } else if (KEY_IS("gradient_id_pressed") || KEY_IS("pressed_gradient_id")) {
+        break;
+    }
+    case CONFIG_KEY_GRADIENT_ID_PRESSED: {
         SET_BG_GRADIENT(MOUSE_DOWN);
-    #undef SET_BG_GRADIENT
-
-    } else if (KEY_IS("border_content_tint_weight")) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_CONTENT_TINT_WEIGHT: {
         Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
         bg->border_content_tint_weight = MAX(0.0, MIN(1.0, atoi(value) / 100.));
-
-    } else if (KEY_IS("background_content_tint_weight")) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_CONTENT_TINT_WEIGHT: {
         Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
         bg->fill_content_tint_weight = MAX(0.0, MIN(1.0, atoi(value) / 100.));
+        break;
     }
 
     /* Gradients */
-    else if (KEY_IS("gradient")) {
+    case CONFIG_KEY_GRADIENT: {
         // Create a new gradient
         GradientClass g;
         init_gradient(&g, gradient_type_from_string(value));
         g_array_append_val(gradients, g);
-    } else if (KEY_IS("start_color")) {
+        break;
+    }
+    case CONFIG_KEY_START_COLOR: {
         GradientClass *g = &g_array_index(gradients, GradientClass, gradients->len - 1);
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, g->start_color.rgb);
@@ -391,7 +435,9 @@ void add_entry(char *key, char *value)
             g->start_color.alpha = (atoi(value2) / 100.0);
         else
             g->start_color.alpha = 0.5;
-    } else if (KEY_IS("end_color")) {
+        break;
+    }
+    case CONFIG_KEY_END_COLOR: {
         GradientClass *g = &g_array_index(gradients, GradientClass, gradients->len - 1);
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, g->end_color.rgb);
@@ -399,7 +445,9 @@ void add_entry(char *key, char *value)
             g->end_color.alpha = (atoi(value2) / 100.0);
         else
             g->end_color.alpha = 0.5;
-    } else if (KEY_IS("color_stop")) {
+        break;
+    }
+    case CONFIG_KEY_COLOR_STOP: {
         GradientClass *g = &g_array_index(gradients, GradientClass, gradients->len - 1);
         extract_values(value, &value1, &value2, &value3);
         ColorStop *color_stop = (ColorStop *)calloc(1, sizeof(ColorStop));
@@ -410,28 +458,50 @@ void add_entry(char *key, char *value)
         else
             color_stop->color.alpha = 0.5;
         g->extra_color_stops = g_list_append(g->extra_color_stops, color_stop);
+        break;
     }
 
     /* Panel */
-    SIMPLE_INT("panel_shrink", panel_shrink)
-    SIMPLE_INT("font_shadow", panel_config.font_shadow)
-    SIMPLE_INT("wm_menu", wm_menu)
-    SIMPLE_INT("panel_dock", panel_dock)
-    SIMPLE_INT("panel_pivot_struts", panel_pivot_struts)
-    SIMPLE_INT("urgent_nb_of_blink", max_tick_urgent)
-    SIMPLE_INT("urgent_nb_of_blink", max_tick_urgent)
-    SIMPLE_INT("urgent_nb_of_blink", max_tick_urgent)
-    SIMPLE_INT("disable_transparency", server.disable_transparency)
-
-    SIMPLE_STR("panel_lclick_command", panel_config.lclick_command)
-    SIMPLE_STR("panel_mclick_command", panel_config.mclick_command)
-    SIMPLE_STR("panel_rclick_command", panel_config.rclick_command)
-    SIMPLE_STR("panel_uwheel_command", panel_config.uwheel_command)
-    SIMPLE_STR("panel_dwheel_command", panel_config.dwheel_command)
-
-    else if (KEY_IS("panel_monitor")) {
+    case CONFIG_KEY_PANEL_SHRINK:
+        panel_shrink = atoi(value);
+        break;
+    case CONFIG_KEY_FONT_SHADOW:
+        panel_config.font_shadow = atoi(value);
+        break;
+    case CONFIG_KEY_WM_MENU:
+        wm_menu = atoi(value);
+        break;
+    case CONFIG_KEY_PANEL_DOCK:
+        panel_dock = atoi(value);
+        break;
+    case CONFIG_KEY_PANEL_PIVOT_STRUTS:
+        panel_pivot_struts = atoi(value);
+        break;
+    case CONFIG_KEY_URGENT_NB_OF_BLINK:
+        max_tick_urgent = atoi(value);
+        break;
+    case CONFIG_KEY_DISABLE_TRANSPARENCY:
+        server.disable_transparency = atoi(value);
+        break;
+    case CONFIG_KEY_PANEL_LCLICK_COMMAND:
+        SET_STR(panel_config.lclick_command);
+        break;
+    case CONFIG_KEY_PANEL_MCLICK_COMMAND:
+        SET_STR(panel_config.mclick_command);
+        break;
+    case CONFIG_KEY_PANEL_RCLICK_COMMAND:
+        SET_STR(panel_config.rclick_command);
+        break;
+    case CONFIG_KEY_PANEL_UWHEEL_COMMAND:
+        SET_STR(panel_config.uwheel_command);
+        break;
+    case CONFIG_KEY_PANEL_DWHEEL_COMMAND:
+        SET_STR(panel_config.dwheel_command);
+        break;
+    case CONFIG_KEY_PANEL_MONITOR:
         panel_config.monitor = config_get_monitor(value);
-    } else if (KEY_IS("panel_size")) {
+        break;
+    case CONFIG_KEY_PANEL_SIZE: {
         extract_values(value, &value1, &value2, &value3);
 
         char *b;
@@ -452,7 +522,9 @@ void add_entry(char *key, char *value)
             }
             panel_config.area.height = atoi(value2);
         }
-    } else if (KEY_IS("panel_items")) {
+        break;
+    }
+    case CONFIG_KEY_PANEL_ITEMS:
         new_config_file = TRUE;
         free_and_null(panel_items_order);
         panel_items_order = strdup(value);
@@ -483,22 +555,22 @@ void add_entry(char *key, char *value)
             if (panel_items_order[j] == 'C')
                 clock_enabled = 1;
         }
-
-    } else if (KEY_IS("panel_margin")) {
+        break;
+    case CONFIG_KEY_PANEL_MARGIN:
         extract_values(value, &value1, &value2, &value3);
         panel_config.marginx = atoi(value1);
         if (value2)
             panel_config.marginy = atoi(value2);
-
-    } else if (KEY_IS("panel_padding")) {
+        break;
+    case CONFIG_KEY_PANEL_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.area.paddingxlr = panel_config.area.paddingx = atoi(value1);
         if (value2)
             panel_config.area.paddingy = atoi(value2);
         if (value3)
             panel_config.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("panel_position")) {
+        break;
+    case CONFIG_KEY_PANEL_POSITION:
         read_panel_position = TRUE;
         extract_values(value, &value1, &value2, &value3);
         if (strcmp(value1, "top") == 0)
@@ -530,123 +602,121 @@ void add_entry(char *key, char *value)
             else
                 panel_horizontal = 1;
         }
-    }
-
-    else if (KEY_IS("panel_background_id"))
+        break;
+    case CONFIG_KEY_PANEL_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.area.bg)
-
-    else if (KEY_IS("panel_layer")) {
+        break;
+    case CONFIG_KEY_PANEL_LAYER:
         if (strcmp(value, "bottom") == 0)
             panel_layer = BOTTOM_LAYER;
         else if (strcmp(value, "top") == 0)
             panel_layer = TOP_LAYER;
         else
             panel_layer = NORMAL_LAYER;
-
-    } else if (KEY_IS("panel_window_name")) {
+        break;
+    case CONFIG_KEY_PANEL_WINDOW_NAME:
         if (strlen(value) > 0) {
             free(panel_window_name);
             panel_window_name = strdup(value);
         }
-    }
+        break;
 
     /* Battery */
-
-    #ifdef ENABLE_BATTERY
-    #define BATTERY_CONFIG(key, code) \
-        else if (KEY_IS(key)) { code }
-    #else
-        else if (KEY_IS(key)) { }
-    #endif
-
-    BATTERY_CONFIG("battery_low_status", {
+#ifdef ENABLE_BATTERY
+    case CONFIG_KEY_BATTERY_LOW_STATUS:
         battery_low_status = atoi(value);
         if (battery_low_status < 0 || battery_low_status > 100)
             battery_low_status = 0;
-    })
-
-    BATTERY_CONFIG("battery_lclick_command", SET_STR(battery_lclick_command);)
-    BATTERY_CONFIG("battery_mclick_command", SET_STR(battery_mclick_command);)
-    BATTERY_CONFIG("battery_rclick_command", SET_STR(battery_rclick_command);)
-    BATTERY_CONFIG("battery_uwheel_command", SET_STR(battery_uwheel_command);)
-    BATTERY_CONFIG("battery_dwheel_command", SET_STR(battery_dwheel_command);)
-    BATTERY_CONFIG("battery_low_command", SET_STR(battery_low_cmd);)
-    BATTERY_CONFIG("battery_full_command", SET_STR(battery_full_cmd);)
-    BATTERY_CONFIG("battery_full_command", SET_STR(battery_full_cmd);)
-    BATTERY_CONFIG("ac_connected_cmd", SET_STR(ac_connected_cmd);)
-    BATTERY_CONFIG("ac_disconnected_cmd", SET_STR(ac_disconnected_cmd);)
-
-
-    BATTERY_CONFIG("bat1_font", {
+        break;
+    case CONFIG_KEY_BATTERY_LCLICK_COMMAND:
+        SET_STR(battery_lclick_command);
+        break;
+    case CONFIG_KEY_BATTERY_MCLICK_COMMAND:
+        SET_STR(battery_mclick_command);
+        break;
+    case CONFIG_KEY_BATTERY_RCLICK_COMMAND:
+        SET_STR(battery_rclick_command);
+        break;
+    case CONFIG_KEY_BATTERY_UWHEEL_COMMAND:
+        SET_STR(battery_uwheel_command);
+        break;
+    case CONFIG_KEY_BATTERY_DWHEEL_COMMAND:
+        SET_STR(battery_dwheel_command);
+        break;
+    case CONFIG_KEY_BATTERY_LOW_CMD:
+        SET_STR(battery_low_cmd);
+        break;
+    case CONFIG_KEY_BATTERY_FULL_CMD:
+        SET_STR(battery_full_cmd);
+        break;
+    case CONFIG_KEY_AC_CONNECTED_CMD:
+        SET_STR(ac_connected_cmd);
+        break;
+    case CONFIG_KEY_AC_DISCONNECTED_CMD:
+        SET_STR(ac_disconnected_cmd);
+        break;
+    case CONFIG_KEY_BAT1_FONT:
         bat1_font_desc = pango_font_description_from_string(value);
         bat1_has_font = TRUE;
-    })
-
-    BATTERY_CONFIG("bat2_font", {
+        break;
+    case CONFIG_KEY_BAT2_FONT:
         bat2_font_desc = pango_font_description_from_string(value);
         bat2_has_font = TRUE;
-    })
-
-    BATTERY_CONFIG("bat1_format", {
+        break;
+    case CONFIG_KEY_BAT1_FORMAT:
         if (strlen(value) > 0) {
             free(bat1_format);
             bat1_format = strdup(value);
             battery_enabled = 1;
         }
-    })
-
-    BATTERY_CONFIG("bat2_format", {
+        break;
+    case CONFIG_KEY_BAT2_FORMAT:
         if (strlen(value) > 0) {
             free(bat2_format);
             bat2_format = strdup(value);
             battery_enabled = 1;
         }
-    })
-
-    BATTERY_CONFIG("battery_font_color", {
+        break;
+    case CONFIG_KEY_BATTERY_FONT_COLOR:
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, panel_config.battery.font_color.rgb);
         if (value2)
             panel_config.battery.font_color.alpha = (atoi(value2) / 100.0);
         else
             panel_config.battery.font_color.alpha = 0.5;
-    })
-
-    BATTERY_CONFIG("battery_padding", {
+        break;
+    case CONFIG_KEY_BATTERY_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.battery.area.paddingxlr = panel_config.battery.area.paddingx = atoi(value1);
         if (value2)
             panel_config.battery.area.paddingy = atoi(value2);
         if (value3)
             panel_config.battery.area.paddingx = atoi(value3);
-    })
-
-    BATTERY_CONFIG("battery_background_id", {
+        break;
+    case CONFIG_KEY_BATTERY_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.battery.area.bg)
-    })
-
-    BATTERY_CONFIG("battery_hide", {
+        break;
+    case CONFIG_KEY_BATTERY_HIDE:
         percentage_hide = atoi(value);
         if (percentage_hide == 0)
             percentage_hide = 101;
-    })
-
-    BATTERY_CONFIG("battery_tooltip", {
+        break;
+    case CONFIG_KEY_BATTERY_TOOLTIP:
         battery_tooltip_enabled = atoi(value);
-    })
-
-    #undef BATTERY_CONFIG
+        break;
+#endif
 
     /* Separator */
-    SIMPLE_INT("separator_size", get_or_create_last_separator()->thickness)
-
-    else if (KEY_IS("separator")) {
+    case CONFIG_KEY_SEPARATOR_SIZE:
+        get_or_create_last_separator()->thickness = atoi(value);
+        break;
+    case CONFIG_KEY_SEPARATOR:
         panel_config.separator_list = g_list_append(panel_config.separator_list, create_separator());
-
-    } else if (KEY_IS("separator_background_id")) {
+        break;
+    case CONFIG_KEY_SEPARATOR_BACKGROUND_ID:
         SET_BG_IDX(value, get_or_create_last_separator()->area.bg);
-
-    } else if (KEY_IS("separator_color")) {
+        break;
+    case CONFIG_KEY_SEPARATOR_COLOR: {
         Separator *separator = get_or_create_last_separator();
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, separator->color.rgb);
@@ -654,8 +724,9 @@ void add_entry(char *key, char *value)
             separator->color.alpha = (atoi(value2) / 100.0);
         else
             separator->color.alpha = 0.5;
-
-    } else if (KEY_IS("separator_style")) {
+        break;
+    }
+    case CONFIG_KEY_SEPARATOR_STYLE: {
         Separator *separator = get_or_create_last_separator();
         if (g_str_equal(value, "empty"))
             separator->style = SEPARATOR_EMPTY;
@@ -665,8 +736,9 @@ void add_entry(char *key, char *value)
             separator->style = SEPARATOR_DOTS;
         else
             fprintf(stderr, RED "tint2: Invalid separator_style value: %s" RESET "\n", value);
-
-    } else if (KEY_IS("separator_padding")) {
+        break;
+    }
+    case CONFIG_KEY_SEPARATOR_PADDING: {
         Separator *separator = get_or_create_last_separator();
         extract_values(value, &value1, &value2, &value3);
         separator->area.paddingxlr = separator->area.paddingx = atoi(value1);
@@ -674,30 +746,66 @@ void add_entry(char *key, char *value)
             separator->area.paddingy = atoi(value2);
         if (value3)
             separator->area.paddingx = atoi(value3);
+        break;
     }
 
     /* Execp */
-    SIMPLE_INT("execp_isolate", get_or_create_last_execp()->backend->isolate)
-    SIMPLE_INT("execp_has_icon", get_or_create_last_execp()->backend->has_icon)
-    SIMPLE_INT("execp_continuous", get_or_create_last_execp()->backend->continuous)
-    SIMPLE_INT("execp_markup", get_or_create_last_execp()->backend->has_markup)
-    SIMPLE_INT("execp_cache_icon", get_or_create_last_execp()->backend->cache_icon)
-    SIMPLE_INT("execp_centered", get_or_create_last_execp()->backend->centered)
-
-    FREE_STR("execp_command", get_or_create_last_execp()->backend->command)
-    FREE_STR("execp_lclick_command", get_or_create_last_execp()->backend->lclick_command)
-    FREE_STR("execp_mclick_command", get_or_create_last_execp()->backend->mclick_command)
-    FREE_STR("execp_rclick_command", get_or_create_last_execp()->backend->rclick_command)
-    FREE_STR("execp_uwheel_command", get_or_create_last_execp()->backend->uwheel_command)
-    FREE_STR("execp_dwheel_command", get_or_create_last_execp()->backend->dwheel_command)
-    FREE_STR_SET_FLAG("execp_tooltip",
-        get_or_create_last_execp()->backend->tooltip,
-        get_or_create_last_execp()->backend->has_user_tooltip)
-
-    else if (KEY_IS("execp")) {
+    case CONFIG_KEY_EXECP_ISOLATE:
+        get_or_create_last_execp()->backend->isolate = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_HAS_ICON:
+        get_or_create_last_execp()->backend->has_icon = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_CONTINUOUS:
+        get_or_create_last_execp()->backend->continuous = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_MAX_BUFFER_SIZE:
+        get_or_create_last_execp()->backend->max_buffer_size = MAX(EXECP_MIN_MAX_BUFFER_SIZE, atoi(value));
+        break;
+    case CONFIG_KEY_EXECP_MARKUP:
+        get_or_create_last_execp()->backend->has_markup = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_CACHE_ICON:
+        get_or_create_last_execp()->backend->cache_icon = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_CENTERED:
+        get_or_create_last_execp()->backend->centered = atoi(value);
+        break;
+    case CONFIG_KEY_EXECP_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->command);
+        SET_STR(get_or_create_last_execp()->backend->command);
+        break;
+    case CONFIG_KEY_EXECP_LCLICK_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->lclick_command);
+        SET_STR(get_or_create_last_execp()->backend->lclick_command);
+        break;
+    case CONFIG_KEY_EXECP_MCLICK_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->mclick_command);
+        SET_STR(get_or_create_last_execp()->backend->mclick_command);
+        break;
+    case CONFIG_KEY_EXECP_RCLICK_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->rclick_command);
+        SET_STR(get_or_create_last_execp()->backend->rclick_command);
+        break;
+    case CONFIG_KEY_EXECP_UWHEEL_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->uwheel_command);
+        SET_STR(get_or_create_last_execp()->backend->uwheel_command);
+        break;
+    case CONFIG_KEY_EXECP_DWHEEL_COMMAND:
+        free_and_null(get_or_create_last_execp()->backend->dwheel_command);
+        SET_STR(get_or_create_last_execp()->backend->dwheel_command);
+        break;
+    case CONFIG_KEY_EXECP_TOOLTIP:
+        free_and_null(get_or_create_last_execp()->backend->tooltip);
+        if (strlen(value) > 0) {
+            get_or_create_last_execp()->backend->tooltip = strdup(value);
+            get_or_create_last_execp()->backend->has_user_tooltip = TRUE;
+        }
+        break;
+    case CONFIG_KEY_EXECP:
         panel_config.execp_list = g_list_append(panel_config.execp_list, create_execp());
-
-    } else if (KEY_IS("execp_name")) {
+        break;
+    case CONFIG_KEY_EXECP_NAME: {
         Execp *execp = get_or_create_last_execp();
         execp->backend->name[0] = 0;
         if (strlen(value) > sizeof(execp->backend->name) - 1)
@@ -705,8 +813,9 @@ void add_entry(char *key, char *value)
                     sizeof(execp->backend->name) - 1, value);
         else if (strlen(value) > 0)
             snprintf(execp->backend->name, sizeof(execp->backend->name), value);
-
-    } else if (KEY_IS("execp_interval")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_INTERVAL: {
         Execp *execp = get_or_create_last_execp();
         execp->backend->interval = 0;
         int v = atoi(value);
@@ -715,27 +824,24 @@ void add_entry(char *key, char *value)
         } else {
             execp->backend->interval = v;
         }
-
-    } else if (KEY_IS("execp_monitor")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_MONITOR: {
         Execp *execp = get_or_create_last_execp();
         execp->backend->monitor = config_get_monitor(value);
-
-    } else if (KEY_IS("execp_font")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_FONT: {
         Execp *execp = get_or_create_last_execp();
         pango_font_description_free(execp->backend->font_desc);
         execp->backend->font_desc = pango_font_description_from_string(value);
         execp->backend->has_font = TRUE;
-
-    } else if (KEY_IS("execp_font_color")) {
-        Execp *execp = get_or_create_last_execp();
-        extract_values(value, &value1, &value2, &value3);
-        get_color(value1, execp->backend->font_color.rgb);
-        if (value2)
-            execp->backend->font_color.alpha = atoi(value2) / 100.0;
-        else
-            execp->backend->font_color.alpha = 0.5;
-
-    } else if (KEY_IS("execp_padding")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_FONT_COLOR:
+        read_font_color(value, &get_or_create_last_execp()->backend->font_color);
+        break;
+    case CONFIG_KEY_EXECP_PADDING: {
         Execp *execp = get_or_create_last_execp();
         extract_values(value, &value1, &value2, &value3);
         execp->backend->paddingxlr = execp->backend->paddingx = atoi(value1);
@@ -745,11 +851,12 @@ void add_entry(char *key, char *value)
             execp->backend->paddingy = 0;
         if (value3)
             execp->backend->paddingx = atoi(value3);
-
-    } else if (KEY_IS("execp_background_id")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_BACKGROUND_ID:
         SET_BG_IDX(value, get_or_create_last_execp()->backend->bg);
-
-    } else if (KEY_IS("execp_icon_w")) {
+        break;
+    case CONFIG_KEY_EXECP_ICON_W: {
         Execp *execp = get_or_create_last_execp();
         int v = atoi(value);
         if (v < 0) {
@@ -757,8 +864,9 @@ void add_entry(char *key, char *value)
         } else {
             execp->backend->icon_w = v;
         }
-
-    } else if (KEY_IS("execp_icon_h")) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_ICON_H: {
         Execp *execp = get_or_create_last_execp();
         int v = atoi(value);
         if (v < 0) {
@@ -766,42 +874,58 @@ void add_entry(char *key, char *value)
         } else {
             execp->backend->icon_h = v;
         }
+        break;
     }
 
     /* Button */
-    FREE_STR("button_text", get_or_create_last_button()->backend->text)
-    FREE_STR("button_tooltip", get_or_create_last_button()->backend->tooltip)
-    FREE_STR("button_lclick_command", get_or_create_last_button()->backend->lclick_command)
-    FREE_STR("button_mclick_command", get_or_create_last_button()->backend->mclick_command)
-    FREE_STR("button_rclick_command", get_or_create_last_button()->backend->rclick_command)
-    FREE_STR("button_uwheel_command", get_or_create_last_button()->backend->uwheel_command)
-    FREE_STR("button_dwheel_command", get_or_create_last_button()->backend->dwheel_command)
-
-    else if (KEY_IS("button")) {
+    case CONFIG_KEY_BUTTON_TEXT:
+        free_and_null(get_or_create_last_button()->backend->text);
+        SET_STR(get_or_create_last_button()->backend->text);
+        break;
+    case CONFIG_KEY_BUTTON_TOOLTIP:
+        free_and_null(get_or_create_last_button()->backend->tooltip);
+        SET_STR(get_or_create_last_button()->backend->tooltip);
+        break;
+    case CONFIG_KEY_BUTTON_LCLICK_COMMAND:
+        free_and_null(get_or_create_last_button()->backend->lclick_command);
+        SET_STR(get_or_create_last_button()->backend->lclick_command);
+        break;
+    case CONFIG_KEY_BUTTON_MCLICK_COMMAND:
+        free_and_null(get_or_create_last_button()->backend->mclick_command);
+        SET_STR(get_or_create_last_button()->backend->mclick_command);
+        break;
+    case CONFIG_KEY_BUTTON_RCLICK_COMMAND:
+        free_and_null(get_or_create_last_button()->backend->rclick_command);
+        SET_STR(get_or_create_last_button()->backend->rclick_command);
+        break;
+    case CONFIG_KEY_BUTTON_UWHEEL_COMMAND:
+        free_and_null(get_or_create_last_button()->backend->uwheel_command);
+        SET_STR(get_or_create_last_button()->backend->uwheel_command);
+        break;
+    case CONFIG_KEY_BUTTON_DWHEEL_COMMAND:
+        free_and_null(get_or_create_last_button()->backend->dwheel_command);
+        SET_STR(get_or_create_last_button()->backend->dwheel_command);
+        break;
+    case CONFIG_KEY_BUTTON:
         panel_config.button_list = g_list_append(panel_config.button_list, create_button());
-
-    } else if (KEY_IS("button_icon")) {
+        break;
+    case CONFIG_KEY_BUTTON_ICON:
         if (strlen(value)) {
             Button *button = get_or_create_last_button();
             button->backend->icon_name = expand_tilde(value);
         }
-
-    } else if (KEY_IS("button_font")) {
+        break;
+    case CONFIG_KEY_BUTTON_FONT: {
         Button *button = get_or_create_last_button();
         pango_font_description_free(button->backend->font_desc);
         button->backend->font_desc = pango_font_description_from_string(value);
         button->backend->has_font = TRUE;
-
-    } else if (KEY_IS("button_font_color")) {
-        Button *button = get_or_create_last_button();
-        extract_values(value, &value1, &value2, &value3);
-        get_color(value1, button->backend->font_color.rgb);
-        if (value2)
-            button->backend->font_color.alpha = atoi(value2) / 100.0;
-        else
-            button->backend->font_color.alpha = 0.5;
-
-    } else if (KEY_IS("button_padding")) {
+        break;
+    }
+    case CONFIG_KEY_BUTTON_FONT_COLOR:
+        read_font_color(value, &get_or_create_last_button()->backend->font_color);
+        break;
+    case CONFIG_KEY_BUTTON_PADDING: {
         Button *button = get_or_create_last_button();
         extract_values(value, &value1, &value2, &value3);
         button->backend->paddingxlr = button->backend->paddingx = atoi(value1);
@@ -811,32 +935,55 @@ void add_entry(char *key, char *value)
             button->backend->paddingy = 0;
         if (value3)
             button->backend->paddingx = atoi(value3);
-
-    } else if (KEY_IS("button_max_icon_size")) {
+        break;
+    }
+    case CONFIG_KEY_BUTTON_MAX_ICON_SIZE: {
         Button *button = get_or_create_last_button();
         extract_values(value, &value1, &value2, &value3);
         button->backend->max_icon_size = MAX(0, atoi(value));
-    } else if (KEY_IS("button_background_id")) {
+        break;
+    }
+    case CONFIG_KEY_BUTTON_BACKGROUND_ID:
         SET_BG_IDX(value, get_or_create_last_button()->backend->bg);
-
-    } else if (KEY_IS("button_centered")) {
+        break;
+    case CONFIG_KEY_BUTTON_CENTERED: {
         Button *button = get_or_create_last_button();
         button->backend->centered = atoi(value);
+        break;
     }
 
     /* Clock */
-    SIMPLE_STR("time2_format", time2_format)
-    SIMPLE_STR("time1_timezone", time1_timezone)
-    SIMPLE_STR("time2_timezone", time2_timezone)
-    SIMPLE_STR("clock_tooltip", time_tooltip_format)
-    SIMPLE_STR("clock_tooltip_timezone", time_tooltip_timezone)
-    SIMPLE_STR("clock_lclick_command", clock_lclick_command)
-    SIMPLE_STR("clock_rclick_command", clock_rclick_command)
-    SIMPLE_STR("clock_mclick_command", clock_mclick_command)
-    SIMPLE_STR("clock_uwheel_command", clock_uwheel_command)
-    SIMPLE_STR("clock_dwheel_command", clock_dwheel_command)
-
-    else if (KEY_IS("time1_format")) {
+    case CONFIG_KEY_TIME2_FORMAT:
+        SET_STR(time2_format);
+        break;
+    case CONFIG_KEY_TIME1_TIMEZONE:
+        SET_STR(time1_timezone);
+        break;
+    case CONFIG_KEY_TIME2_TIMEZONE:
+        SET_STR(time2_timezone);
+        break;
+    case CONFIG_KEY_CLOCK_TOOLTIP:
+        SET_STR(time_tooltip_format);
+        break;
+    case CONFIG_KEY_CLOCK_TOOLTIP_TIMEZONE:
+        SET_STR(time_tooltip_timezone);
+        break;
+    case CONFIG_KEY_CLOCK_LCLICK_COMMAND:
+        SET_STR(clock_lclick_command);
+        break;
+    case CONFIG_KEY_CLOCK_RCLICK_COMMAND:
+        SET_STR(clock_rclick_command);
+        break;
+    case CONFIG_KEY_CLOCK_MCLICK_COMMAND:
+        SET_STR(clock_mclick_command);
+        break;
+    case CONFIG_KEY_CLOCK_UWHEEL_COMMAND:
+        SET_STR(clock_uwheel_command);
+        break;
+    case CONFIG_KEY_CLOCK_DWHEEL_COMMAND:
+        SET_STR(clock_dwheel_command);
+        break;
+    case CONFIG_KEY_TIME1_FORMAT:
         if (!new_config_file) {
             clock_enabled = TRUE;
             if (panel_items_order) {
@@ -852,103 +999,105 @@ void add_entry(char *key, char *value)
             time1_format = strdup(value);
             clock_enabled = TRUE;
         }
-
-    } else if (KEY_IS("time1_font")) {
+        break;
+    case CONFIG_KEY_TIME1_FONT:
         time1_font_desc = pango_font_description_from_string(value);
         time1_has_font = TRUE;
-
-    } else if (KEY_IS("time2_font")) {
+        break;
+    case CONFIG_KEY_TIME2_FONT:
         time2_font_desc = pango_font_description_from_string(value);
         time2_has_font = TRUE;
-
-    } else if (KEY_IS("clock_font_color")) {
+        break;
+    case CONFIG_KEY_CLOCK_FONT_COLOR:
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, panel_config.clock.font.rgb);
         if (value2)
             panel_config.clock.font.alpha = (atoi(value2) / 100.0);
         else
             panel_config.clock.font.alpha = 0.5;
-
-    } else if (KEY_IS("clock_padding")) {
+        break;
+    case CONFIG_KEY_CLOCK_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.clock.area.paddingxlr = panel_config.clock.area.paddingx = atoi(value1);
         if (value2)
             panel_config.clock.area.paddingy = atoi(value2);
         if (value3)
             panel_config.clock.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("clock_background_id")) {
+        break;
+    case CONFIG_KEY_CLOCK_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.clock.area.bg);
-    }
+        break;
 
     /* Taskbar */
-    SIMPLE_INT("taskbar_name", taskbarname_enabled)
-    SIMPLE_INT("taskbar_hide_inactive_tasks", hide_inactive_tasks)
-    SIMPLE_INT("taskbar_hide_different_monitor", hide_task_diff_monitor)
-    SIMPLE_INT("taskbar_hide_different_desktop", hide_task_diff_desktop)
-    SIMPLE_INT("taskbar_hide_if_empty", hide_taskbar_if_empty)
-    SIMPLE_INT("taskbar_always_show_all_desktop_tasks", always_show_all_desktop_tasks)
-
-    else if (KEY_IS("taskbar_mode")) {
+    case CONFIG_KEY_TASKBAR_NAME:
+        taskbarname_enabled = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_INACTIVE_TASKS:
+        hide_inactive_tasks = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_DIFFERENT_MONITOR:
+        hide_task_diff_monitor = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_DIFFERENT_DESKTOP:
+        hide_task_diff_desktop = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_IF_EMPTY:
+        hide_taskbar_if_empty = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_ALWAYS_SHOW_ALL_DESKTOP_TASKS:
+        always_show_all_desktop_tasks = atoi(value);
+        break;
+    case CONFIG_KEY_TASKBAR_MODE:
         if (strcmp(value, "multi_desktop") == 0)
             taskbar_mode = MULTI_DESKTOP;
         else
             taskbar_mode = SINGLE_DESKTOP;
-    } else if (KEY_IS("taskbar_distribute_size")) {
+        break;
+    case CONFIG_KEY_TASKBAR_DISTRIBUTE_SIZE:
         taskbar_distribute_size = atoi(value);
-    } else if (KEY_IS("taskbar_padding")) {
+        break;
+    case CONFIG_KEY_TASKBAR_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.g_taskbar.area.paddingxlr = panel_config.g_taskbar.area.paddingx = atoi(value1);
         if (value2)
             panel_config.g_taskbar.area.paddingy = atoi(value2);
         if (value3)
             panel_config.g_taskbar.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("taskbar_background_id")) {
+        break;
+    case CONFIG_KEY_TASKBAR_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.g_taskbar.background[TASKBAR_NORMAL]);
         if (panel_config.g_taskbar.background[TASKBAR_ACTIVE] == 0)
             panel_config.g_taskbar.background[TASKBAR_ACTIVE] = panel_config.g_taskbar.background[TASKBAR_NORMAL];
-
-    } else if (KEY_IS("taskbar_active_background_id")) {
+        break;
+    case CONFIG_KEY_TASKBAR_ACTIVE_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.g_taskbar.background[TASKBAR_ACTIVE]);
-
-    } else if (KEY_IS("taskbar_name_padding")) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.g_taskbar.area_name.paddingxlr = panel_config.g_taskbar.area_name.paddingx = atoi(value1);
         if (value2)
             panel_config.g_taskbar.area_name.paddingy = atoi(value2);
-
-
-    } else if (KEY_IS("taskbar_name_background_id")) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.g_taskbar.background_name[TASKBAR_NORMAL]);
         if (panel_config.g_taskbar.background_name[TASKBAR_ACTIVE] == 0)
             panel_config.g_taskbar.background_name[TASKBAR_ACTIVE] =
                 panel_config.g_taskbar.background_name[TASKBAR_NORMAL];
-
-    } else if (KEY_IS("taskbar_name_active_background_id")) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_ACTIVE_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.g_taskbar.background_name[TASKBAR_ACTIVE]);
-
-    } else if (KEY_IS("taskbar_name_font")) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_FONT:
         panel_config.taskbarname_font_desc = pango_font_description_from_string(value);
         panel_config.taskbarname_has_font = TRUE;
-
-    } else if (KEY_IS("taskbar_name_font_color")) {
-        extract_values(value, &value1, &value2, &value3);
-        get_color(value1, taskbarname_font.rgb);
-        if (value2)
-            taskbarname_font.alpha = (atoi(value2) / 100.0);
-        else
-            taskbarname_font.alpha = 0.5;
-
-    } else if (KEY_IS("taskbar_name_active_font_color")) {
-        extract_values(value, &value1, &value2, &value3);
-        get_color(value1, taskbarname_active_font.rgb);
-        if (value2)
-            taskbarname_active_font.alpha = (atoi(value2) / 100.0);
-        else
-            taskbarname_active_font.alpha = 0.5;
-
-    } else if (KEY_IS("taskbar_sort_order")) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_FONT_COLOR:
+        read_font_color(value, &taskbarname_font);
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_ACTIVE_FONT_COLOR:
+        read_font_color(value, &taskbarname_active_font);
+        break;
+    case CONFIG_KEY_TASKBAR_SORT_ORDER:
         if (strcmp(value, "center") == 0) {
             taskbar_sort_method = TASKBAR_SORT_CENTER;
         } else if (strcmp(value, "title") == 0) {
@@ -962,8 +1111,8 @@ void add_entry(char *key, char *value)
         } else {
             taskbar_sort_method = TASKBAR_NOSORT;
         }
-
-    } else if (KEY_IS("task_align")) {
+        break;
+    case CONFIG_KEY_TASK_ALIGN:
         if (strcmp(value, "center") == 0) {
             taskbar_alignment = ALIGN_CENTER;
         } else if (strcmp(value, "right") == 0) {
@@ -971,47 +1120,62 @@ void add_entry(char *key, char *value)
         } else {
             taskbar_alignment = ALIGN_LEFT;
         }
-    }
+        break;
 
     /* Task */
-    SIMPLE_INT("task_text", panel_config.g_task.has_text)
-    SIMPLE_INT("task_icon", panel_config.g_task.has_icon)
-    SIMPLE_INT("task_centered", panel_config.g_task.centered)
+    case CONFIG_KEY_TASK_TEXT:
+        panel_config.g_task.has_text = atoi(value);
+        break;
+    case CONFIG_KEY_TASK_ICON:
+        panel_config.g_task.has_icon = atoi(value);
+        break;
+    case CONFIG_KEY_TASK_CENTERED:
+        panel_config.g_task.centered = atoi(value);
+        break;
     // "tooltip" is deprecated but here for backwards compatibility
-    SIMPLE_INT("task_tooltip", panel_config.g_task.tooltip_enabled)
-
-    SIMPLE_INT("task_thumbnail", panel_config.g_task.thumbnail_enabled)
-    else if (KEY_IS("task_thumbnail_size")) panel_config.g_task.thumbnail_width = MAX(8, atoi(value));
-
-    else if (KEY_IS("task_width")) {
+    case CONFIG_KEY_TASK_TOOLTIP:
+        panel_config.g_task.tooltip_enabled = atoi(value);
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL:
+        panel_config.g_task.thumbnail_enabled = atoi(value);
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL_SIZE:
+        panel_config.g_task.thumbnail_width = MAX(8, atoi(value));
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL_CACHE_SIZE:
+        panel_config.g_task.thumbnail_cache_size = MAX(1, atoi(value));
+        break;
+    case CONFIG_KEY_TASK_WIDTH:
         // old parameter : just for backward compatibility
         panel_config.g_task.maximum_width = atoi(value);
         panel_config.g_task.maximum_height = 30;
-
-    } else if (KEY_IS("task_maximum_size")) {
+        break;
+    case CONFIG_KEY_TASK_MAXIMUM_SIZE:
         extract_values(value, &value1, &value2, &value3);
         panel_config.g_task.maximum_width = atoi(value1);
         if (value2)
             panel_config.g_task.maximum_height = atoi(value2);
         else
             panel_config.g_task.maximum_height = panel_config.g_task.maximum_width;
-
-    } else if (KEY_IS("task_padding")) {
+        break;
+    case CONFIG_KEY_TASK_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.g_task.area.paddingxlr = panel_config.g_task.area.paddingx = atoi(value1);
         if (value2)
             panel_config.g_task.area.paddingy = atoi(value2);
         if (value3)
             panel_config.g_task.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("task_font")) {
+        break;
+    case CONFIG_KEY_TASK_FONT:
         panel_config.g_task.font_desc = pango_font_description_from_string(value);
         panel_config.g_task.has_font = TRUE;
-
-    } else if (g_regex_match_simple("task.*_font_color", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
-        int status = g_strv_length(split) == 3 ? TASK_NORMAL : get_task_status(split[1]);
-        g_strfreev(split);
+        break;
+    case CONFIG_KEY_TASK_FONT_COLOR:
+    case CONFIG_KEY_TASK_NORMAL_FONT_COLOR:
+    case CONFIG_KEY_TASK_ACTIVE_FONT_COLOR:
+    case CONFIG_KEY_TASK_ICONIFIED_FONT_COLOR:
+    case CONFIG_KEY_TASK_URGENT_FONT_COLOR: {
+        int status = get_task_status_of_key(key_id);
         if (status >= 0) {
             extract_values(value, &value1, &value2, &value3);
             float alpha = 1;
@@ -1021,11 +1185,14 @@ void add_entry(char *key, char *value)
             panel_config.g_task.font[status].alpha = alpha;
             panel_config.g_task.config_font_mask |= (1 << status);
         }
-
-    } else if (g_regex_match_simple("task.*_icon_asb", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
-        int status = g_strv_length(split) == 3 ? TASK_NORMAL : get_task_status(split[1]);
-        g_strfreev(split);
+        break;
+    }
+    case CONFIG_KEY_TASK_ICON_ASB:
+    case CONFIG_KEY_TASK_NORMAL_ICON_ASB:
+    case CONFIG_KEY_TASK_ACTIVE_ICON_ASB:
+    case CONFIG_KEY_TASK_ICONIFIED_ICON_ASB:
+    case CONFIG_KEY_TASK_URGENT_ICON_ASB: {
+        int status = get_task_status_of_key(key_id);
         if (status >= 0) {
             extract_values(value, &value1, &value2, &value3);
             panel_config.g_task.alpha[status] = atoi(value1);
@@ -1033,11 +1200,14 @@ void add_entry(char *key, char *value)
             panel_config.g_task.brightness[status] = atoi(value3);
             panel_config.g_task.config_asb_mask |= (1 << status);
         }
-
-    } else if (g_regex_match_simple("task.*_background_id", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
-        int status = g_strv_length(split) == 3 ? TASK_NORMAL : get_task_status(split[1]);
-        g_strfreev(split);
+        break;
+    }
+    case CONFIG_KEY_TASK_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_NORMAL_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_ACTIVE_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_ICONIFIED_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_URGENT_BACKGROUND_ID: {
+        int status = get_task_status_of_key(key_id);
         if (status >= 0) {
             SET_BG_IDX(value, panel_config.g_task.background[status]);
 
@@ -1048,12 +1218,14 @@ void add_entry(char *key, char *value)
                 panel_config.g_task.background[status]->fill_content_tint_weight > 0)
                 panel_config.g_task.has_content_tint = TRUE;
         }
+        break;
     }
 
     /* Systray */
-    SIMPLE_INT("systray_icon_size", systray_max_icon_size)
-
-    else if (KEY_IS("systray_padding")) {
+    case CONFIG_KEY_SYSTRAY_ICON_SIZE:
+        systray_max_icon_size = atoi(value);
+        break;
+    case CONFIG_KEY_SYSTRAY_PADDING:
         if (!new_config_file && systray_enabled == 0) {
             systray_enabled = TRUE;
             if (panel_items_order) {
@@ -1070,11 +1242,11 @@ void add_entry(char *key, char *value)
             systray.area.paddingy = atoi(value2);
         if (value3)
             systray.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("systray_background_id")) {
+        break;
+    case CONFIG_KEY_SYSTRAY_BACKGROUND_ID:
         SET_BG_IDX(value, systray.area.bg);
-
-    } else if (KEY_IS("systray_sort")) {
+        break;
+    case CONFIG_KEY_SYSTRAY_SORT:
         if (strcmp(value, "descending") == 0)
             systray.sort = SYSTRAY_SORT_DESCENDING;
         else if (strcmp(value, "ascending") == 0)
@@ -1083,157 +1255,169 @@ void add_entry(char *key, char *value)
             systray.sort = SYSTRAY_SORT_LEFT2RIGHT;
         else if (strcmp(value, "right2left") == 0)
             systray.sort = SYSTRAY_SORT_RIGHT2LEFT;
-
-    } else if (KEY_IS("systray_icon_asb")) {
+        break;
+    case CONFIG_KEY_SYSTRAY_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         systray.alpha = atoi(value1);
         systray.saturation = atoi(value2);
         systray.brightness = atoi(value3);
-
-    } else if (KEY_IS("systray_monitor")) {
+        break;
+    case CONFIG_KEY_SYSTRAY_MONITOR:
         systray_monitor = MAX(0, config_get_monitor(value));
-
-    } else if (KEY_IS("systray_name_filter")) {
+        break;
+    case CONFIG_KEY_SYSTRAY_NAME_FILTER:
         if (systray_hide_name_filter) {
             fprintf(stderr, "tint2: Error: duplicate option 'systray_name_filter'. Please use it only once. See "
                             "https://gitlab.com/o9000/tint2/issues/652\n");
             free(systray_hide_name_filter);
         }
         systray_hide_name_filter = strdup(value);
-    }
+        break;
 
     /* Launcher */
-    SIMPLE_INT("launcher_icon_size", launcher_max_icon_size)
-    SIMPLE_INT("launcher_icon_theme_override", launcher_icon_theme_override)
-    SIMPLE_INT("launcher_tooltip", launcher_tooltip_enabled)
-    SIMPLE_INT("startup_notifications", startup_notifications)
-
-    else if (KEY_IS("launcher_padding")) {
+    case CONFIG_KEY_LAUNCHER_ICON_SIZE:
+        launcher_max_icon_size = atoi(value);
+        break;
+    case CONFIG_KEY_LAUNCHER_ICON_THEME_OVERRIDE:
+        launcher_icon_theme_override = atoi(value);
+        break;
+    case CONFIG_KEY_LAUNCHER_TOOLTIP:
+        launcher_tooltip_enabled = atoi(value);
+        break;
+    case CONFIG_KEY_STARTUP_NOTIFICATIONS:
+        startup_notifications = atoi(value);
+        break;
+    case CONFIG_KEY_LAUNCHER_PADDING:
         extract_values(value, &value1, &value2, &value3);
         panel_config.launcher.area.paddingxlr = panel_config.launcher.area.paddingx = atoi(value1);
         if (value2)
             panel_config.launcher.area.paddingy = atoi(value2);
         if (value3)
             panel_config.launcher.area.paddingx = atoi(value3);
-
-    } else if (KEY_IS("launcher_background_id")) {
+        break;
+    case CONFIG_KEY_LAUNCHER_BACKGROUND_ID:
         SET_BG_IDX(value, panel_config.launcher.area.bg);
-
-    } else if (KEY_IS("launcher_icon_background_id")) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ICON_BACKGROUND_ID:
         SET_BG_IDX(value, launcher_icon_bg);
-
-    } else if (KEY_IS("launcher_item_app")) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ITEM_APP: {
         char *app = expand_tilde(value);
         panel_config.launcher.list_apps = g_slist_append(panel_config.launcher.list_apps, app);
-
-    } else if (KEY_IS("launcher_apps_dir")) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_APPS_DIR: {
         char *path = expand_tilde(value);
         load_launcher_app_dir(path);
         free(path);
-
-    } else if (KEY_IS("launcher_icon_theme")) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_ICON_THEME:
         // if XSETTINGS manager running, tint2 use it.
         if (icon_theme_name_config)
             free(icon_theme_name_config);
         icon_theme_name_config = strdup(value);
-
-    } else if (KEY_IS("launcher_icon_asb")) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         launcher_alpha = atoi(value1);
         launcher_saturation = atoi(value2);
         launcher_brightness = atoi(value3);
-    }
+        break;
 
     /* Tooltip */
-    else if (KEY_IS("tooltip_show_timeout")) {
+    case CONFIG_KEY_TOOLTIP_SHOW_TIMEOUT: {
         int timeout_msec = 1000 * atof(value);
         g_tooltip.show_timeout_msec = timeout_msec;
-
-    } else if (KEY_IS("tooltip_hide_timeout")) {
+        break;
+    }
+    case CONFIG_KEY_TOOLTIP_HIDE_TIMEOUT: {
         int timeout_msec = 1000 * atof(value);
         g_tooltip.hide_timeout_msec = timeout_msec;
-
-    } else if (KEY_IS("tooltip_padding")) {
+        break;
+    }
+    case CONFIG_KEY_TOOLTIP_PADDING:
         extract_values(value, &value1, &value2, &value3);
         if (value1)
             g_tooltip.paddingx = atoi(value1);
         if (value2)
             g_tooltip.paddingy = atoi(value2);
-
-    } else if (KEY_IS("tooltip_background_id")) {
+        break;
+    case CONFIG_KEY_TOOLTIP_BACKGROUND_ID:
         SET_BG_IDX(value, g_tooltip.bg);
-
-    } else if (KEY_IS("tooltip_font_color")) {
+        break;
+    case CONFIG_KEY_TOOLTIP_FONT_COLOR:
         extract_values(value, &value1, &value2, &value3);
         get_color(value1, g_tooltip.font_color.rgb);
         if (value2)
             g_tooltip.font_color.alpha = (atoi(value2) / 100.0);
         else
             g_tooltip.font_color.alpha = 0.1;
-
-    } else if (KEY_IS("tooltip_font")) {
+        break;
+    case CONFIG_KEY_TOOLTIP_FONT:
         g_tooltip.font_desc = pango_font_description_from_string(value);
-    }
+        break;
 
     /* Mouse actions */
-    else if (KEY_IS("mouse_left"))
+    case CONFIG_KEY_MOUSE_LEFT:
         get_action(value, &mouse_left);
-
-    else if (KEY_IS("mouse_middle"))
+        break;
+    case CONFIG_KEY_MOUSE_MIDDLE:
         get_action(value, &mouse_middle);
-
-    else if (KEY_IS("mouse_right"))
+        break;
+    case CONFIG_KEY_MOUSE_RIGHT:
         get_action(value, &mouse_right);
-
-    else if (KEY_IS("mouse_scroll_up"))
+        break;
+    case CONFIG_KEY_MOUSE_SCROLL_UP:
         get_action(value, &mouse_scroll_up);
-
-    else if (KEY_IS("mouse_scroll_down"))
+        break;
+    case CONFIG_KEY_MOUSE_SCROLL_DOWN:
         get_action(value, &mouse_scroll_down);
-
-    else if (KEY_IS("mouse_effects"))
+        break;
+    case CONFIG_KEY_MOUSE_EFFECTS:
         panel_config.mouse_effects = atoi(value);
-
-    else if (KEY_IS("mouse_hover_icon_asb")) {
+        break;
+    case CONFIG_KEY_MOUSE_HOVER_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         panel_config.mouse_over_alpha = atoi(value1);
         panel_config.mouse_over_saturation = atoi(value2);
         panel_config.mouse_over_brightness = atoi(value3);
-
-    } else if (KEY_IS("mouse_pressed_icon_asb")) {
+        break;
+    case CONFIG_KEY_MOUSE_PRESSED_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         panel_config.mouse_pressed_alpha = atoi(value1);
         panel_config.mouse_pressed_saturation = atoi(value2);
         panel_config.mouse_pressed_brightness = atoi(value3);
-    }
+        break;
 
     /* autohide options */
-    SIMPLE_INT("autohide", panel_autohide)
-
-    else if (KEY_IS("autohide_show_timeout"))
+    case CONFIG_KEY_AUTOHIDE:
+        panel_autohide = atoi(value);
+        break;
+    case CONFIG_KEY_AUTOHIDE_SHOW_TIMEOUT:
         panel_autohide_show_timeout = 1000 * atof(value);
-
-    else if (KEY_IS("autohide_hide_timeout"))
+        break;
+    case CONFIG_KEY_AUTOHIDE_HIDE_TIMEOUT:
         panel_autohide_hide_timeout = 1000 * atof(value);
-
-    else if (KEY_IS("strut_policy")) {
+        break;
+    case CONFIG_KEY_STRUT_POLICY:
         if (strcmp(value, "follow_size") == 0)
             panel_strut_policy = STRUT_FOLLOW_SIZE;
         else if (strcmp(value, "none") == 0)
             panel_strut_policy = STRUT_NONE;
         else
             panel_strut_policy = STRUT_MINIMUM;
-
-    } else if (KEY_IS("autohide_height")) {
+        break;
+    case CONFIG_KEY_AUTOHIDE_HEIGHT:
         panel_autohide_height = atoi(value);
         if (panel_autohide_height == 0) {
             // autohide need height > 0
             panel_autohide_height = 1;
         }
-    }
+        break;
 
     // old config option
-    else if (KEY_IS("systray")) {
+    case CONFIG_KEY_SYSTRAY:
         if (!new_config_file) {
             systray_enabled = atoi(value);
             if (systray_enabled) {
@@ -1246,10 +1430,9 @@ void add_entry(char *key, char *value)
                     panel_items_order = strdup("S");
             }
         }
-    }
-
+        break;
 #ifdef ENABLE_BATTERY
-    else if (KEY_IS("battery")) {
+    case CONFIG_KEY_BATTERY:
         if (!new_config_file) {
             battery_enabled = atoi(value);
             if (battery_enabled) {
@@ -1262,44 +1445,79 @@ void add_entry(char *key, char *value)
                     panel_items_order = strdup("B");
             }
         }
-    }
+        break;
 #endif
-
-    else if (KEY_IS("primary_monitor_first")) {
+    case CONFIG_KEY_PRIMARY_MONITOR_FIRST:
         fprintf(stderr,
                 "tint2: deprecated config option \"%s\"\n"
                 "       Please see the documentation regarding the alternatives.\n",
                 key);
-    } else
+        break;
+    default:
+#ifndef ENABLE_BATTERY
+        // The battery options (including the deprecated "battery") are not supported in this build
+        if (config_keys[key_id].section == CONFIG_SECTION_BATTERY)
+            break;
+#endif
         fprintf(stderr, "tint2: invalid option \"%s\",\n  upgrade tint2 or correct your config file\n", key);
+    }
 
-    #undef KEY_IS
+    #undef SET_BG_GRADIENT
+    #undef SET_BG
 
     if (value1) free(value1);
     if (value2) free(value2);
     if (value3) free(value3);
 }
 
-gboolean config_read_file(const char *path)
+static void free_config_entry(gpointer data)
 {
-    fprintf(stderr, "tint2: Loading config file: %s\n", path);
+    ConfigEntry *entry = (ConfigEntry *)data;
+    free(entry->key);
+    free(entry->value);
+    free(entry);
+}
 
+// Returns the options of a config file, or NULL if it cannot be read
+static GPtrArray *config_load_entries(const char *path)
+{
     FILE *fp = fopen(path, "r");
     if (!fp)
-        return FALSE;
+        return NULL;
 
+    GPtrArray *entries = g_ptr_array_new_with_free_func(free_config_entry);
     char *line = NULL;
     size_t line_size = 0;
     while (getline(&line, &line_size, fp) >= 0) {
         char *key, *value;
         if (parse_line(line, &key, &value)) {
-            add_entry(key, value);
-            free(key);
-            free(value);
+            ConfigEntry *entry = (ConfigEntry *)calloc(1, sizeof(ConfigEntry));
+            entry->id = config_key_lookup(key);
+            entry->key = key;
+            entry->value = value;
+            g_ptr_array_add(entries, entry);
         }
     }
     free(line);
     fclose(fp);
+    return entries;
+}
+
+gboolean config_read_file(const char *path)
+{
+    fprintf(stderr, "tint2: Loading config file: %s\n", path);
+
+    GPtrArray *entries = config_load_entries(path);
+    if (!entries)
+        return FALSE;
+
+    for (guint i = 0; i < entries->len; i++) {
+        ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(entries, i);
+        add_entry(entry->key, entry->value);
+    }
+    if (config_entries)
+        g_ptr_array_free(config_entries, TRUE);
+    config_entries = entries;
 
     if (!read_panel_position) {
         panel_horizontal = TRUE;
@@ -1319,17 +1537,7 @@ gboolean config_read_file(const char *path)
         }
     }
 
-    if (backgrounds->len > 0) {
-        Background *bg = &g_array_index(backgrounds, Background, backgrounds->len - 1);
-        if (!read_bg_color_hover)
-            memcpy(&bg->fill_color_hover, &bg->fill_color, sizeof(Color));
-        if (!read_border_color_hover)
-            memcpy(&bg->border_color_hover, &bg->border, sizeof(Color));
-        if (!read_bg_color_press)
-            memcpy(&bg->fill_color_pressed, &bg->fill_color_hover, sizeof(Color));
-        if (!read_border_color_press)
-            memcpy(&bg->border_color_pressed, &bg->border_color_hover, sizeof(Color));
-    }
+    finalize_bg();
 
     return TRUE;
 }
@@ -1413,4 +1621,271 @@ gboolean config_read()
     return config_read_default_path();
 }
 
+int config_get_panel_monitor()
+{
+    int monitor = 0;
+    for (guint i = 0; config_entries && i < config_entries->len; i++) {
+        ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(config_entries, i);
+        if (entry->id == CONFIG_KEY_PANEL_MONITOR)
+            monitor = config_get_monitor(entry->value);
+    }
+    return monitor;
+}
+
+#define SECTION_BIT(section) (1u << (CONFIG_SECTION_##section))
+
+// Returns TRUE if the entry is an option of the section, and is not ignored
+static gboolean config_entry_in_section(ConfigEntry *entry, int section, gboolean (*ignore)(ConfigKeyId))
+{
+    return config_keys[entry->id].section == section && !(ignore && ignore(entry->id));
+}
+
+// Returns the sections whose options differ between two configurations, as a bit mask.
+// The options for which ignore returns TRUE are not compared (ignore can be NULL).
+static guint config_diff_sections(GPtrArray *old_entries, GPtrArray *new_entries, gboolean (*ignore)(ConfigKeyId))
+{
+    guint changed = 0;
+    for (int section = 0; section < NUM_CONFIG_SECTIONS; section++) {
+        // Walk the options of the section in both configurations, in file order
+        guint i = 0, j = 0;
+        while (TRUE) {
+            while (i < old_entries->len &&
+                   !config_entry_in_section(g_ptr_array_index(old_entries, i), section, ignore))
+                i++;
+            while (j < new_entries->len &&
+                   !config_entry_in_section(g_ptr_array_index(new_entries, j), section, ignore))
+                j++;
+            if (i == old_entries->len || j == new_entries->len) {
+                if (i != old_entries->len || j != new_entries->len)
+                    changed |= 1u << section;
+                break;
+            }
+            ConfigEntry *a = (ConfigEntry *)g_ptr_array_index(old_entries, i);
+            ConfigEntry *b = (ConfigEntry *)g_ptr_array_index(new_entries, j);
+            if (a->id != b->id || strcmp(a->value, b->value) != 0) {
+                changed |= 1u << section;
+                break;
+            }
+            i++;
+            j++;
+        }
+    }
+    return changed;
+}
+
+static void config_apply_section(GPtrArray *entries, ConfigSection section)
+{
+    for (guint i = 0; i < entries->len; i++) {
+        ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(entries, i);
+        if (config_keys[entry->id].section == section)
+            add_entry(entry->key, entry->value);
+    }
+}
+
+// Reads the backgrounds again and updates them in place, so that the areas using them only need to be redrawn.
+// Fails if backgrounds have been added or removed, or if their gradients have changed.
+static gboolean config_reload_backgrounds(GPtrArray *entries)
+{
+    GArray *current = backgrounds;
+    backgrounds = g_array_new(0, 0, sizeof(Background));
+    Background transparent_bg;
+    init_background(&transparent_bg);
+    g_array_append_val(backgrounds, transparent_bg);
+    config_apply_section(entries, CONFIG_SECTION_BACKGROUNDS);
+    finalize_bg();
+    GArray *reloaded = backgrounds;
+    backgrounds = current;
+
+    gboolean compatible = reloaded->len == current->len;
+    for (guint i = 0; compatible && i < current->len; i++)
+        compatible = memcmp(g_array_index(current, Background, i).gradients,
+                            g_array_index(reloaded, Background, i).gradients,
+                            sizeof(transparent_bg.gradients)) == 0;
+    if (compatible) {
+        memcpy(current->data, reloaded->data, current->len * sizeof(Background));
+        // Border widths may have changed
+        for (int i = 0; i < num_panels; i++) {
+            schedule_resize_tree(&panels[i].area);
+            set_panel_background(&panels[i]);
+        }
+    }
+    g_array_free(reloaded, TRUE);
+    return compatible;
+}
+
+static void config_reload_clock(GPtrArray *entries)
+{
+    cleanup_clock();
+    default_clock();
+    memset(&panel_config.clock, 0, sizeof(panel_config.clock));
+    clock_enabled = strchr(panel_items_order, 'C') != NULL;
+    config_apply_section(entries, CONFIG_SECTION_CLOCK);
+    init_clock();
+    reinit_clock_panels();
+}
+
+static void config_reload_tooltip(GPtrArray *entries)
+{
+    cleanup_tooltip();
+    default_tooltip();
+    config_apply_section(entries, CONFIG_SECTION_TOOLTIP);
+    init_tooltip();
+}
+
+// The font colors of the tasks, taskbar names, buttons and executors are only used for drawing
+static gboolean is_font_color_key(ConfigKeyId id)
+{
+    switch (id) {
+    case CONFIG_KEY_TASK_FONT_COLOR:
+    case CONFIG_KEY_TASK_NORMAL_FONT_COLOR:
+    case CONFIG_KEY_TASK_ACTIVE_FONT_COLOR:
+    case CONFIG_KEY_TASK_ICONIFIED_FONT_COLOR:
+    case CONFIG_KEY_TASK_URGENT_FONT_COLOR:
+    case CONFIG_KEY_TASKBAR_NAME_FONT_COLOR:
+    case CONFIG_KEY_TASKBAR_NAME_ACTIVE_FONT_COLOR:
+    case CONFIG_KEY_BUTTON_FONT_COLOR:
+    case CONFIG_KEY_EXECP_FONT_COLOR:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+// Returns TRUE if an executor has been copied for each monitor (execp_isolate), so that the executors no longer
+// match the configured ones
+static gboolean execp_isolated()
+{
+    for (GList *l = panel_config.execp_list; l; l = l->next) {
+        if (((Execp *)l->data)->backend->isolate)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static Color *button_font_color(gpointer item)
+{
+    return &((Button *)item)->backend->font_color;
+}
+
+static Color *execp_font_color(gpointer item)
+{
+    return &((Execp *)item)->backend->font_color;
+}
+
+// Sets the font colors of the buttons or executors (the items of list) from the options of section: the options of
+// the n-th item follow the n-th item_key option. Items without a font color get the default one.
+static void config_reload_item_font_colors(GPtrArray *entries,
+                                           ConfigSection section,
+                                           ConfigKeyId item_key,
+                                           ConfigKeyId font_color_key,
+                                           GList *list,
+                                           Color *(*font_color)(gpointer item))
+{
+    for (GList *l = list; l; l = l->next) {
+        Color *color = font_color(l->data);
+        memset(color, 0, sizeof(*color));
+        color->alpha = 0.5;
+    }
+    int n = -1;
+    for (guint i = 0; i < entries->len; i++) {
+        ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(entries, i);
+        if (config_keys[entry->id].section != section)
+            continue;
+        if (entry->id == item_key) {
+            n++;
+        } else if (entry->id == font_color_key && n >= 0) {
+            // Items missing from panel_items have been removed from the end of the list
+            GList *item = g_list_nth(list, (guint)n);
+            if (item)
+                read_font_color(entry->value, font_color(item->data));
+        }
+    }
+}
+
+// Reloads the font colors of the sections (a bit mask) in which nothing else changed
+static void config_reload_font_colors(GPtrArray *entries, guint sections)
+{
+    if (sections & SECTION_BIT(TASK)) {
+        panel_config.g_task.config_font_mask = 0;
+        for (guint i = 0; i < entries->len; i++) {
+            ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(entries, i);
+            if (config_keys[entry->id].section == CONFIG_SECTION_TASK && is_font_color_key(entry->id))
+                add_entry(entry->key, entry->value);
+        }
+        for (int i = 0; i < num_panels; i++) {
+            memcpy(panels[i].g_task.font, panel_config.g_task.font, sizeof(panels[i].g_task.font));
+            panels[i].g_task.config_font_mask = panel_config.g_task.config_font_mask;
+            init_task_font_colors(&panels[i]);
+        }
+    }
+    if (sections & SECTION_BIT(TASKBAR)) {
+        memset(&taskbarname_font, 0, sizeof(taskbarname_font));
+        memset(&taskbarname_active_font, 0, sizeof(taskbarname_active_font));
+        for (guint i = 0; i < entries->len; i++) {
+            ConfigEntry *entry = (ConfigEntry *)g_ptr_array_index(entries, i);
+            if (config_keys[entry->id].section == CONFIG_SECTION_TASKBAR && is_font_color_key(entry->id))
+                add_entry(entry->key, entry->value);
+        }
+    }
+    if (sections & SECTION_BIT(BUTTON))
+        config_reload_item_font_colors(entries,
+                                       CONFIG_SECTION_BUTTON,
+                                       CONFIG_KEY_BUTTON,
+                                       CONFIG_KEY_BUTTON_FONT_COLOR,
+                                       panel_config.button_list,
+                                       button_font_color);
+    if (sections & SECTION_BIT(EXECUTOR))
+        config_reload_item_font_colors(entries,
+                                       CONFIG_SECTION_EXECUTOR,
+                                       CONFIG_KEY_EXECP,
+                                       CONFIG_KEY_EXECP_FONT_COLOR,
+                                       panel_config.execp_list,
+                                       execp_font_color);
+    for (int i = 0; i < num_panels; i++)
+        schedule_redraw(&panels[i].area);
+}
+
+gboolean config_reload()
+{
+    // Old config files (without panel_items) derive the panel items from other options
+    if (!config_path || !config_entries || !new_config_file)
+        return FALSE;
+
+    GPtrArray *entries = config_load_entries(config_path);
+    if (!entries)
+        return FALSE;
+
+    // Reloaded in place: the backgrounds, clock and tooltip sections, and the task, taskbar, button and executor
+    // sections when only their font colors changed. Any other change (e.g. to the panel, launcher, systray, battery
+    // or separator sections, or to the fonts) restarts tint2.
+    guint changed = config_diff_sections(config_entries, entries, NULL);
+    guint font_colors = changed & ~config_diff_sections(config_entries, entries, is_font_color_key);
+    if ((font_colors & SECTION_BIT(EXECUTOR)) && execp_isolated())
+        font_colors &= ~SECTION_BIT(EXECUTOR);
+    guint reloadable = SECTION_BIT(BACKGROUNDS) | SECTION_BIT(CLOCK) | SECTION_BIT(TOOLTIP) | font_colors;
+    if ((changed & ~reloadable) ||
+        ((changed & SECTION_BIT(BACKGROUNDS)) && !config_reload_backgrounds(entries))) {
+        g_ptr_array_free(entries, TRUE);
+        return FALSE;
+    }
+    if (changed & SECTION_BIT(CLOCK))
+        config_reload_clock(entries);
+    if (changed & SECTION_BIT(TOOLTIP))
+        config_reload_tooltip(entries);
+    if (font_colors)
+        config_reload_font_colors(entries, font_colors);
+
+    if (changed) {
+        fprintf(stderr, "tint2: Reloaded config file in place: %s\n", config_path);
+        schedule_panel_redraw();
+    } else {
+        fprintf(stderr, "tint2: Config file unchanged: %s\n", config_path);
+    }
+    g_ptr_array_free(config_entries, TRUE);
+    config_entries = entries;
+    return TRUE;
+}
+
+#undef SECTION_BIT
+
 #endif
@@ -22,4 +22,11 @@ void cleanup_config();
 
 gboolean config_read();
 
+// Returns the index of the monitor selected by panel_monitor among the current monitors, or -1 for all monitors
+int config_get_panel_monitor();
+
+// Reads the config file again and applies the changes in place, when only options that can be reloaded
+// independently have changed (backgrounds, clock, tooltip). Returns FALSE if tint2 must restart instead.
+gboolean config_reload();
+
 #endif
@@ -0,0 +1,163 @@
+/**************************************************************************
+*
+* Tint2 : the options of the config file
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config_keys.h"
+#include "test.h"
+
+const ConfigKey config_keys[NUM_CONFIG_KEYS] = {
+    {NULL, CONFIG_VALUE_STRING, NUM_CONFIG_SECTIONS},
+#define CONFIG_KEY_ENTRY(id, name, type, section) {name, CONFIG_VALUE_##type, CONFIG_SECTION_##section},
+    CONFIG_KEYS(CONFIG_KEY_ENTRY)
+#undef CONFIG_KEY_ENTRY
+};
+
+// Maps names and aliases to ConfigKeyId, built on first use
+static GHashTable *config_key_index;
+
+ConfigKeyId config_key_lookup(const char *name)
+{
+    if (!config_key_index) {
+        config_key_index = g_hash_table_new(g_str_hash, g_str_equal);
+        for (int id = 1; id < NUM_CONFIG_KEYS; id++)
+            g_hash_table_insert(config_key_index, (gpointer)config_keys[id].name, GINT_TO_POINTER(id));
+#define CONFIG_KEY_ALIAS(id, name) \
+        g_hash_table_insert(config_key_index, (gpointer)name, GINT_TO_POINTER(CONFIG_KEY_##id));
+        CONFIG_KEY_ALIASES(CONFIG_KEY_ALIAS)
+#undef CONFIG_KEY_ALIAS
+    }
+    return (ConfigKeyId)GPOINTER_TO_INT(g_hash_table_lookup(config_key_index, name));
+}
+
+ConfigKeyState config_key_state(ConfigKeyId id)
+{
+    switch (id) {
+#define CONFIG_KEY_STATE(id, state) \
+    case CONFIG_KEY_##id: \
+        return CONFIG_STATE_##state;
+        CONFIG_KEY_STATES(CONFIG_KEY_STATE)
+#undef CONFIG_KEY_STATE
+    default:
+        return CONFIG_STATE_NONE;
+    }
+}
+
+// Parses an optionally signed integer at *s, followed by '%' if allow_percent; advances *s past it.
+static gboolean skip_int(const char **s, gboolean allow_percent)
+{
+    const char *p = *s;
+    if (*p == '-' || *p == '+')
+        p++;
+    if (!isdigit((unsigned char)*p))
+        return FALSE;
+    while (isdigit((unsigned char)*p))
+        p++;
+    if (allow_percent && *p == '%')
+        p++;
+    *s = p;
+    return TRUE;
+}
+
+static void skip_spaces(const char **s)
+{
+    while (**s == ' ')
+        (*s)++;
+}
+
+gboolean config_value_is_valid(ConfigKeyId id, const char *value)
+{
+    if (id <= CONFIG_KEY_UNKNOWN || id >= NUM_CONFIG_KEYS)
+        return FALSE;
+    if (!value || !*value)
+        return TRUE;
+    const char *p = value;
+    switch (config_keys[id].type) {
+    case CONFIG_VALUE_STRING:
+        return TRUE;
+    case CONFIG_VALUE_INT:
+        return skip_int(&p, FALSE) && !*p;
+    case CONFIG_VALUE_FLOAT: {
+        char *end;
+        g_ascii_strtod(value, &end);
+        return end != value && !*end;
+    }
+    case CONFIG_VALUE_COLOR: {
+        if (*p != '#')
+            return FALSE;
+        p++;
+        size_t len = strspn(p, "0123456789abcdefABCDEF");
+        if (len != 3 && len != 6 && len != 12)
+            return FALSE;
+        p += len;
+        if (!*p)
+            return TRUE;
+        skip_spaces(&p);
+        return skip_int(&p, FALSE) && !*p;
+    }
+    case CONFIG_VALUE_SIZES:
+        for (int i = 0; i < 3; i++) {
+            if (!skip_int(&p, TRUE))
+                return FALSE;
+            if (!*p)
+                return TRUE;
+            if (*p != ' ')
+                return FALSE;
+            skip_spaces(&p);
+        }
+        return !*p;
+    }
+    return TRUE;
+}
+
+TEST(config_key_lookup)
+{
+    for (int id = 1; id < NUM_CONFIG_KEYS; id++) {
+        // Names must be unique
+        ASSERT(config_key_lookup(config_keys[id].name) == (ConfigKeyId)id);
+    }
+    ASSERT(config_key_lookup("hover_gradient_id") == CONFIG_KEY_GRADIENT_ID_HOVER);
+    ASSERT(config_key_lookup("panel_items") == CONFIG_KEY_PANEL_ITEMS);
+    ASSERT(config_key_lookup("panel_itemz") == CONFIG_KEY_UNKNOWN);
+    ASSERT(config_key_lookup("") == CONFIG_KEY_UNKNOWN);
+}
+
+TEST(config_key_state)
+{
+    ASSERT(config_key_state(CONFIG_KEY_TASK_FONT_COLOR) == CONFIG_STATE_NONE);
+    ASSERT(config_key_state(CONFIG_KEY_TASK_ICONIFIED_ICON_ASB) == CONFIG_STATE_ICONIFIED);
+    ASSERT(config_key_state(CONFIG_KEY_TASK_URGENT_BACKGROUND_ID) == CONFIG_STATE_URGENT);
+    ASSERT(config_key_state(CONFIG_KEY_PANEL_ITEMS) == CONFIG_STATE_NONE);
+}
+
+TEST(config_value_is_valid)
+{
+    ASSERT(config_value_is_valid(CONFIG_KEY_BORDER_WIDTH, "2"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_BORDER_WIDTH, ""));
+    ASSERT(!config_value_is_valid(CONFIG_KEY_BORDER_WIDTH, "two"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_TOOLTIP_SHOW_TIMEOUT, "0.5"));
+    ASSERT(!config_value_is_valid(CONFIG_KEY_TOOLTIP_SHOW_TIMEOUT, "0.5s"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_BACKGROUND_COLOR, "#000000 60"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_BACKGROUND_COLOR, "#fff"));
+    ASSERT(!config_value_is_valid(CONFIG_KEY_BACKGROUND_COLOR, "black"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_PANEL_SIZE, "100% 30"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_TASK_ICON_ASB, "100 0 0"));
+    ASSERT(!config_value_is_valid(CONFIG_KEY_TASK_ICON_ASB, "100 0 0 0"));
+    ASSERT(config_value_is_valid(CONFIG_KEY_PANEL_ITEMS, "LTSBC"));
+}
@@ -0,0 +1,337 @@
+/**************************************************************************
+* config_keys :
+* - the options of the config file, shared by tint2 and tint2conf.
+*
+* Check COPYING file for Copyright
+*
+**************************************************************************/
+
+#ifndef CONFIG_KEYS_H
+#define CONFIG_KEYS_H
+
+#include <glib.h>
+
+typedef enum ConfigValueType {
+    // Any text
+    CONFIG_VALUE_STRING = 0,
+    // An integer
+    CONFIG_VALUE_INT,
+    // A decimal number
+    CONFIG_VALUE_FLOAT,
+    // A color and an optional opacity: "#rrggbb [opacity]"
+    CONFIG_VALUE_COLOR,
+    // Up to 3 integers, optionally followed by '%': "x [y [z]]"
+    CONFIG_VALUE_SIZES,
+} ConfigValueType;
+
+// Groups of related options. tint2 can reload some of them without restarting (see config_reload).
+typedef enum ConfigSection {
+    CONFIG_SECTION_SCALING = 0,
+    CONFIG_SECTION_BACKGROUNDS,
+    CONFIG_SECTION_GRADIENTS,
+    CONFIG_SECTION_PANEL,
+    CONFIG_SECTION_BATTERY,
+    CONFIG_SECTION_SEPARATOR,
+    CONFIG_SECTION_EXECUTOR,
+    CONFIG_SECTION_BUTTON,
+    CONFIG_SECTION_CLOCK,
+    CONFIG_SECTION_TASKBAR,
+    CONFIG_SECTION_TASK,
+    CONFIG_SECTION_SYSTRAY,
+    CONFIG_SECTION_LAUNCHER,
+    CONFIG_SECTION_TOOLTIP,
+    CONFIG_SECTION_MOUSE,
+    CONFIG_SECTION_AUTOHIDE,
+    NUM_CONFIG_SECTIONS
+} ConfigSection;
+
+// All the options, in the order in which they are usually written: KEY(ID, name, type, section).
+// To add an option, add it here, then handle CONFIG_KEY_<ID> in add_entry() in tint2 and tint2conf.
+#define CONFIG_KEYS(KEY) \
+    /* Scaling */ \
+    KEY(SCALE_RELATIVE_TO_DPI, "scale_relative_to_dpi", FLOAT, SCALING) \
+    KEY(SCALE_RELATIVE_TO_SCREEN_HEIGHT, "scale_relative_to_screen_height", FLOAT, SCALING) \
+    /* Backgrounds */ \
+    KEY(ROUNDED, "rounded", INT, BACKGROUNDS) \
+    KEY(BORDER_WIDTH, "border_width", INT, BACKGROUNDS) \
+    KEY(BORDER_SIDES, "border_sides", STRING, BACKGROUNDS) \
+    KEY(BACKGROUND_COLOR, "background_color", COLOR, BACKGROUNDS) \
+    KEY(BORDER_COLOR, "border_color", COLOR, BACKGROUNDS) \
+    KEY(BACKGROUND_COLOR_HOVER, "background_color_hover", STRING, BACKGROUNDS) \
+    KEY(BORDER_COLOR_HOVER, "border_color_hover", STRING, BACKGROUNDS) \
+    KEY(BACKGROUND_COLOR_PRESSED, "background_color_pressed", STRING, BACKGROUNDS) \
+    KEY(BORDER_COLOR_PRESSED, "border_color_pressed", STRING, BACKGROUNDS) \
+    KEY(GRADIENT_ID, "gradient_id", INT, BACKGROUNDS) \
+    KEY(GRADIENT_ID_HOVER, "gradient_id_hover", INT, BACKGROUNDS) \
+    KEY(GRADIENT_ID_PRESSED, "gradient_id_pressed", INT, BACKGROUNDS) \
+    KEY(BORDER_CONTENT_TINT_WEIGHT, "border_content_tint_weight", INT, BACKGROUNDS) \
+    KEY(BACKGROUND_CONTENT_TINT_WEIGHT, "background_content_tint_weight", INT, BACKGROUNDS) \
+    /* Gradients */ \
+    KEY(GRADIENT, "gradient", STRING, GRADIENTS) \
+    KEY(START_COLOR, "start_color", COLOR, GRADIENTS) \
+    KEY(END_COLOR, "end_color", COLOR, GRADIENTS) \
+    KEY(COLOR_STOP, "color_stop", STRING, GRADIENTS) \
+    /* Panel */ \
+    KEY(PANEL_SHRINK, "panel_shrink", INT, PANEL) \
+    KEY(FONT_SHADOW, "font_shadow", INT, PANEL) \
+    KEY(WM_MENU, "wm_menu", INT, PANEL) \
+    KEY(PANEL_DOCK, "panel_dock", INT, PANEL) \
+    KEY(PANEL_PIVOT_STRUTS, "panel_pivot_struts", INT, PANEL) \
+    KEY(URGENT_NB_OF_BLINK, "urgent_nb_of_blink", INT, PANEL) \
+    KEY(DISABLE_TRANSPARENCY, "disable_transparency", INT, PANEL) \
+    KEY(PANEL_LCLICK_COMMAND, "panel_lclick_command", STRING, PANEL) \
+    KEY(PANEL_MCLICK_COMMAND, "panel_mclick_command", STRING, PANEL) \
+    KEY(PANEL_RCLICK_COMMAND, "panel_rclick_command", STRING, PANEL) \
+    KEY(PANEL_UWHEEL_COMMAND, "panel_uwheel_command", STRING, PANEL) \
+    KEY(PANEL_DWHEEL_COMMAND, "panel_dwheel_command", STRING, PANEL) \
+    KEY(PANEL_MONITOR, "panel_monitor", STRING, PANEL) \
+    KEY(PANEL_SIZE, "panel_size", SIZES, PANEL) \
+    KEY(PANEL_ITEMS, "panel_items", STRING, PANEL) \
+    KEY(PANEL_MARGIN, "panel_margin", SIZES, PANEL) \
+    KEY(PANEL_PADDING, "panel_padding", SIZES, PANEL) \
+    KEY(PANEL_POSITION, "panel_position", STRING, PANEL) \
+    KEY(PANEL_BACKGROUND_ID, "panel_background_id", INT, PANEL) \
+    KEY(PANEL_LAYER, "panel_layer", STRING, PANEL) \
+    KEY(PANEL_WINDOW_NAME, "panel_window_name", STRING, PANEL) \
+    /* Battery */ \
+    KEY(BATTERY_LOW_STATUS, "battery_low_status", INT, BATTERY) \
+    KEY(BATTERY_LCLICK_COMMAND, "battery_lclick_command", STRING, BATTERY) \
+    KEY(BATTERY_MCLICK_COMMAND, "battery_mclick_command", STRING, BATTERY) \
+    KEY(BATTERY_RCLICK_COMMAND, "battery_rclick_command", STRING, BATTERY) \
+    KEY(BATTERY_UWHEEL_COMMAND, "battery_uwheel_command", STRING, BATTERY) \
+    KEY(BATTERY_DWHEEL_COMMAND, "battery_dwheel_command", STRING, BATTERY) \
+    KEY(BATTERY_LOW_CMD, "battery_low_cmd", STRING, BATTERY) \
+    KEY(BATTERY_FULL_CMD, "battery_full_cmd", STRING, BATTERY) \
+    KEY(AC_CONNECTED_CMD, "ac_connected_cmd", STRING, BATTERY) \
+    KEY(AC_DISCONNECTED_CMD, "ac_disconnected_cmd", STRING, BATTERY) \
+    KEY(BAT1_FONT, "bat1_font", STRING, BATTERY) \
+    KEY(BAT2_FONT, "bat2_font", STRING, BATTERY) \
+    KEY(BAT1_FORMAT, "bat1_format", STRING, BATTERY) \
+    KEY(BAT2_FORMAT, "bat2_format", STRING, BATTERY) \
+    KEY(BATTERY_FONT_COLOR, "battery_font_color", COLOR, BATTERY) \
+    KEY(BATTERY_PADDING, "battery_padding", SIZES, BATTERY) \
+    KEY(BATTERY_BACKGROUND_ID, "battery_background_id", INT, BATTERY) \
+    KEY(BATTERY_HIDE, "battery_hide", INT, BATTERY) \
+    KEY(BATTERY_TOOLTIP, "battery_tooltip", INT, BATTERY) \
+    /* Separator */ \
+    KEY(SEPARATOR_SIZE, "separator_size", INT, SEPARATOR) \
+    KEY(SEPARATOR, "separator", STRING, SEPARATOR) \
+    KEY(SEPARATOR_BACKGROUND_ID, "separator_background_id", INT, SEPARATOR) \
+    KEY(SEPARATOR_COLOR, "separator_color", COLOR, SEPARATOR) \
+    KEY(SEPARATOR_STYLE, "separator_style", STRING, SEPARATOR) \
+    KEY(SEPARATOR_PADDING, "separator_padding", SIZES, SEPARATOR) \
+    /* Executor */ \
+    KEY(EXECP_ISOLATE, "execp_isolate", INT, EXECUTOR) \
+    KEY(EXECP_HAS_ICON, "execp_has_icon", INT, EXECUTOR) \
+    KEY(EXECP_CONTINUOUS, "execp_continuous", INT, EXECUTOR) \
+    KEY(EXECP_MAX_BUFFER_SIZE, "execp_max_buffer_size", INT, EXECUTOR) \
+    KEY(EXECP_MARKUP, "execp_markup", INT, EXECUTOR) \
+    KEY(EXECP_CACHE_ICON, "execp_cache_icon", INT, EXECUTOR) \
+    KEY(EXECP_CENTERED, "execp_centered", INT, EXECUTOR) \
+    KEY(EXECP_COMMAND, "execp_command", STRING, EXECUTOR) \
+    KEY(EXECP_LCLICK_COMMAND, "execp_lclick_command", STRING, EXECUTOR) \
+    KEY(EXECP_MCLICK_COMMAND, "execp_mclick_command", STRING, EXECUTOR) \
+    KEY(EXECP_RCLICK_COMMAND, "execp_rclick_command", STRING, EXECUTOR) \
+    KEY(EXECP_UWHEEL_COMMAND, "execp_uwheel_command", STRING, EXECUTOR) \
+    KEY(EXECP_DWHEEL_COMMAND, "execp_dwheel_command", STRING, EXECUTOR) \
+    KEY(EXECP_TOOLTIP, "execp_tooltip", STRING, EXECUTOR) \
+    KEY(EXECP, "execp", STRING, EXECUTOR) \
+    KEY(EXECP_NAME, "execp_name", STRING, EXECUTOR) \
+    KEY(EXECP_INTERVAL, "execp_interval", INT, EXECUTOR) \
+    KEY(EXECP_MONITOR, "execp_monitor", STRING, EXECUTOR) \
+    KEY(EXECP_FONT, "execp_font", STRING, EXECUTOR) \
+    KEY(EXECP_FONT_COLOR, "execp_font_color", COLOR, EXECUTOR) \
+    KEY(EXECP_PADDING, "execp_padding", SIZES, EXECUTOR) \
+    KEY(EXECP_BACKGROUND_ID, "execp_background_id", INT, EXECUTOR) \
+    KEY(EXECP_ICON_W, "execp_icon_w", INT, EXECUTOR) \
+    KEY(EXECP_ICON_H, "execp_icon_h", INT, EXECUTOR) \
+    /* Button */ \
+    KEY(BUTTON_TEXT, "button_text", STRING, BUTTON) \
+    KEY(BUTTON_TOOLTIP, "button_tooltip", STRING, BUTTON) \
+    KEY(BUTTON_LCLICK_COMMAND, "button_lclick_command", STRING, BUTTON) \
+    KEY(BUTTON_MCLICK_COMMAND, "button_mclick_command", STRING, BUTTON) \
+    KEY(BUTTON_RCLICK_COMMAND, "button_rclick_command", STRING, BUTTON) \
+    KEY(BUTTON_UWHEEL_COMMAND, "button_uwheel_command", STRING, BUTTON) \
+    KEY(BUTTON_DWHEEL_COMMAND, "button_dwheel_command", STRING, BUTTON) \
+    KEY(BUTTON, "button", STRING, BUTTON) \
+    KEY(BUTTON_ICON, "button_icon", STRING, BUTTON) \
+    KEY(BUTTON_FONT, "button_font", STRING, BUTTON) \
+    KEY(BUTTON_FONT_COLOR, "button_font_color", COLOR, BUTTON) \
+    KEY(BUTTON_PADDING, "button_padding", SIZES, BUTTON) \
+    KEY(BUTTON_MAX_ICON_SIZE, "button_max_icon_size", INT, BUTTON) \
+    KEY(BUTTON_BACKGROUND_ID, "button_background_id", INT, BUTTON) \
+    KEY(BUTTON_CENTERED, "button_centered", INT, BUTTON) \
+    /* Clock */ \
+    KEY(TIME2_FORMAT, "time2_format", STRING, CLOCK) \
+    KEY(TIME1_TIMEZONE, "time1_timezone", STRING, CLOCK) \
+    KEY(TIME2_TIMEZONE, "time2_timezone", STRING, CLOCK) \
+    KEY(CLOCK_TOOLTIP, "clock_tooltip", STRING, CLOCK) \
+    KEY(CLOCK_TOOLTIP_TIMEZONE, "clock_tooltip_timezone", STRING, CLOCK) \
+    KEY(CLOCK_LCLICK_COMMAND, "clock_lclick_command", STRING, CLOCK) \
+    KEY(CLOCK_RCLICK_COMMAND, "clock_rclick_command", STRING, CLOCK) \
+    KEY(CLOCK_MCLICK_COMMAND, "clock_mclick_command", STRING, CLOCK) \
+    KEY(CLOCK_UWHEEL_COMMAND, "clock_uwheel_command", STRING, CLOCK) \
+    KEY(CLOCK_DWHEEL_COMMAND, "clock_dwheel_command", STRING, CLOCK) \
+    KEY(TIME1_FORMAT, "time1_format", STRING, CLOCK) \
+    KEY(TIME1_FONT, "time1_font", STRING, CLOCK) \
+    KEY(TIME2_FONT, "time2_font", STRING, CLOCK) \
+    KEY(CLOCK_FONT_COLOR, "clock_font_color", COLOR, CLOCK) \
+    KEY(CLOCK_PADDING, "clock_padding", SIZES, CLOCK) \
+    KEY(CLOCK_BACKGROUND_ID, "clock_background_id", INT, CLOCK) \
+    /* Taskbar */ \
+    KEY(TASKBAR_NAME, "taskbar_name", INT, TASKBAR) \
+    KEY(TASKBAR_HIDE_INACTIVE_TASKS, "taskbar_hide_inactive_tasks", INT, TASKBAR) \
+    KEY(TASKBAR_HIDE_DIFFERENT_MONITOR, "taskbar_hide_different_monitor", INT, TASKBAR) \
+    KEY(TASKBAR_HIDE_DIFFERENT_DESKTOP, "taskbar_hide_different_desktop", INT, TASKBAR) \
+    KEY(TASKBAR_HIDE_IF_EMPTY, "taskbar_hide_if_empty", INT, TASKBAR) \
+    KEY(TASKBAR_ALWAYS_SHOW_ALL_DESKTOP_TASKS, "taskbar_always_show_all_desktop_tasks", INT, TASKBAR) \
+    KEY(TASKBAR_MODE, "taskbar_mode", STRING, TASKBAR) \
+    KEY(TASKBAR_DISTRIBUTE_SIZE, "taskbar_distribute_size", INT, TASKBAR) \
+    KEY(TASKBAR_PADDING, "taskbar_padding", SIZES, TASKBAR) \
+    KEY(TASKBAR_BACKGROUND_ID, "taskbar_background_id", INT, TASKBAR) \
+    KEY(TASKBAR_ACTIVE_BACKGROUND_ID, "taskbar_active_background_id", INT, TASKBAR) \
+    KEY(TASKBAR_NAME_PADDING, "taskbar_name_padding", SIZES, TASKBAR) \
+    KEY(TASKBAR_NAME_BACKGROUND_ID, "taskbar_name_background_id", INT, TASKBAR) \
+    KEY(TASKBAR_NAME_ACTIVE_BACKGROUND_ID, "taskbar_name_active_background_id", INT, TASKBAR) \
+    KEY(TASKBAR_NAME_FONT, "taskbar_name_font", STRING, TASKBAR) \
+    KEY(TASKBAR_NAME_FONT_COLOR, "taskbar_name_font_color", COLOR, TASKBAR) \
+    KEY(TASKBAR_NAME_ACTIVE_FONT_COLOR, "taskbar_name_active_font_color", COLOR, TASKBAR) \
+    KEY(TASKBAR_SORT_ORDER, "taskbar_sort_order", STRING, TASKBAR) \
+    KEY(TASK_ALIGN, "task_align", STRING, TASKBAR) \
+    /* Task */ \
+    KEY(TASK_TEXT, "task_text", INT, TASK) \
+    KEY(TASK_ICON, "task_icon", INT, TASK) \
+    KEY(TASK_CENTERED, "task_centered", INT, TASK) \
+    KEY(TASK_TOOLTIP, "task_tooltip", INT, TASK) \
+    KEY(TASK_THUMBNAIL, "task_thumbnail", INT, TASK) \
+    KEY(TASK_THUMBNAIL_SIZE, "task_thumbnail_size", INT, TASK) \
+    KEY(TASK_THUMBNAIL_CACHE_SIZE, "task_thumbnail_cache_size", INT, TASK) \
+    KEY(TASK_WIDTH, "task_width", INT, TASK) \
+    KEY(TASK_MAXIMUM_SIZE, "task_maximum_size", SIZES, TASK) \
+    KEY(TASK_PADDING, "task_padding", SIZES, TASK) \
+    KEY(TASK_FONT, "task_font", STRING, TASK) \
+    KEY(TASK_FONT_COLOR, "task_font_color", COLOR, TASK) \
+    KEY(TASK_NORMAL_FONT_COLOR, "task_normal_font_color", COLOR, TASK) \
+    KEY(TASK_ACTIVE_FONT_COLOR, "task_active_font_color", COLOR, TASK) \
+    KEY(TASK_ICONIFIED_FONT_COLOR, "task_iconified_font_color", COLOR, TASK) \
+    KEY(TASK_URGENT_FONT_COLOR, "task_urgent_font_color", COLOR, TASK) \
+    KEY(TASK_ICON_ASB, "task_icon_asb", SIZES, TASK) \
+    KEY(TASK_NORMAL_ICON_ASB, "task_normal_icon_asb", SIZES, TASK) \
+    KEY(TASK_ACTIVE_ICON_ASB, "task_active_icon_asb", SIZES, TASK) \
+    KEY(TASK_ICONIFIED_ICON_ASB, "task_iconified_icon_asb", SIZES, TASK) \
+    KEY(TASK_URGENT_ICON_ASB, "task_urgent_icon_asb", SIZES, TASK) \
+    KEY(TASK_BACKGROUND_ID, "task_background_id", INT, TASK) \
+    KEY(TASK_NORMAL_BACKGROUND_ID, "task_normal_background_id", INT, TASK) \
+    KEY(TASK_ACTIVE_BACKGROUND_ID, "task_active_background_id", INT, TASK) \
+    KEY(TASK_ICONIFIED_BACKGROUND_ID, "task_iconified_background_id", INT, TASK) \
+    KEY(TASK_URGENT_BACKGROUND_ID, "task_urgent_background_id", INT, TASK) \
+    /* Systray */ \
+    KEY(SYSTRAY_ICON_SIZE, "systray_icon_size", INT, SYSTRAY) \
+    KEY(SYSTRAY_PADDING, "systray_padding", SIZES, SYSTRAY) \
+    KEY(SYSTRAY_BACKGROUND_ID, "systray_background_id", INT, SYSTRAY) \
+    KEY(SYSTRAY_SORT, "systray_sort", STRING, SYSTRAY) \
+    KEY(SYSTRAY_ICON_ASB, "systray_icon_asb", SIZES, SYSTRAY) \
+    KEY(SYSTRAY_MONITOR, "systray_monitor", STRING, SYSTRAY) \
+    KEY(SYSTRAY_NAME_FILTER, "systray_name_filter", STRING, SYSTRAY) \
+    /* Launcher */ \
+    KEY(LAUNCHER_ICON_SIZE, "launcher_icon_size", INT, LAUNCHER) \
+    KEY(LAUNCHER_ICON_THEME_OVERRIDE, "launcher_icon_theme_override", INT, LAUNCHER) \
+    KEY(LAUNCHER_TOOLTIP, "launcher_tooltip", INT, LAUNCHER) \
+    KEY(STARTUP_NOTIFICATIONS, "startup_notifications", INT, LAUNCHER) \
+    KEY(LAUNCHER_PADDING, "launcher_padding", SIZES, LAUNCHER) \
+    KEY(LAUNCHER_BACKGROUND_ID, "launcher_background_id", INT, LAUNCHER) \
+    KEY(LAUNCHER_ICON_BACKGROUND_ID, "launcher_icon_background_id", INT, LAUNCHER) \
+    KEY(LAUNCHER_ITEM_APP, "launcher_item_app", STRING, LAUNCHER) \
+    KEY(LAUNCHER_APPS_DIR, "launcher_apps_dir", STRING, LAUNCHER) \
+    KEY(LAUNCHER_ICON_THEME, "launcher_icon_theme", STRING, LAUNCHER) \
+    KEY(LAUNCHER_ICON_ASB, "launcher_icon_asb", SIZES, LAUNCHER) \
+    /* Tooltip */ \
+    KEY(TOOLTIP_SHOW_TIMEOUT, "tooltip_show_timeout", FLOAT, TOOLTIP) \
+    KEY(TOOLTIP_HIDE_TIMEOUT, "tooltip_hide_timeout", FLOAT, TOOLTIP) \
+    KEY(TOOLTIP_PADDING, "tooltip_padding", SIZES, TOOLTIP) \
+    KEY(TOOLTIP_BACKGROUND_ID, "tooltip_background_id", INT, TOOLTIP) \
+    KEY(TOOLTIP_FONT_COLOR, "tooltip_font_color", COLOR, TOOLTIP) \
+    KEY(TOOLTIP_FONT, "tooltip_font", STRING, TOOLTIP) \
+    /* Mouse */ \
+    KEY(MOUSE_LEFT, "mouse_left", STRING, MOUSE) \
+    KEY(MOUSE_MIDDLE, "mouse_middle", STRING, MOUSE) \
+    KEY(MOUSE_RIGHT, "mouse_right", STRING, MOUSE) \
+    KEY(MOUSE_SCROLL_UP, "mouse_scroll_up", STRING, MOUSE) \
+    KEY(MOUSE_SCROLL_DOWN, "mouse_scroll_down", STRING, MOUSE) \
+    KEY(MOUSE_EFFECTS, "mouse_effects", INT, MOUSE) \
+    KEY(MOUSE_HOVER_ICON_ASB, "mouse_hover_icon_asb", SIZES, MOUSE) \
+    KEY(MOUSE_PRESSED_ICON_ASB, "mouse_pressed_icon_asb", SIZES, MOUSE) \
+    /* Autohide */ \
+    KEY(AUTOHIDE, "autohide", INT, AUTOHIDE) \
+    KEY(AUTOHIDE_SHOW_TIMEOUT, "autohide_show_timeout", FLOAT, AUTOHIDE) \
+    KEY(AUTOHIDE_HIDE_TIMEOUT, "autohide_hide_timeout", FLOAT, AUTOHIDE) \
+    KEY(STRUT_POLICY, "strut_policy", STRING, AUTOHIDE) \
+    KEY(AUTOHIDE_HEIGHT, "autohide_height", INT, AUTOHIDE) \
+    /* Deprecated */ \
+    KEY(SYSTRAY, "systray", INT, SYSTRAY) \
+    KEY(BATTERY, "battery", INT, BATTERY) \
+    KEY(PRIMARY_MONITOR_FIRST, "primary_monitor_first", STRING, PANEL)
+
+// Other names accepted for some options: ALIAS(ID, name)
+#define CONFIG_KEY_ALIASES(ALIAS) \
+    ALIAS(GRADIENT_ID_HOVER, "hover_gradient_id") \
+    ALIAS(GRADIENT_ID_PRESSED, "pressed_gradient_id") \
+    ALIAS(BATTERY_LOW_CMD, "battery_low_command") \
+    ALIAS(BATTERY_FULL_CMD, "battery_full_command") \
+    ALIAS(TASK_TOOLTIP, "tooltip")
+
+// The state of the tasks configured by the per-state task options
+typedef enum ConfigKeyState {
+    // Not a per-state option, or the option without a state suffix (e.g. task_font_color)
+    CONFIG_STATE_NONE = 0,
+    CONFIG_STATE_NORMAL,
+    CONFIG_STATE_ACTIVE,
+    CONFIG_STATE_ICONIFIED,
+    CONFIG_STATE_URGENT,
+} ConfigKeyState;
+
+// The state suffix of the per-state task options: STATE(ID, state)
+#define CONFIG_KEY_STATES(STATE) \
+    STATE(TASK_NORMAL_FONT_COLOR, NORMAL) \
+    STATE(TASK_ACTIVE_FONT_COLOR, ACTIVE) \
+    STATE(TASK_ICONIFIED_FONT_COLOR, ICONIFIED) \
+    STATE(TASK_URGENT_FONT_COLOR, URGENT) \
+    STATE(TASK_NORMAL_ICON_ASB, NORMAL) \
+    STATE(TASK_ACTIVE_ICON_ASB, ACTIVE) \
+    STATE(TASK_ICONIFIED_ICON_ASB, ICONIFIED) \
+    STATE(TASK_URGENT_ICON_ASB, URGENT) \
+    STATE(TASK_NORMAL_BACKGROUND_ID, NORMAL) \
+    STATE(TASK_ACTIVE_BACKGROUND_ID, ACTIVE) \
+    STATE(TASK_ICONIFIED_BACKGROUND_ID, ICONIFIED) \
+    STATE(TASK_URGENT_BACKGROUND_ID, URGENT)
+
+typedef enum ConfigKeyId {
+    CONFIG_KEY_UNKNOWN = 0,
+#define CONFIG_KEY_ENUM(id, name, type, section) CONFIG_KEY_##id,
+    CONFIG_KEYS(CONFIG_KEY_ENUM)
+#undef CONFIG_KEY_ENUM
+    NUM_CONFIG_KEYS
+} ConfigKeyId;
+
+typedef struct ConfigKey {
+    const char *name;
+    ConfigValueType type;
+    ConfigSection section;
+} ConfigKey;
+
+// Indexed by ConfigKeyId
+extern const ConfigKey config_keys[NUM_CONFIG_KEYS];
+
+// Returns the option named name (or one of its aliases), or CONFIG_KEY_UNKNOWN.
+ConfigKeyId config_key_lookup(const char *name);
+
+// Returns the state suffix of the option (see CONFIG_KEY_STATES).
+ConfigKeyState config_key_state(ConfigKeyId id);
+
+// The name of the option, e.g. CONFIG_KEY_NAME(PANEL_ITEMS) is "panel_items"
+#define CONFIG_KEY_NAME(id) (config_keys[CONFIG_KEY_##id].name)
+
+// Returns FALSE if value is not of the type of the option (empty values are always valid).
+gboolean config_value_is_valid(ConfigKeyId id, const char *value);
+
+#endif
@@ -17,6 +17,8 @@
 #include "panel.h"
 #include "timer.h"
 #include "common.h"
+#include "icon-loader.h"
+#include "test.h"
 
 #define MAX_TOOLTIP_LEN 4096
 
@@ -50,6 +52,7 @@ Execp* create_execp()
     execp->backend->buf_stdout = calloc(execp->backend->buf_stdout_capacity, 1);
     execp->backend->buf_stderr_capacity = 1024;
     execp->backend->buf_stderr = calloc(execp->backend->buf_stderr_capacity, 1);
+    execp->backend->max_buffer_size = EXECP_DEFAULT_MAX_BUFFER_SIZE;
     execp->backend->text = strdup("");
     execp->backend->icon_path = NULL;
     return execp;
@@ -99,6 +102,7 @@ void destroy_execp(void *obj)
     } else {
         // This is a backend element
         destroy_timer(&execp->backend->timer);
+        icon_loader_cancel(execp->backend);
 
         free_icon(execp->backend->icon);
         free_and_null(execp->backend->buf_stdout);
@@ -165,6 +169,7 @@ void execp_pre_init()
             monitor_execp->backend->bg = backend->bg;
             monitor_execp->backend->centered = backend->centered;
             monitor_execp->backend->continuous = backend->continuous;
+            monitor_execp->backend->max_buffer_size = backend->max_buffer_size;
             monitor_execp->backend->font_color = backend->font_color;
             monitor_execp->backend->font_desc = backend->font_desc;
             monitor_execp->backend->has_font = backend->has_font;
@@ -312,6 +317,24 @@ void execp_default_font_changed()
     schedule_panel_redraw();
 }
 
+void cleanup_execp_panel(void *p)
+{
+    Panel *panel = (Panel *)p;
+    g_list_free_full(panel->execp_list, destroy_execp);
+    panel->execp_list = NULL;
+
+    // The timers of the backends may point to the destroyed frontends
+    for (GList *l = panel_config.execp_list; l; l = l->next) {
+        Execp *execp = (Execp *)l->data;
+        if (execp->backend->child_pipe_stdout >= 0)
+            continue;
+        if (execp->backend->instances)
+            execp_force_update((Execp *)execp->backend->instances->data);
+        else
+            stop_timer(&execp->backend->timer);
+    }
+}
+
 void cleanup_execp()
 {
     // Cleanup frontends
@@ -325,50 +348,66 @@ void cleanup_execp()
     panel_config.execp_list = NULL;
 }
 
+// Takes ownership of icon
+static void execp_set_icon(ExecpBackend *backend, Imlib_Image icon)
+{
+    free_icon(backend->icon);
+    backend->icon = icon;
+    if (!icon)
+        return;
+    imlib_context_set_image(icon);
+    int w = imlib_image_get_width();
+    int h = imlib_image_get_height();
+    if (w && h) {
+        if (backend->icon_w) {
+            if (!backend->icon_h) {
+                h = (int)(0.5 + h * backend->icon_w / (float)(w));
+                w = backend->icon_w;
+            } else {
+                w = backend->icon_w;
+                h = backend->icon_h;
+            }
+        } else {
+            if (backend->icon_h) {
+                w = (int)(0.5 + w * backend->icon_h / (float)(h));
+                h = backend->icon_h;
+            }
+        }
+        if (w < 1)
+            w = 1;
+        if (h < 1)
+            h = 1;
+    }
+    if (w != imlib_image_get_width() || h != imlib_image_get_height()) {
+        Imlib_Image icon_scaled =
+            imlib_create_cropped_scaled_image(0, 0, imlib_image_get_width(), imlib_image_get_height(), w, h);
+        imlib_context_set_image(backend->icon);
+        imlib_free_image();
+        backend->icon = icon_scaled;
+    }
+}
+
+static void execp_icon_loaded(void *owner, Imlib_Image image, const char *path)
+{
+    ExecpBackend *backend = (ExecpBackend *)owner;
+    execp_set_icon(backend, image);
+    for (GList *l = backend->instances; l; l = l->next)
+        execp_update_post_read((Execp *)l->data);
+}
+
 // Called from backend functions.
+// The icon is loaded asynchronously when possible; until then, the previous icon (if any) is kept.
 gboolean reload_icon(Execp *execp)
 {
-    char *icon_path = execp->backend->icon_path;
+    ExecpBackend *backend = execp->backend;
 
-    if (execp->backend->has_icon && icon_path) {
-        if (execp->backend->icon) {
-            imlib_context_set_image(execp->backend->icon);
-            imlib_free_image();
-        }
-        execp->backend->icon = load_image(icon_path, execp->backend->cache_icon);
-        if (execp->backend->icon) {
-            imlib_context_set_image(execp->backend->icon);
-            int w = imlib_image_get_width();
-            int h = imlib_image_get_height();
-            if (w && h) {
-                if (execp->backend->icon_w) {
-                    if (!execp->backend->icon_h) {
-                        h = (int)(0.5 + h * execp->backend->icon_w / (float)(w));
-                        w = execp->backend->icon_w;
-                    } else {
-                        w = execp->backend->icon_w;
-                        h = execp->backend->icon_h;
-                    }
-                } else {
-                    if (execp->backend->icon_h) {
-                        w = (int)(0.5 + w * execp->backend->icon_h / (float)(h));
-                        h = execp->backend->icon_h;
-                    }
-                }
-                if (w < 1)
-                    w = 1;
-                if (h < 1)
-                    h = 1;
-            }
-            if (w != imlib_image_get_width() || h != imlib_image_get_height()) {
-                Imlib_Image icon_scaled =
-                    imlib_create_cropped_scaled_image(0, 0, imlib_image_get_width(), imlib_image_get_height(), w, h);
-                imlib_context_set_image(execp->backend->icon);
-                imlib_free_image();
-                execp->backend->icon = icon_scaled;
-            }
-            return TRUE;
+    if (backend->has_icon && backend->icon_path) {
+        if (backend->icon_outdated) {
+            backend->icon_outdated = FALSE;
+            if (!icon_loader_request(backend, NULL, NULL, backend->icon_path, 0, NULL, execp_icon_loaded))
+                execp_set_icon(backend, load_image(backend->icon_path, backend->cache_icon));
         }
+        return backend->icon != NULL;
     }
     return FALSE;
 }
@@ -774,27 +813,50 @@ void execp_timer_callback(void *arg)
     execp->backend->child = child;
     execp->backend->child_pipe_stdout = pipe_fd_stdout[0];
     execp->backend->child_pipe_stderr = pipe_fd_stderr[0];
+    execp->backend->stdout_eof = FALSE;
+    execp->backend->stderr_eof = FALSE;
     execp->backend->buf_stdout_length = 0;
     execp->backend->buf_stdout[execp->backend->buf_stdout_length] = '\0';
     execp->backend->buf_stderr_length = 0;
     execp->backend->buf_stderr[execp->backend->buf_stderr_length] = '\0';
+    execp->backend->buf_stdout_scanned = 0;
+    execp->backend->buf_stdout_lines = 0;
+    execp->backend->buf_stdout_truncated = FALSE;
     execp->backend->last_update_start_time = time(NULL);
 }
 
-void read_from_pipe(int fd, char **buffer, ssize_t *buffer_length, ssize_t *buffer_capacity, gboolean *eof)
+// Reads the data available in the pipe. The buffer grows up to max_size bytes, including the terminating null byte.
+// Stops when no more data is available, at the end of the pipe, or when the buffer is full (then sets *full).
+// Counts the read() calls in num_reads. Returns the number of bytes read.
+ssize_t read_from_pipe(int fd,
+                       char **buffer,
+                       ssize_t *buffer_length,
+                       ssize_t *buffer_capacity,
+                       ssize_t max_size,
+                       gboolean *eof,
+                       gboolean *full,
+                       guint64 *num_reads)
 {
+    ssize_t total = 0;
     *eof = FALSE;
+    *full = FALSE;
     while (1) {
         // Make sure there is free space in the buffer
-        if (*buffer_capacity - *buffer_length < 1024) {
-            *buffer_capacity *= 2;
+        if (*buffer_capacity - *buffer_length < 1024 && *buffer_capacity < max_size) {
+            *buffer_capacity = MIN(*buffer_capacity * 2, max_size);
             *buffer = (char *)realloc(*buffer, *buffer_capacity);
         }
+        if (*buffer_capacity - *buffer_length <= 1) {
+            *full = TRUE;
+            break;
+        }
         ssize_t count = read(fd,
                              *buffer + *buffer_length,
                              *buffer_capacity - *buffer_length - 1);
+        (*num_reads)++;
         if (count > 0) {
             // Successful read
+            total += count;
             *buffer_length += count;
             (*buffer)[*buffer_length] = '\0';
             continue;
@@ -815,6 +877,89 @@ void read_from_pipe(int fd, char **buffer, ssize_t *buffer_length, ssize_t *buff
         }
         break;
     }
+    return total;
+}
+
+// Reads and drops the data available in the pipe. Returns the number of bytes read.
+static ssize_t discard_from_pipe(int fd, gboolean *eof, guint64 *num_reads)
+{
+    char buffer[4096];
+    ssize_t total = 0;
+    *eof = FALSE;
+    while (1) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        (*num_reads)++;
+        if (count > 0) {
+            total += count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else {
+            *eof = count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+            break;
+        }
+    }
+    return total;
+}
+
+static void report_execp_overflow(ExecpBackend *backend)
+{
+    if (backend->overflow_reported)
+        return;
+    backend->overflow_reported = TRUE;
+    fprintf(stderr,
+            YELLOW "tint2: executor '%s': output larger than execp_max_buffer_size (%zd bytes), dropping it" RESET
+                   "\n",
+            backend->command,
+            backend->max_buffer_size);
+}
+
+// Continuous mode: splits the new output in buf_stdout into records of execp_continuous lines.
+// Only the bytes that have not been scanned yet are searched for line ends. Complete records are removed from the
+// buffer; returns the latest one without its final line end (free it with free()), or NULL if none was completed.
+// Older records completed at the same time are counted as dropped.
+// full must be TRUE if the buffer is full: if it holds no complete record, the partial record is dropped.
+static char *frame_continuous_output(ExecpBackend *backend, gboolean full)
+{
+    char *buf = backend->buf_stdout;
+    ssize_t record_start = 0;
+    ssize_t latest_start = -1;
+    ssize_t latest_end = -1;
+    for (ssize_t i = backend->buf_stdout_scanned; i < backend->buf_stdout_length; i++) {
+        if (buf[i] != '\n')
+            continue;
+        backend->buf_stdout_lines++;
+        if (backend->buf_stdout_lines < backend->continuous)
+            continue;
+        if (backend->buf_stdout_truncated) {
+            // The end of a record whose beginning has been dropped
+            backend->buf_stdout_truncated = FALSE;
+            backend->num_dropped_records++;
+        } else {
+            if (latest_start >= 0)
+                backend->num_dropped_records++;
+            latest_start = record_start;
+            latest_end = i;
+        }
+        backend->buf_stdout_lines = 0;
+        record_start = i + 1;
+    }
+
+    char *record = latest_start >= 0 ? strndup(buf + latest_start, (size_t)(latest_end - latest_start)) : NULL;
+
+    // Keep only the beginning of the next record
+    ssize_t remaining = backend->buf_stdout_length - record_start;
+    if (record_start > 0 && remaining > 0)
+        memmove(buf, buf + record_start, (size_t)remaining);
+    backend->buf_stdout_length = remaining;
+    if (full && record_start == 0) {
+        // The line ends are still counted, so that the end of the record is recognized
+        report_execp_overflow(backend);
+        backend->buf_stdout_truncated = TRUE;
+        backend->buf_stdout_length = 0;
+    }
+    buf[backend->buf_stdout_length] = '\0';
+    backend->buf_stdout_scanned = backend->buf_stdout_length;
+    return record;
 }
 
 gboolean starts_with(char *s, char *prefix)
@@ -850,35 +995,81 @@ void rstrip(char *s)
     }
 }
 
-gboolean read_execp(void *obj)
+gboolean read_execp(void *obj, const fd_set *ready)
 {
     Execp *execp = (Execp *)obj;
 
     if (execp->backend->child_pipe_stdout < 0)
         return FALSE;
 
-    gboolean stdout_eof, stderr_eof;
-    read_from_pipe(execp->backend->child_pipe_stdout,
-                   &execp->backend->buf_stdout,
-                   &execp->backend->buf_stdout_length,
-                   &execp->backend->buf_stdout_capacity,
-                   &stdout_eof);
-    read_from_pipe(execp->backend->child_pipe_stderr,
-                   &execp->backend->buf_stderr,
-                   &execp->backend->buf_stderr_length,
-                   &execp->backend->buf_stderr_capacity,
-                   &stderr_eof);
+    // Continuous mode: the latest complete record
+    char *record = NULL;
+    guint64 old_dropped_records = execp->backend->num_dropped_records;
+    gboolean full;
+    if (!execp->backend->stdout_eof && (!ready || FD_ISSET(execp->backend->child_pipe_stdout, ready))) {
+        do {
+            execp->backend->num_bytes_read += read_from_pipe(execp->backend->child_pipe_stdout,
+                                                             &execp->backend->buf_stdout,
+                                                             &execp->backend->buf_stdout_length,
+                                                             &execp->backend->buf_stdout_capacity,
+                                                             execp->backend->max_buffer_size,
+                                                             &execp->backend->stdout_eof,
+                                                             &full,
+                                                             &execp->backend->num_reads);
+            if (execp->backend->continuous > 0) {
+                char *latest = frame_continuous_output(execp->backend, full);
+                if (latest) {
+                    free(record);
+                    record = latest;
+                }
+            } else if (full) {
+                // Keep the beginning of the output
+                report_execp_overflow(execp->backend);
+                execp->backend->num_bytes_read += discard_from_pipe(execp->backend->child_pipe_stdout,
+                                                                    &execp->backend->stdout_eof,
+                                                                    &execp->backend->num_reads);
+                full = FALSE;
+            }
+        } while (full && !execp->backend->stdout_eof);
+    }
+    if (!execp->backend->stderr_eof && (!ready || FD_ISSET(execp->backend->child_pipe_stderr, ready))) {
+        execp->backend->num_bytes_read += read_from_pipe(execp->backend->child_pipe_stderr,
+                                                         &execp->backend->buf_stderr,
+                                                         &execp->backend->buf_stderr_length,
+                                                         &execp->backend->buf_stderr_capacity,
+                                                         execp->backend->max_buffer_size,
+                                                         &execp->backend->stderr_eof,
+                                                         &full,
+                                                         &execp->backend->num_reads);
+        if (full) {
+            execp->backend->num_bytes_read += discard_from_pipe(execp->backend->child_pipe_stderr,
+                                                                &execp->backend->stderr_eof,
+                                                                &execp->backend->num_reads);
+        }
+    }
 
-    gboolean command_finished = stdout_eof && stderr_eof;
+    gboolean command_finished = execp->backend->stdout_eof && execp->backend->stderr_eof;
 
     if (command_finished) {
+        if (debug_executors)
+            fprintf(stderr,
+                    "tint2: executor '%s' finished, %llu reads and %llu bytes so far\n",
+                    execp->backend->command,
+                    (unsigned long long)execp->backend->num_reads,
+                    (unsigned long long)execp->backend->num_bytes_read);
         execp->backend->child = 0;
         close(execp->backend->child_pipe_stdout);
         execp->backend->child_pipe_stdout = -1;
         close(execp->backend->child_pipe_stderr);
         execp->backend->child_pipe_stderr = -1;
-        if (execp->backend->interval)
-            change_timer(&execp->backend->timer, true, execp->backend->interval * 1000, 0, execp_timer_callback, execp);
+        // execp is the backend element: the command is run for a frontend, which has the panel (see EXECP_MONITOR)
+        if (execp->backend->interval && execp->backend->instances)
+            change_timer(&execp->backend->timer,
+                         true,
+                         execp->backend->interval * 1000,
+                         0,
+                         execp_timer_callback,
+                         execp->backend->instances->data);
     }
 
     char *ansi_clear_screen = (char*)"\x1b[2J";
@@ -898,6 +1089,7 @@ gboolean read_execp(void *obj)
                 execp->backend->text = strdup("");
             }
             execp->backend->icon_path = strdup(execp->backend->buf_stdout);
+            execp->backend->icon_outdated = TRUE;
         }
         int len = strlen(execp->backend->text);
         if (len > 0 && execp->backend->text[len - 1] == '\n')
@@ -947,25 +1139,18 @@ gboolean read_execp(void *obj)
             execp->backend->buf_stderr[execp->backend->buf_stderr_length] = '\0';
         }
         // Handle stdout
-        // Count lines in buffer
-        int num_lines = 0;
-        char *end = NULL;
-        for (char *c = execp->backend->buf_stdout; *c; c++) {
-            if (*c == '\n') {
-                num_lines++;
-                if (num_lines == execp->backend->continuous)
-                    end = c;
-            }
-        }
-        if (num_lines >= execp->backend->continuous) {
-            if (end)
-                *end = '\0';
+        if (debug_executors && execp->backend->num_dropped_records != old_dropped_records)
+            fprintf(stderr,
+                    "tint2: executor '%s': %llu records dropped so far\n",
+                    execp->backend->command,
+                    (unsigned long long)execp->backend->num_dropped_records);
+        if (record) {
             free_and_null(execp->backend->text);
             free_and_null(execp->backend->icon_path);
             if (!execp->backend->has_icon) {
-                execp->backend->text = strdup(execp->backend->buf_stdout);
+                execp->backend->text = record;
             } else {
-                char *text = strchr(execp->backend->buf_stdout, '\n');
+                char *text = strchr(record, '\n');
                 if (text) {
                     *text = '\0';
                     text++;
@@ -973,26 +1158,14 @@ gboolean read_execp(void *obj)
                 } else {
                     execp->backend->text = strdup("");
                 }
-                execp->backend->icon_path = expand_tilde(execp->backend->buf_stdout);
+                execp->backend->icon_path = expand_tilde(record);
+                execp->backend->icon_outdated = TRUE;
+                free(record);
             }
             size_t len = strlen(execp->backend->text);
             if (len > 0 && execp->backend->text[len - 1] == '\n')
                 execp->backend->text[len - 1] = '\0';
 
-            if (end) {
-                char *next = end + 1;
-                ssize_t copied = next - execp->backend->buf_stdout;
-                ssize_t remaining = execp->backend->buf_stdout_length - copied;
-                if (remaining > 0) {
-                    memmove(execp->backend->buf_stdout, next, (size_t)remaining);
-                    execp->backend->buf_stdout_length = remaining;
-                    execp->backend->buf_stdout[execp->backend->buf_stdout_length] = '\0';
-                } else {
-                    execp->backend->buf_stdout_length = 0;
-                    execp->backend->buf_stdout[execp->backend->buf_stdout_length] = '\0';
-                }
-            }
-
             execp->backend->last_update_finish_time = time(NULL);
             execp->backend->last_update_duration =
                 execp->backend->last_update_finish_time - execp->backend->last_update_start_time;
@@ -1108,19 +1281,78 @@ void execp_update_post_read(Execp *execp)
     }
 }
 
-void handle_execp_events()
+void execp_prepare_fd_set(fd_set *set, int *max_fd)
 {
-    for (int i = 0; i < num_panels; i++) {
-        Panel panel = panels[i];
-        for (GList *l = panel.execp_list; l; l = l->next) {
-            Execp *execp = (Execp *)l->data;
-            if (read_execp(execp)) {
-                GList *l_instance;
-                for (l_instance = execp->backend->instances; l_instance; l_instance = l_instance->next) {
-                    Execp *instance = (Execp *)l_instance->data;
-                    execp_update_post_read(instance);
-                }
+    for (GList *l = panel_config.execp_list; l; l = l->next) {
+        Execp *execp = (Execp *)l->data;
+        if (execp->backend->child_pipe_stdout < 0)
+            continue;
+        // A pipe at its end would always be readable
+        if (!execp->backend->stdout_eof) {
+            FD_SET(execp->backend->child_pipe_stdout, set);
+            *max_fd = MAX(*max_fd, execp->backend->child_pipe_stdout);
+        }
+        if (!execp->backend->stderr_eof) {
+            FD_SET(execp->backend->child_pipe_stderr, set);
+            *max_fd = MAX(*max_fd, execp->backend->child_pipe_stderr);
+        }
+    }
+}
+
+void handle_execp_events(const fd_set *ready)
+{
+    // The backends own the pipes, the frontends of all the panels are updated from them
+    for (GList *l = panel_config.execp_list; l; l = l->next) {
+        Execp *execp = (Execp *)l->data;
+        if (execp->backend->child_pipe_stdout < 0)
+            continue;
+        if (!FD_ISSET(execp->backend->child_pipe_stdout, ready) && !FD_ISSET(execp->backend->child_pipe_stderr, ready))
+            continue;
+        if (read_execp(execp, ready)) {
+            for (GList *l_instance = execp->backend->instances; l_instance; l_instance = l_instance->next) {
+                Execp *instance = (Execp *)l_instance->data;
+                execp_update_post_read(instance);
             }
         }
     }
 }
+
+static void append_test_output(ExecpBackend *backend, const char *s)
+{
+    strcpy(backend->buf_stdout + backend->buf_stdout_length, s);
+    backend->buf_stdout_length += strlen(s);
+}
+
+TEST(execp_frame_continuous_output)
+{
+    ExecpBackend backend;
+    memset(&backend, 0, sizeof(backend));
+    backend.command = "test";
+    backend.continuous = 2;
+    backend.buf_stdout_capacity = backend.max_buffer_size = 16;
+    backend.buf_stdout = calloc(backend.buf_stdout_capacity, 1);
+
+    append_test_output(&backend, "a\nb");
+    char *record = frame_continuous_output(&backend, FALSE);
+    ASSERT_NULL(record);
+    // Only the latest of the records completed at once is returned
+    append_test_output(&backend, "\nc\nd\ne\nf\ng");
+    record = frame_continuous_output(&backend, FALSE);
+    ASSERT_STR_EQUAL(record, "e\nf");
+    free(record);
+    ASSERT_EQUAL(backend.num_dropped_records, 2);
+    ASSERT_STR_EQUAL(backend.buf_stdout, "g");
+
+    // A record that does not fit in the buffer is dropped up to its end
+    append_test_output(&backend, "xxxxxxxxxxxxxx");
+    record = frame_continuous_output(&backend, TRUE);
+    ASSERT_NULL(record);
+    ASSERT_EQUAL(backend.buf_stdout_length, 0);
+    append_test_output(&backend, "\ny\nz\nw\n");
+    record = frame_continuous_output(&backend, FALSE);
+    ASSERT_STR_EQUAL(record, "z\nw");
+    free(record);
+    ASSERT_EQUAL(backend.num_dropped_records, 3);
+
+    free(backend.buf_stdout);
+}
@@ -1,6 +1,7 @@
 #ifndef EXECPLUGIN_H
 #define EXECPLUGIN_H
 
+#include <sys/select.h>
 #include <sys/time.h>
 #include <pango/pangocairo.h>
 
@@ -10,6 +11,10 @@
 
 extern bool debug_executors;
 
+// Default and minimum values of execp_max_buffer_size, in bytes
+#define EXECP_DEFAULT_MAX_BUFFER_SIZE (64 * 1024)
+#define EXECP_MIN_MAX_BUFFER_SIZE 1024
+
 // Architecture:
 // Panel panel_config contains an array of Execp, each storing all config options and all the state variables.
 // Only these run commands.
@@ -56,7 +61,13 @@ typedef struct ExecpBackend {
     Timer timer;
     int child_pipe_stdout;
     int child_pipe_stderr;
+    // TRUE once the end of the corresponding pipe has been reached; the pipe is then no longer watched
+    gboolean stdout_eof;
+    gboolean stderr_eof;
     pid_t child;
+    // Number of read() calls made on the pipes of the command, and number of bytes read, since tint2 started
+    guint64 num_reads;
+    guint64 num_bytes_read;
 
     // Command output buffer
     char *buf_stdout;
@@ -65,11 +76,26 @@ typedef struct ExecpBackend {
     char *buf_stderr;
     ssize_t buf_stderr_length;
     ssize_t buf_stderr_capacity;
+    // Maximum capacity of the output buffers (execp_max_buffer_size)
+    ssize_t max_buffer_size;
+    // Continuous mode: buf_stdout holds the beginning of the next record. Its first buf_stdout_scanned bytes have
+    // been searched for line ends, and contain buf_stdout_lines of them.
+    ssize_t buf_stdout_scanned;
+    int buf_stdout_lines;
+    // Continuous mode: TRUE if the beginning of the next record has been dropped because it did not fit in the buffer
+    gboolean buf_stdout_truncated;
+    // TRUE once the output has been reported as too large for the buffer
+    gboolean overflow_reported;
+    // Continuous mode: number of records that were not displayed, because a newer record was read at the same time,
+    // or because they were too large for the buffer
+    guint64 num_dropped_records;
 
     // Text extracted from the output buffer
     char *text;
     // Icon path extracted from the output buffer
     char *icon_path;
+    // TRUE if icon_path has been set since the icon was last loaded
+    gboolean icon_outdated;
     Imlib_Image icon;
     gchar tooltip_text[512];
 
@@ -130,6 +156,11 @@ void init_execp();
 // At this point the Area has not been added yet to the GUI tree, but it will be added right away.
 void init_execp_panel(void *panel);
 
+// Called before a panel is destroyed while the other panels are kept (e.g. when its monitor is unplugged).
+// Releases the frontends of the panel. The commands that are not running are scheduled again for another
+// frontend, since their timer may refer to one of the released ones.
+void cleanup_execp_panel(void *panel);
+
 // Called just before the panels are destroyed. Afterwards, tint2 exits or restarts and reads the config again.
 // Releases all frontends and then all the backends.
 // The frontend items are not freed by this function, only their members. The items are Areas which are freed in the
@@ -148,17 +179,21 @@ void execp_action(void *obj, int button, int x, int y, Time time);
 
 void execp_cmd_completed(Execp *obj, pid_t pid);
 
-// Called to check if new output from the command can be read.
-// No command might be running.
+// Called to read the new output of the command, from the pipes that are set in ready (or from both pipes if ready
+// is NULL). No command might be running.
 // Returns 1 if the output has been updated and a redraw is needed.
-gboolean read_execp(void *obj);
+gboolean read_execp(void *obj, const fd_set *ready);
 
 // Called for Execp front elements when the command output has changed.
 void execp_update_post_read(Execp *execp);
 
 void execp_default_font_changed();
 
-void handle_execp_events();
+// Adds the pipes of the running commands to set.
+void execp_prepare_fd_set(fd_set *set, int *max_fd);
+
+// Reads the output of the commands whose pipes are set in ready, and updates the panels.
+void handle_execp_events(const fd_set *ready);
 
 void execp_force_update(Execp *execp);
 
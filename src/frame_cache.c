@@ -0,0 +1,218 @@
+/**************************************************************************
+*
+* Tint2 : cache of the last frames rendered by the panels
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <X11/Xlib.h>
+
+#include "cache.h"
+#include "config.h"
+#include "frame_cache.h"
+#include "hash.h"
+#include "panel.h"
+#include "server.h"
+
+// The pixels are stored in the values of a Cache, after this header
+typedef struct CachedFrameHeader {
+    gint32 x;
+    gint32 y;
+    guint32 width;
+    guint32 height;
+} CachedFrameHeader;
+
+#define MAX_CACHED_FRAME_SIZE 16384
+
+typedef struct CachedFrame {
+    Window win;
+    Pixmap pixmap;
+} CachedFrame;
+
+// The frames on screen, as CachedFrame*
+static GSList *cached_frames;
+// Hash of the configuration file when it was read, which may change before the frames are saved.
+// 0 if frames are not cached.
+static guint64 config_stamp;
+
+static gchar *get_frame_cache_path()
+{
+    return g_build_filename(g_get_user_cache_dir(), "tint2", "frames.cache", NULL);
+}
+
+static guint64 get_config_stamp()
+{
+    gchar *contents;
+    gsize length;
+    if (!config_path || !g_file_get_contents(config_path, &contents, &length, NULL))
+        return 0;
+    guint64 stamp = hash64(contents, length, 0);
+    g_free(contents);
+    // 0 is not a valid stamp
+    return stamp ? stamp : 1;
+}
+
+static gchar *frame_key(int index, int monitor)
+{
+    const Monitor *m = &server.monitors[monitor];
+    return g_strdup_printf("%s\t%d\t%d\t%dx%d+%d+%d\t%d",
+                           config_path,
+                           index,
+                           server.num_monitors,
+                           m->width,
+                           m->height,
+                           m->x,
+                           m->y,
+                           DefaultDepth(server.display, server.screen));
+}
+
+// Creates a window showing the frame, above the other windows, or returns FALSE if the value is not valid.
+static gboolean show_frame(const unsigned char *value, size_t value_size)
+{
+    CachedFrameHeader header;
+    if (!value || value_size < sizeof(header))
+        return FALSE;
+    // The value is not necessarily aligned
+    memcpy(&header, value, sizeof(header));
+    size_t n_pixels = (size_t)header.width * header.height;
+    if (header.width == 0 || header.height == 0 || header.width > MAX_CACHED_FRAME_SIZE ||
+        header.height > MAX_CACHED_FRAME_SIZE || value_size != sizeof(header) + n_pixels * sizeof(DATA32))
+        return FALSE;
+
+    Imlib_Image image = imlib_create_image((int)header.width, (int)header.height);
+    if (!image)
+        return FALSE;
+    imlib_context_set_image(image);
+    imlib_image_set_has_alpha(0);
+    DATA32 *data = imlib_image_get_data();
+    memcpy(data, value + sizeof(header), n_pixels * sizeof(DATA32));
+    imlib_image_put_back_data(data);
+
+    CachedFrame *frame = calloc(1, sizeof(CachedFrame));
+    frame->pixmap = XCreatePixmap(server.display,
+                                  server.root_win,
+                                  header.width,
+                                  header.height,
+                                  DefaultDepth(server.display, server.screen));
+    imlib_context_set_drawable(frame->pixmap);
+    imlib_render_image_on_drawable(0, 0);
+    imlib_free_image();
+
+    // Not managed by the window manager: it only stands in for the panel until the panel is drawn
+    XSetWindowAttributes attr = {.override_redirect = True, .background_pixmap = frame->pixmap};
+    frame->win = XCreateWindow(server.display,
+                               server.root_win,
+                               header.x,
+                               header.y,
+                               header.width,
+                               header.height,
+                               0,
+                               CopyFromParent,
+                               InputOutput,
+                               CopyFromParent,
+                               CWOverrideRedirect | CWBackPixmap,
+                               &attr);
+    XMapRaised(server.display, frame->win);
+    cached_frames = g_slist_prepend(cached_frames, frame);
+    return TRUE;
+}
+
+void show_cached_frames()
+{
+    config_stamp = 0;
+    if (snapshot_path || getenv("TINT2_NO_FRAME_CACHE"))
+        return;
+    config_stamp = get_config_stamp();
+    if (!config_stamp)
+        return;
+
+    // The panels have not been created yet, so this mirrors init_panel
+    int monitor = panel_config.monitor;
+    if (monitor > server.num_monitors - 1)
+        monitor = 0;
+    int n = monitor >= 0 ? 1 : server.num_monitors;
+
+    // Set again with the visual of the panels in init_post_config
+    imlib_context_set_display(server.display);
+    imlib_context_set_visual(DefaultVisual(server.display, server.screen));
+    imlib_context_set_colormap(DefaultColormap(server.display, server.screen));
+
+    Cache cache;
+    memset(&cache, 0, sizeof(cache));
+    gchar *cache_path = get_frame_cache_path();
+    load_cache(&cache, cache_path);
+    g_free(cache_path);
+    for (int i = 0; i < n; i++) {
+        gchar *key = frame_key(i, monitor >= 0 ? monitor : i);
+        size_t value_size = 0;
+        const unsigned char *value = get_blob_from_cache(&cache, key, config_stamp, &value_size);
+        g_free(key);
+        show_frame(value, value_size);
+    }
+    free_cache(&cache);
+    if (cached_frames)
+        XFlush(server.display);
+}
+
+void hide_cached_frames()
+{
+    for (GSList *l = cached_frames; l; l = l->next) {
+        CachedFrame *frame = (CachedFrame *)l->data;
+        XDestroyWindow(server.display, frame->win);
+        XFreePixmap(server.display, frame->pixmap);
+    }
+    g_slist_free_full(cached_frames, free);
+    cached_frames = NULL;
+}
+
+void save_cached_frames()
+{
+    hide_cached_frames();
+    // Frames rendered for a compositor have an alpha channel that cannot be shown without the panel visual
+    if (!config_stamp || panel_autohide || server.depth != DefaultDepth(server.display, server.screen))
+        return;
+
+    Cache cache;
+    memset(&cache, 0, sizeof(cache));
+    gchar *cache_path = get_frame_cache_path();
+    load_cache(&cache, cache_path);
+    for (int i = 0; i < num_panels; i++) {
+        const Panel *panel = &panels[i];
+        if (!panel->temp_pmap || panel->is_hidden)
+            continue;
+        Imlib_Image image = get_panel_image(panel);
+        if (!image)
+            continue;
+        imlib_context_set_image(image);
+        int width = imlib_image_get_width();
+        int height = imlib_image_get_height();
+        CachedFrameHeader header = {panel->posx, panel->posy, (guint32)width, (guint32)height};
+        size_t pixels_size = (size_t)width * height * sizeof(DATA32);
+        unsigned char *value = malloc(sizeof(header) + pixels_size);
+        memcpy(value, &header, sizeof(header));
+        memcpy(value + sizeof(header), imlib_image_get_data_for_reading_only(), pixels_size);
+        imlib_free_image();
+
+        gchar *key = frame_key(i, panel->monitor);
+        add_blob_to_cache(&cache, key, value, sizeof(header) + pixels_size, config_stamp);
+        g_free(key);
+        free(value);
+    }
+    if (cache.dirty)
+        save_cache(&cache, cache_path);
+    g_free(cache_path);
+    free_cache(&cache);
+}
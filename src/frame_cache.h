@@ -0,0 +1,23 @@
+/**************************************************************************
+ * Cache of the last frames rendered by the panels
+ *
+ **************************************************************************/
+
+#ifndef FRAME_CACHE_H
+#define FRAME_CACHE_H
+
+// On exit, the last frame rendered by each panel is saved in ~/.cache/tint2/frames.cache, keyed by the
+// configuration file and the geometry of the monitor. On the next start, as soon as the configuration has been
+// read, these frames are shown where the panels will be, until the panels render their first frame.
+// Set TINT2_NO_FRAME_CACHE to disable it.
+
+// Shows the frames saved by the previous session. Called after reading the configuration.
+void show_cached_frames();
+
+// Removes the cached frames from the screen. Called once the panels have rendered their first frame.
+void hide_cached_frames();
+
+// Saves the current frame of each panel. Called on exit, before the panels are freed.
+void save_cached_frames();
+
+#endif
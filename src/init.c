@@ -10,19 +10,24 @@
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
 #include <X11/extensions/XShm.h>
+#include <pango/pangocairo.h>
 
 #include "config.h"
 #include "default_icon.h"
 #include "drag_and_drop.h"
 #include "fps_distribution.h"
+#include "frame_cache.h"
+#include "fswatch.h"
 #include "panel.h"
 #include "server.h"
 #include "signals.h"
+#include "startup.h"
 #include "test.h"
 #include "tooltip.h"
 #include "tracing.h"
 #include "uevent.h"
 #include "version.h"
+#include "window.h"
 
 void print_usage()
 {
@@ -56,6 +61,9 @@ void handle_cli_arguments(int argc, char **argv)
         } else if (strcmp(argv[i], "--test-verbose") == 0) {
             run_all_tests(true);
             exit(0);
+        } else if (strcmp(argv[i], "--benchmark") == 0) {
+            run_all_benchmarks();
+            exit(0);
         } else if (strcmp(argv[i], "--dump-image-data") == 0) {
             dump_image_data(argv[i+1], argv[i+2]);
             exit(0);
@@ -108,7 +116,11 @@ void handle_env_vars()
     debug_timers = getenv("DEBUG_TIMERS") != NULL;
     debug_executors = getenv("DEBUG_EXECUTORS") != NULL;
     debug_blink = getenv("DEBUG_BLINK") != NULL;
+    debug_startup = getenv("DEBUG_STARTUP") != NULL;
     thumb_use_shm = getenv("TINT2_THUMBNAIL_SHM") != NULL;
+    thumb_use_xrender = getenv("TINT2_THUMBNAIL_NO_XRENDER") == NULL;
+    if (getenv("TINT2_THUMBNAIL_BUDGET_MS"))
+        thumbnail_budget_ms = MAX(1, atoi(getenv("TINT2_THUMBNAIL_BUDGET_MS")));
     if (debug_fps) {
         init_fps_distribution();
         char *s = getenv("TRACING_FPS_THRESHOLD");
@@ -135,11 +147,9 @@ void detect_compositor(void *arg)
     }
 
     // No compositor, check for one
-    if (XGetSelectionOwner(server.display, server.atom._NET_WM_CM_S0) != None) {
+    if (!server_update_composite_manager()) {
         stop_timer(&detect_compositor_timer);
-        // Restart tint2
-        fprintf(stderr, "tint2: Detected compositor, restarting tint2...\n");
-        kill(getpid(), SIGUSR1);
+        emit_self_restart("compositor detected");
     }
 }
 
@@ -204,17 +214,29 @@ void init_post_config()
     execp_pre_init();
 }
 
+// Xlib error handlers are process-wide: errors on the connection of the thumbnail worker are forwarded to it
+static int x11_error(Display *d, XErrorEvent *ev)
+{
+    if (d != server.display)
+        return thumbnail_x_error_handler(d, ev);
+    return server_catch_error(d, ev);
+}
+
 void init_X11_pre_config()
 {
+    // Window thumbnails may be captured from a worker thread, on a separate connection
+    XInitThreads();
     server.display = XOpenDisplay(NULL);
     if (!server.display) {
         fprintf(stderr, "tint2: could not open display!\n");
         exit(EXIT_FAILURE);
     }
     server.x11_fd = ConnectionNumber(server.display);
-    XSetErrorHandler(server_catch_error);
+    XSetErrorHandler(x11_error);
     XSetIOErrorHandler(x11_io_error);
+    startup_mark("X connect");
     server_init_atoms();
+    startup_mark("atoms");
     server.screen = DefaultScreen(server.display);
     server.root_win = RootWindow(server.display, server.screen);
     server.desktop = get_current_desktop();
@@ -230,10 +252,27 @@ void init_X11_pre_config()
     // get monitor and desktop config
     get_monitors();
     get_desktops();
+    startup_mark("monitors");
 
     server.disable_transparency = 0;
 
     xsettings_client = xsettings_client_new(server.display, server.screen, xsettings_notify_cb, NULL, NULL);
+    startup_mark("xsettings");
+}
+
+// Loads the fontconfig configuration and caches, and matches the default font, on a separate font map.
+// They are shared by the whole process, so the first text layout of the main thread does not wait for them.
+static void load_fonts(void *arg)
+{
+    PangoFontMap *font_map = pango_cairo_font_map_new();
+    PangoContext *context = pango_font_map_create_context(font_map);
+    PangoFontDescription *font_desc = pango_font_description_from_string((const char *)arg);
+    PangoFont *font = pango_font_map_load_font(font_map, context, font_desc);
+    if (font)
+        g_object_unref(font);
+    pango_font_description_free(font_desc);
+    g_object_unref(context);
+    g_object_unref(font_map);
 }
 
 void init(int argc, char **argv)
@@ -245,6 +284,7 @@ void init(int argc, char **argv)
     handle_cli_arguments(argc, argv);
     create_default_elements();
     init_signals();
+    startup_begin();
 
     init_X11_pre_config();
     if (!config_read()) {
@@ -255,13 +295,20 @@ void init(int argc, char **argv)
         exit(EXIT_FAILURE);
     }
 
+    startup_mark("config");
+    show_cached_frames();
+    startup_mark("cached frames");
+    startup_task_run("fonts", load_fonts, g_free, g_strdup(get_default_font()));
     init_post_config();
+    startup_mark("X setup");
     start_detect_compositor();
     init_panel();
 }
 
 void cleanup()
 {
+    startup_tasks_join();
+    save_cached_frames();
 #ifdef HAVE_SN
     if (startup_notifications) {
         sn_display_unref(server.sn_display);
@@ -280,8 +327,10 @@ void cleanup()
 #endif
     cleanup_separator();
     cleanup_taskbar();
+    cleanup_window_thumbnails();
     cleanup_panel();
     cleanup_config();
+    fswatch_cleanup();
 
     if (default_icon) {
         imlib_context_set_image(default_icon);
@@ -19,7 +19,9 @@
 /* http://standards.freedesktop.org/desktop-entry-spec/ */
 
 #include "apps-common.h"
+#include "cache.h"
 #include "common.h"
+#include "hash.h"
 #include "strnatcmp.h"
 
 #include <glib.h>
@@ -33,6 +35,168 @@ static gint compare_strings(gconstpointer a, gconstpointer b)
     return strnatcasecmp((const char *)a, (const char *)b);
 }
 
+// Index of the desktop files that have been parsed, persisted in the cache directory.
+// Keys:
+// * "<full path>\t<language>": the parsed entry, with the stamp of the file.
+//   Value: name, generic name, exec (before expansion), icon and path (cwd), empty if missing, followed by the
+//   flags hidden_from_menus, start_in_terminal and startup_notification as '0' or '1', separated by newlines.
+// * "<file name>\t": the full path of a desktop file given by name, with the stamp of the applications
+//   directories and their subdirectories. The file itself is still validated by its own stamp.
+static Cache desktop_entry_cache;
+// -1 until TINT2_NO_DESKTOP_ENTRY_CACHE has been checked
+static int desktop_entry_cache_enabled = -1;
+
+static gchar *get_desktop_entry_cache_path()
+{
+    return g_build_filename(g_get_user_cache_dir(), "tint2", "desktop-entries.cache", NULL);
+}
+
+static gboolean load_desktop_entry_cache()
+{
+    if (desktop_entry_cache_enabled < 0)
+        desktop_entry_cache_enabled = getenv("TINT2_NO_DESKTOP_ENTRY_CACHE") == NULL;
+    if (!desktop_entry_cache_enabled)
+        return FALSE;
+    if (!desktop_entry_cache.loaded) {
+        gchar *cache_path = get_desktop_entry_cache_path();
+        load_cache(&desktop_entry_cache, cache_path);
+        g_free(cache_path);
+    }
+    return TRUE;
+}
+
+void save_desktop_entry_cache()
+{
+    if (!desktop_entry_cache.dirty)
+        return;
+    gchar *cache_path = get_desktop_entry_cache_path();
+    save_cache(&desktop_entry_cache, cache_path);
+    g_free(cache_path);
+}
+
+static gchar *desktop_entry_key(const char *path)
+{
+    // Name and GenericName depend on the language
+    return g_strdup_printf("%s\t%s", path, g_get_language_names()[0]);
+}
+
+static char *strdup_or_null(const char *s)
+{
+    return s && *s ? strdup(s) : NULL;
+}
+
+// Fills entry from the index. Returns FALSE if the file is not indexed or has changed since.
+static gboolean get_cached_desktop_entry(const char *path, guint64 stamp, DesktopEntry *entry)
+{
+    if (!load_desktop_entry_cache())
+        return FALSE;
+    gchar *key = desktop_entry_key(path);
+    const gchar *value = get_from_cache(&desktop_entry_cache, key, stamp);
+    g_free(key);
+    if (!value)
+        return FALSE;
+    gchar **fields = g_strsplit(value, "\n", 0);
+    gboolean found = g_strv_length(fields) == 6 && strlen(fields[5]) == 3;
+    if (found) {
+        entry->name = strdup_or_null(fields[0]);
+        entry->generic_name = strdup_or_null(fields[1]);
+        entry->exec = strdup_or_null(fields[2]);
+        entry->icon = strdup_or_null(fields[3]);
+        entry->cwd = strdup_or_null(fields[4]);
+        entry->hidden_from_menus = fields[5][0] == '1';
+        entry->start_in_terminal = fields[5][1] == '1';
+        entry->startup_notification = fields[5][2] == '1';
+    }
+    g_strfreev(fields);
+    return found;
+}
+
+static void add_cached_desktop_entry(const char *path, guint64 stamp, const DesktopEntry *entry)
+{
+    if (!load_desktop_entry_cache())
+        return;
+    gchar *key = desktop_entry_key(path);
+    gchar *value = g_strdup_printf("%s\n%s\n%s\n%s\n%s\n%c%c%c",
+                                   entry->name ? entry->name : "",
+                                   entry->generic_name ? entry->generic_name : "",
+                                   entry->exec ? entry->exec : "",
+                                   entry->icon ? entry->icon : "",
+                                   entry->cwd ? entry->cwd : "",
+                                   entry->hidden_from_menus ? '1' : '0',
+                                   entry->start_in_terminal ? '1' : '0',
+                                   entry->startup_notification ? '1' : '0');
+    add_to_cache(&desktop_entry_cache, key, value, stamp);
+    g_free(value);
+    g_free(key);
+}
+
+// Hashes the stamps of dir and of its subdirectories (which read_desktop_file_from_dir searches), in name order
+static guint64 get_apps_dir_stamp(const char *dir, guint64 stamp)
+{
+    guint64 dir_stamp = get_file_stamp(dir);
+    stamp = hash64(&dir_stamp, sizeof(dir_stamp), stamp);
+    if (!dir_stamp)
+        return stamp;
+
+    GList *subdirs = NULL;
+    GDir *d = g_dir_open(dir, 0, NULL);
+    if (d) {
+        const gchar *name;
+        while ((name = g_dir_read_name(d))) {
+            // Most entries are desktop files, which do not need to be checked
+            if (g_str_has_suffix(name, ".desktop"))
+                continue;
+            gchar *child = g_build_filename(dir, name, NULL);
+            if (g_file_test(child, G_FILE_TEST_IS_DIR))
+                subdirs = g_list_append(subdirs, child);
+            else
+                g_free(child);
+        }
+        g_dir_close(d);
+    }
+    subdirs = g_list_sort(subdirs, compare_strings);
+    for (GList *l = subdirs; l; l = g_list_next(l))
+        stamp = get_apps_dir_stamp((const char *)l->data, stamp);
+    g_list_free_full(subdirs, g_free);
+    return stamp;
+}
+
+// Stamp of the applications directories and their subdirectories, computed by get_apps_locations_stamp
+static guint64 apps_locations_stamp;
+// Stamp of the applications directories alone, when apps_locations_stamp was computed
+static guint64 apps_locations_top_stamp;
+
+static guint64 get_apps_locations_top_stamp()
+{
+    guint64 stamp = 0;
+    for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location)) {
+        guint64 dir_stamp = get_file_stamp((const char *)location->data);
+        stamp = hash64(&dir_stamp, sizeof(dir_stamp), stamp);
+    }
+    return stamp;
+}
+
+// Returns a value that changes when files are added to or removed from the applications directories
+// (e.g. applications/kde4/). Walking the subdirectories is expensive, so it is only done once, and again when the
+// applications directories themselves change or after apps_locations_changed().
+static guint64 get_apps_locations_stamp()
+{
+    guint64 top_stamp = get_apps_locations_top_stamp();
+    if (apps_locations_stamp && top_stamp == apps_locations_top_stamp)
+        return apps_locations_stamp;
+    guint64 stamp = 0;
+    for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location))
+        stamp = get_apps_dir_stamp((const char *)location->data, stamp);
+    apps_locations_stamp = stamp ? stamp : 1;
+    apps_locations_top_stamp = top_stamp;
+    return apps_locations_stamp;
+}
+
+void apps_locations_changed()
+{
+    apps_locations_stamp = 0;
+}
+
 int parse_dektop_line(char *line, char **key, char **value)
 {
     char *p;
@@ -120,17 +284,12 @@ void expand_exec(DesktopEntry *entry, const char *path)
     }
 }
 
-gboolean read_desktop_file_full_path(const char *path, DesktopEntry *entry)
+static void parse_desktop_file(const char *path, DesktopEntry *entry)
 {
-    entry->name = entry->generic_name = entry->icon = entry->exec = entry->cwd = NULL;
-    entry->hidden_from_menus = FALSE;
-    entry->start_in_terminal = FALSE;
-    entry->startup_notification = TRUE;
-
     FILE *fp = fopen(path, "rt");
     if (fp == NULL) {
         fprintf(stderr, "tint2: Could not open file %s\n", path);
-        return FALSE;
+        return;
     }
 
     const gchar **languages = (const gchar **)g_get_language_names();
@@ -213,20 +372,36 @@ gboolean read_desktop_file_full_path(const char *path, DesktopEntry *entry)
         }
     }
     fclose(fp);
+    free(line);
+}
+
+gboolean read_desktop_file_full_path(const char *path, DesktopEntry *entry)
+{
+    entry->name = entry->generic_name = entry->icon = entry->exec = entry->cwd = NULL;
+    entry->hidden_from_menus = FALSE;
+    entry->start_in_terminal = FALSE;
+    entry->startup_notification = TRUE;
+
+    guint64 stamp = get_file_stamp(path);
+    if (!stamp || !get_cached_desktop_entry(path, stamp, entry)) {
+        parse_desktop_file(path, entry);
+        if (stamp)
+            add_cached_desktop_entry(path, stamp, entry);
+    }
     // From this point:
     // entry->name, entry->generic_name, entry->icon, entry->exec will never be empty strings (can be NULL though)
 
     expand_exec(entry, entry->path);
 
-    free(line);
     return entry->exec != NULL;
 }
 
-gboolean read_desktop_file_from_dir(const char *path, const char *file_name, DesktopEntry *entry)
+// Stores the path of the file that was read in found_path.
+gboolean read_desktop_file_from_dir(const char *path, const char *file_name, DesktopEntry *entry, gchar **found_path)
 {
     gchar *full_path = g_build_filename(path, file_name, NULL);
     if (read_desktop_file_full_path(full_path, entry)) {
-        g_free(full_path);
+        *found_path = full_path;
         return TRUE;
     }
     free_and_null(entry->name);
@@ -254,7 +429,7 @@ gboolean read_desktop_file_from_dir(const char *path, const char *file_name, Des
     subdirs = g_list_sort(subdirs, compare_strings);
     gboolean found = FALSE;
     for (GList *l = subdirs; l; l = g_list_next(l)) {
-        if (read_desktop_file_from_dir(l->data, file_name, entry)) {
+        if (read_desktop_file_from_dir(l->data, file_name, entry, found_path)) {
             found = TRUE;
             break;
         }
@@ -269,6 +444,16 @@ gboolean read_desktop_file_from_dir(const char *path, const char *file_name, Des
     return found;
 }
 
+// Frees what read_desktop_file_full_path sets, but not the path
+static void free_desktop_entry_fields(DesktopEntry *entry)
+{
+    free_and_null(entry->name);
+    free_and_null(entry->generic_name);
+    free_and_null(entry->icon);
+    free_and_null(entry->exec);
+    free_and_null(entry->cwd);
+}
+
 gboolean read_desktop_file(const char *path, DesktopEntry *entry)
 {
     entry->path = strdup(path);
@@ -276,11 +461,44 @@ gboolean read_desktop_file(const char *path, DesktopEntry *entry)
 
     if (strchr(path, '/'))
         return read_desktop_file_full_path(path, entry);
+
+    // Most files are directly in one of the applications directories
     for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location)) {
-        if (read_desktop_file_from_dir(location->data, path, entry))
+        gchar *full_path = g_build_filename((const char *)location->data, path, NULL);
+        gboolean found =
+            g_file_test(full_path, G_FILE_TEST_IS_REGULAR) && read_desktop_file_full_path(full_path, entry);
+        g_free(full_path);
+        if (found)
             return TRUE;
+        free_desktop_entry_fields(entry);
+    }
+
+    // Look up where the file was found last time in the subdirectories
+    guint64 stamp = get_apps_locations_stamp();
+    gchar *key = g_strdup_printf("%s\t", path);
+    const gchar *cached_path = load_desktop_entry_cache() ? get_from_cache(&desktop_entry_cache, key, stamp) : NULL;
+    // The cached path may be stale (the stamps have a limited resolution): check it quietly, since
+    // parse_desktop_file warns about files that cannot be opened
+    if (cached_path && g_file_test(cached_path, G_FILE_TEST_IS_REGULAR) &&
+        read_desktop_file_full_path(cached_path, entry)) {
+        g_free(key);
+        return TRUE;
+    }
+    free_desktop_entry_fields(entry);
+
+    gboolean found = FALSE;
+    for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location)) {
+        gchar *found_path = NULL;
+        if (read_desktop_file_from_dir(location->data, path, entry, &found_path)) {
+            if (load_desktop_entry_cache())
+                add_to_cache(&desktop_entry_cache, key, found_path, stamp);
+            g_free(found_path);
+            found = TRUE;
+            break;
+        }
     }
-    return FALSE;
+    g_free(key);
+    return found;
 }
 
 void free_desktop_entry(DesktopEntry *entry)
@@ -29,8 +29,17 @@ int parse_dektop_line(char *line, char **key, char **value);
 // Reads the .desktop file from the given path into the DesktopEntry entry.
 // The DesktopEntry object must be initially empty.
 // Returns 1 if successful.
+// Files that have not changed since they were last read are not parsed again, see save_desktop_entry_cache.
 gboolean read_desktop_file(const char *path, DesktopEntry *entry);
 
+// Saves the parsed desktop files to the cache directory, so that they are not parsed again on the next start.
+// Set TINT2_NO_DESKTOP_ENTRY_CACHE to disable this.
+void save_desktop_entry_cache();
+
+// Call when files may have been added to or removed from the subdirectories of the applications directories,
+// so that read_desktop_file searches them again for files given by name.
+void apps_locations_changed();
+
 // Empties DesktopEntry: releases the memory of the *members* of entry.
 void free_desktop_entry(DesktopEntry *entry);
 
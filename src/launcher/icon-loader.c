@@ -0,0 +1,378 @@
+/**************************************************************************
+*
+* Tint2 : asynchronous icon loading
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <cairo.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cache.h"
+#include "common.h"
+#include "icon-loader.h"
+#include "timer.h"
+
+// Imlib2 is not thread safe, so the workers only use cairo and librsvg. They resolve the icon path, decode the file
+// and scale it into a plain ARGB buffer, which the main thread wraps into an Imlib image.
+
+typedef struct IconJob {
+    void *owner;
+    IconThemeWrapper *theme;
+    char *icon_name;
+    char *path;
+    int size;
+    // If use_pack is set, the result is scaled, adjusted by effects and stored in the icon pack
+    gboolean use_pack;
+    IconEffects effects;
+    IconLoadedCallback callback;
+    // Set by the main thread when the job is replaced or cancelled, so that the workers can skip it
+    gint cancelled;
+    // Results
+    // Non-premultiplied ARGB pixels, or NULL if the file must be loaded on the main thread
+    DATA32 *data;
+    int width;
+    int height;
+    // Loaded if path cannot be loaded on the main thread
+    char *fallback_path;
+} IconJob;
+
+#define ICON_LOADER_MAX_THREADS 4
+// How long the main thread may spend loading the icons that the workers could not decode, per loop iteration
+#define ICON_LOADER_BUDGET_MS 10
+
+static GThreadPool *pool;
+static GAsyncQueue *result_queue;
+static int wakeup_pipe[2] = {-1, -1};
+// Maps owners to the IconJob of their latest request. Only accessed from the main thread.
+static GHashTable *pending_jobs;
+// The theme of the last handled request, whose path cache is saved when all the requests are done
+static IconThemeWrapper *last_theme;
+
+static void free_icon_job(IconJob *job)
+{
+    free(job->icon_name);
+    free(job->path);
+    free(job->fallback_path);
+    free(job->data);
+    free(job);
+}
+
+// Decodes a PNG (with cairo) or SVG (with librsvg) file and scales it to size x size (unless size is 0).
+// Stores the pixels in job->data. Returns FALSE if the file should be loaded by Imlib2 on the main thread.
+static gboolean decode_icon(IconJob *job, const char *path, int size)
+{
+#ifdef HAVE_RSVG
+    if (g_str_has_suffix(path, ".svg")) {
+        job->data = render_svg(path, size, &job->width, &job->height);
+        return job->data != NULL;
+    }
+#endif
+#ifdef CAIRO_HAS_PNG_FUNCTIONS
+    if (!g_str_has_suffix(path, ".png"))
+        return FALSE;
+    cairo_surface_t *image = cairo_image_surface_create_from_png(path);
+    if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(image);
+        return FALSE;
+    }
+    int w = cairo_image_surface_get_width(image);
+    int h = cairo_image_surface_get_height(image);
+    if (size > 0 && (w != size || h != size)) {
+        cairo_surface_t *scaled = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size, size);
+        cairo_t *c = cairo_create(scaled);
+        cairo_scale(c, size / (double)w, size / (double)h);
+        cairo_set_source_surface(c, image, 0, 0);
+        cairo_pattern_set_filter(cairo_get_source(c), CAIRO_FILTER_GOOD);
+        cairo_paint(c);
+        cairo_destroy(c);
+        cairo_surface_destroy(image);
+        image = scaled;
+        w = h = size;
+    }
+    job->data = argb_from_cairo_surface(image);
+    job->width = w;
+    job->height = h;
+    cairo_surface_destroy(image);
+    return job->data != NULL;
+#else
+    return FALSE;
+#endif
+}
+
+// Resolves the path of the icon and decodes it. Thread safe.
+static void resolve_icon_job(IconJob *job)
+{
+    if (job->icon_name)
+        job->path = get_icon_path(job->theme, job->icon_name, job->size, TRUE);
+    if (job->path && job->use_pack) {
+        guint64 stamp = get_file_stamp(job->path);
+        job->data = icon_pack_get(job->path, stamp, job->size, &job->effects, &job->width, &job->height);
+        if (job->data)
+            return;
+        if (decode_icon(job, job->path, job->size)) {
+            adjust_asb(job->data,
+                       job->width,
+                       job->height,
+                       job->effects.alpha / 100.0,
+                       job->effects.saturation / 100.0,
+                       job->effects.brightness / 100.0);
+            icon_pack_add(job->path, stamp, job->size, &job->effects, job->data, job->width, job->height);
+            return;
+        }
+    } else if (job->path && decode_icon(job, job->path, job->size)) {
+        return;
+    }
+    if (job->icon_name)
+        job->fallback_path = get_icon_path(job->theme, DEFAULT_ICON, job->size, TRUE);
+}
+
+static void run_icon_job(gpointer data, gpointer user_data)
+{
+    IconJob *job = (IconJob *)data;
+    if (!g_atomic_int_get(&job->cancelled))
+        resolve_icon_job(job);
+    g_async_queue_push(result_queue, job);
+    ssize_t unused = write(wakeup_pipe[1], "x", 1);
+    (void)unused;
+}
+
+static gboolean icon_loader_start()
+{
+    if (pool)
+        return TRUE;
+    if (getenv("TINT2_ICON_LOADER_NO_THREAD"))
+        return FALSE;
+    if (pipe(wakeup_pipe) != 0) {
+        fprintf(stderr, YELLOW "tint2: could not create a pipe for the icon loader" RESET "\n");
+        return FALSE;
+    }
+    fcntl(wakeup_pipe[0], F_SETFL, O_NONBLOCK | fcntl(wakeup_pipe[0], F_GETFL));
+    fcntl(wakeup_pipe[1], F_SETFL, O_NONBLOCK | fcntl(wakeup_pipe[1], F_GETFL));
+    result_queue = g_async_queue_new();
+    pending_jobs = g_hash_table_new(g_direct_hash, g_direct_equal);
+    int num_threads = (int)MIN(MAX(g_get_num_processors(), 1), ICON_LOADER_MAX_THREADS);
+    pool = g_thread_pool_new(run_icon_job, NULL, num_threads, FALSE, NULL);
+    if (debug_icons)
+        fprintf(stderr, "tint2: started icon loader with %d threads\n", num_threads);
+    return TRUE;
+}
+
+void icon_loader_stop()
+{
+    icon_pack_save();
+    if (!pool)
+        return;
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, pending_jobs);
+    while (g_hash_table_iter_next(&iter, NULL, &value))
+        g_atomic_int_set(&((IconJob *)value)->cancelled, TRUE);
+    // Runs the remaining (cancelled) jobs, which return immediately, and waits for the threads
+    g_thread_pool_free(pool, FALSE, TRUE);
+    pool = NULL;
+    IconJob *job;
+    while ((job = g_async_queue_try_pop(result_queue)))
+        free_icon_job(job);
+    g_async_queue_unref(result_queue);
+    result_queue = NULL;
+    g_hash_table_destroy(pending_jobs);
+    pending_jobs = NULL;
+    last_theme = NULL;
+    close(wakeup_pipe[0]);
+    close(wakeup_pipe[1]);
+    wakeup_pipe[0] = wakeup_pipe[1] = -1;
+}
+
+static IconJob *new_icon_job(IconThemeWrapper *theme,
+                             const char *icon_name,
+                             const char *path,
+                             int size,
+                             const IconEffects *effects)
+{
+    IconJob *job = calloc(1, sizeof(IconJob));
+    job->theme = theme;
+    job->icon_name = icon_name ? strdup(icon_name) : NULL;
+    job->path = !icon_name && path ? strdup(path) : NULL;
+    job->size = size;
+    if (effects) {
+        job->use_pack = TRUE;
+        job->effects = *effects;
+    }
+    return job;
+}
+
+gboolean icon_loader_request(void *owner,
+                             IconThemeWrapper *theme,
+                             const char *icon_name,
+                             const char *path,
+                             int size,
+                             const IconEffects *effects,
+                             IconLoadedCallback callback)
+{
+    if (!icon_loader_start())
+        return FALSE;
+    icon_loader_cancel(owner);
+    IconJob *job = new_icon_job(theme, icon_name, path, size, effects);
+    job->owner = owner;
+    job->callback = callback;
+    g_hash_table_insert(pending_jobs, owner, job);
+    g_thread_pool_push(pool, job, NULL);
+    return TRUE;
+}
+
+void icon_loader_cancel(void *owner)
+{
+    if (!pending_jobs)
+        return;
+    IconJob *job = (IconJob *)g_hash_table_lookup(pending_jobs, owner);
+    if (!job)
+        return;
+    // The job is freed when it comes out of the result queue
+    g_atomic_int_set(&job->cancelled, TRUE);
+    g_hash_table_remove(pending_jobs, owner);
+}
+
+gboolean icon_loader_busy()
+{
+    return pending_jobs && g_hash_table_size(pending_jobs) > 0;
+}
+
+int icon_loader_fd()
+{
+    return wakeup_pipe[0];
+}
+
+static Imlib_Image image_from_pixels(const DATA32 *data, int width, int height)
+{
+    Imlib_Image image = imlib_create_image_using_copied_data(width, height, (DATA32 *)data);
+    if (image) {
+        imlib_context_set_image(image);
+        imlib_image_set_has_alpha(1);
+    }
+    return image;
+}
+
+// Loads a file that the workers could not decode, scaling it and applying the effects if needed.
+// Main thread only.
+static Imlib_Image load_icon_file(IconJob *job, const char *path)
+{
+    if (!job->use_pack)
+        return load_image_at_size(path, TRUE, job->size);
+
+    guint64 stamp = get_file_stamp(path);
+    int w, h;
+    DATA32 *data = icon_pack_get(path, stamp, job->size, &job->effects, &w, &h);
+    if (data) {
+        Imlib_Image image = image_from_pixels(data, w, h);
+        free(data);
+        return image;
+    }
+
+    Imlib_Image image = load_image_at_size(path, TRUE, job->size);
+    if (!image)
+        return NULL;
+    Imlib_Image adjusted = scale_and_adjust_icon(image,
+                                                 job->size,
+                                                 job->effects.alpha,
+                                                 job->effects.saturation,
+                                                 job->effects.brightness);
+    imlib_context_set_image(image);
+    imlib_free_image();
+    if (adjusted) {
+        imlib_context_set_image(adjusted);
+        icon_pack_add(path,
+                      stamp,
+                      job->size,
+                      &job->effects,
+                      imlib_image_get_data_for_reading_only(),
+                      imlib_image_get_width(),
+                      imlib_image_get_height());
+    }
+    return adjusted;
+}
+
+// Returns the image of a resolved job. Main thread only.
+static Imlib_Image icon_job_image(IconJob *job, const char **path)
+{
+    *path = job->path;
+    if (job->data)
+        return image_from_pixels(job->data, job->width, job->height);
+    Imlib_Image image = job->path ? load_icon_file(job, job->path) : NULL;
+    if (!image && job->fallback_path) {
+        *path = job->fallback_path;
+        image = load_icon_file(job, job->fallback_path);
+    }
+    if (!image)
+        *path = NULL;
+    return image;
+}
+
+Imlib_Image icon_loader_load(IconThemeWrapper *theme,
+                             const char *icon_name,
+                             const char *path,
+                             int size,
+                             const IconEffects *effects,
+                             char **loaded_path)
+{
+    IconJob *job = new_icon_job(theme, icon_name, path, size, effects);
+    resolve_icon_job(job);
+    const char *image_path;
+    Imlib_Image image = icon_job_image(job, &image_path);
+    if (loaded_path)
+        *loaded_path = image_path ? strdup(image_path) : NULL;
+    free_icon_job(job);
+    return image;
+}
+
+void handle_icon_loader_events()
+{
+    if (!pool)
+        return;
+    char buffer[64];
+    while (read(wakeup_pipe[0], buffer, sizeof(buffer)) > 0) {
+    }
+    double start = get_time();
+    IconJob *job;
+    while ((job = g_async_queue_try_pop(result_queue))) {
+        if (!g_atomic_int_get(&job->cancelled) && g_hash_table_lookup(pending_jobs, job->owner) == job) {
+            g_hash_table_remove(pending_jobs, job->owner);
+            last_theme = job->theme;
+            const char *path;
+            Imlib_Image image = icon_job_image(job, &path);
+            if (debug_icons)
+                fprintf(stderr,
+                        "tint2: icon loader: %s -> %s%s\n",
+                        job->icon_name ? job->icon_name : "(file)",
+                        path ? path : "(none)",
+                        job->data ? "" : " (loaded on the main thread)");
+            job->callback(job->owner, image, path);
+        }
+        free_icon_job(job);
+        if (1000 * (get_time() - start) > ICON_LOADER_BUDGET_MS) {
+            // Come back on the next iteration of the main loop
+            ssize_t unused = write(wakeup_pipe[1], "x", 1);
+            (void)unused;
+            return;
+        }
+    }
+    if (!icon_loader_busy()) {
+        // Everything is loaded: persist what the workers have learned
+        save_icon_cache(last_theme);
+        icon_pack_save();
+    }
+}
@@ -0,0 +1,61 @@
+/**************************************************************************
+ * Loads icons on a pool of worker threads
+ *
+ **************************************************************************/
+
+#ifndef ICON_LOADER_H
+#define ICON_LOADER_H
+
+#include <glib.h>
+#include <Imlib2.h>
+
+#include "icon-pack.h"
+#include "icon-theme-common.h"
+
+// Called on the main thread when an icon is ready. Takes ownership of image, which is NULL if the icon
+// could not be loaded. path is the file that was loaded, or NULL; it is only valid during the call.
+typedef void (*IconLoadedCallback)(void *owner, Imlib_Image image, const char *path);
+
+// Loads an icon off the main thread, then calls callback from the main loop.
+// If icon_name is not NULL, it is looked up in theme (falling back to DEFAULT_ICON if it cannot be loaded);
+// otherwise the file at path is loaded. The image is scaled to size x size, or kept at its original size
+// if size is 0.
+// If effects is not NULL, they are applied to the image, which is then stored in the icon pack (and taken
+// from there by later requests). Otherwise the image is returned as decoded.
+// A new request from the same owner replaces the pending one. Formats that cannot be decoded off the main
+// thread are loaded with load_image() when the result is handled.
+// Returns FALSE if the icon must be loaded synchronously instead (e.g. TINT2_ICON_LOADER_NO_THREAD is set).
+gboolean icon_loader_request(void *owner,
+                             IconThemeWrapper *theme,
+                             const char *icon_name,
+                             const char *path,
+                             int size,
+                             const IconEffects *effects,
+                             IconLoadedCallback callback);
+
+// Like icon_loader_request, but loads the icon immediately on the calling (main) thread and returns it.
+// If loaded_path is not NULL, it receives the path of the file that was loaded (to be released with free()).
+Imlib_Image icon_loader_load(IconThemeWrapper *theme,
+                             const char *icon_name,
+                             const char *path,
+                             int size,
+                             const IconEffects *effects,
+                             char **loaded_path);
+
+// Drops the pending request of owner, if any. Must be called before owner is freed.
+void icon_loader_cancel(void *owner);
+
+// Returns TRUE if there are requests that have not been handled yet.
+gboolean icon_loader_busy();
+
+// Drops all the pending requests, waits for the worker threads to finish and saves the icon pack.
+// Must be called before freeing an icon theme that may be in use by the workers.
+void icon_loader_stop();
+
+// File descriptor that becomes readable when results are available, or -1.
+int icon_loader_fd();
+
+// Calls the callbacks of the finished requests.
+void handle_icon_loader_events();
+
+#endif
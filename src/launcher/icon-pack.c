@@ -0,0 +1,166 @@
+/**************************************************************************
+*
+* Tint2 : cache of rasterized icons
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+#include "common.h"
+#include "icon-pack.h"
+#include "icon-theme-common.h"
+
+// The pixels are stored in the values of a Cache, after this header
+typedef struct PackedIconHeader {
+    guint32 width;
+    guint32 height;
+} PackedIconHeader;
+
+// Larger icons are not worth keeping
+#define MAX_PACKED_ICON_SIZE 512
+// Size limit of the pack file (about 3000 icons of 48x48 pixels); the least recently used icons are evicted first
+#define ICON_PACK_MAX_BYTES (32 * 1024 * 1024)
+
+static GMutex icon_pack_mutex;
+static Cache icon_pack;
+// -1 until TINT2_NO_ICON_PACK has been checked
+static int icon_pack_enabled = -1;
+
+static gchar *get_icon_pack_path()
+{
+    return g_build_filename(g_get_user_cache_dir(), "tint2", "icon.pack", NULL);
+}
+
+// Icons that have not been used in the current session are kept only while their source file is unchanged
+static gboolean icon_pack_keep_unused(const gchar *key, guint64 stamp)
+{
+    const char *end = strchr(key, '\t');
+    if (!end)
+        return FALSE;
+    gchar *path = g_strndup(key, (gsize)(end - key));
+    gboolean keep = get_file_stamp(path) == stamp;
+    g_free(path);
+    return keep;
+}
+
+// Loads the pack if needed. Must be called with the mutex locked. Returns FALSE if the pack is disabled.
+static gboolean load_icon_pack()
+{
+    if (icon_pack_enabled < 0)
+        icon_pack_enabled = getenv("TINT2_NO_ICON_PACK") == NULL;
+    if (!icon_pack_enabled)
+        return FALSE;
+    if (!icon_pack.loaded) {
+        icon_pack.max_size = ICON_PACK_MAX_BYTES;
+        icon_pack.keep_unused = icon_pack_keep_unused;
+        gchar *pack_path = get_icon_pack_path();
+        load_cache(&icon_pack, pack_path);
+        g_free(pack_path);
+    }
+    return TRUE;
+}
+
+static gchar *icon_pack_key(const char *path, int size, const IconEffects *effects)
+{
+    return g_strdup_printf("%s\t%d\t%d\t%d\t%d",
+                           path,
+                           size,
+                           effects->alpha,
+                           effects->saturation,
+                           effects->brightness);
+}
+
+DATA32 *icon_pack_get(const char *path,
+                      guint64 stamp,
+                      int size,
+                      const IconEffects *effects,
+                      int *width,
+                      int *height)
+{
+    if (!path || !stamp)
+        return NULL;
+    DATA32 *data = NULL;
+    g_mutex_lock(&icon_pack_mutex);
+    if (load_icon_pack()) {
+        gchar *key = icon_pack_key(path, size, effects);
+        size_t value_size = 0;
+        const unsigned char *value = get_blob_from_cache(&icon_pack, key, stamp, &value_size);
+        g_free(key);
+        PackedIconHeader header;
+        if (value && value_size >= sizeof(header)) {
+            // The value is not necessarily aligned
+            memcpy(&header, value, sizeof(header));
+            size_t n_pixels = (size_t)header.width * header.height;
+            if (header.width > 0 && header.height > 0 && header.width <= MAX_PACKED_ICON_SIZE &&
+                header.height <= MAX_PACKED_ICON_SIZE && value_size == sizeof(header) + n_pixels * sizeof(DATA32)) {
+                data = malloc(n_pixels * sizeof(DATA32));
+                memcpy(data, value + sizeof(header), n_pixels * sizeof(DATA32));
+                *width = (int)header.width;
+                *height = (int)header.height;
+            }
+        }
+    }
+    g_mutex_unlock(&icon_pack_mutex);
+    return data;
+}
+
+void icon_pack_add(const char *path,
+                   guint64 stamp,
+                   int size,
+                   const IconEffects *effects,
+                   const DATA32 *data,
+                   int width,
+                   int height)
+{
+    if (!path || !stamp || !data || width <= 0 || height <= 0 || width > MAX_PACKED_ICON_SIZE ||
+        height > MAX_PACKED_ICON_SIZE)
+        return;
+    PackedIconHeader header = {(guint32)width, (guint32)height};
+    size_t pixels_size = (size_t)width * height * sizeof(DATA32);
+    unsigned char *value = malloc(sizeof(header) + pixels_size);
+    memcpy(value, &header, sizeof(header));
+    memcpy(value + sizeof(header), data, pixels_size);
+
+    g_mutex_lock(&icon_pack_mutex);
+    if (load_icon_pack()) {
+        gchar *key = icon_pack_key(path, size, effects);
+        add_blob_to_cache(&icon_pack, key, value, sizeof(header) + pixels_size, stamp);
+        g_free(key);
+    }
+    g_mutex_unlock(&icon_pack_mutex);
+    free(value);
+}
+
+void icon_pack_save()
+{
+    g_mutex_lock(&icon_pack_mutex);
+    if (icon_pack.dirty) {
+        if (debug_icons)
+            fprintf(stderr, "tint2: Saving icon pack\n");
+        gchar *pack_path = get_icon_pack_path();
+        save_cache(&icon_pack, pack_path);
+        g_free(pack_path);
+    }
+    g_mutex_unlock(&icon_pack_mutex);
+}
+
+void icon_pack_free()
+{
+    g_mutex_lock(&icon_pack_mutex);
+    free_cache(&icon_pack);
+    g_mutex_unlock(&icon_pack_mutex);
+}
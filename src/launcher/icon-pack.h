@@ -0,0 +1,50 @@
+/**************************************************************************
+ * Cache of rasterized icons
+ *
+ **************************************************************************/
+
+#ifndef ICON_PACK_H
+#define ICON_PACK_H
+
+#include <glib.h>
+#include <Imlib2.h>
+
+// Adjustments applied to an icon after scaling it, as percentages (see adjust_icon)
+typedef struct IconEffects {
+    int alpha;
+    int saturation;
+    int brightness;
+} IconEffects;
+
+// The icon pack keeps the final pixels of icons (decoded, scaled and adjusted) in a single file,
+// ~/.cache/tint2/icon.pack, keyed by source file, size and effects, so that they are not decoded again
+// on the next start. Set TINT2_NO_ICON_PACK to disable it.
+// The file size is limited: when it is compacted, icons unused in the current session are dropped if their
+// source file changed or disappeared, then the least recently used icons are dropped as needed.
+// All the functions are thread safe.
+
+// Returns a copy of the pixels of an icon (to be released with free()), or NULL if it is not in the pack.
+// stamp must be the value returned by get_file_stamp (see cache.h).
+DATA32 *icon_pack_get(const char *path,
+                      guint64 stamp,
+                      int size,
+                      const IconEffects *effects,
+                      int *width,
+                      int *height);
+
+// Adds the pixels of an icon to the pack. Does not take ownership of data.
+void icon_pack_add(const char *path,
+                   guint64 stamp,
+                   int size,
+                   const IconEffects *effects,
+                   const DATA32 *data,
+                   int width,
+                   int height);
+
+// Writes the icons added since the last save to disk.
+void icon_pack_save();
+
+// Releases the memory used by the pack. It is loaded again when needed.
+void icon_pack_free();
+
+#endif
@@ -0,0 +1,217 @@
+/**************************************************************************
+* Tint2 : reader for GTK icon theme caches
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+// The format is described in gtk/docs/iconcache.txt. All numbers are big endian.
+//
+// Header:
+//   CARD16 MAJOR_VERSION (1)
+//   CARD16 MINOR_VERSION (0)
+//   CARD32 HASH_OFFSET
+//   CARD32 DIRECTORY_LIST_OFFSET
+// DirectoryList:
+//   CARD32 N_DIRECTORIES
+//   CARD32 DIRECTORY_OFFSET[N_DIRECTORIES] -> string
+// Hash:
+//   CARD32 N_BUCKETS
+//   CARD32 ICON_OFFSET[N_BUCKETS] -> Icon
+// Icon:
+//   CARD32 CHAIN_OFFSET -> Icon (next in bucket, or 0xffffffff)
+//   CARD32 NAME_OFFSET -> string
+//   CARD32 IMAGE_LIST_OFFSET -> ImageList
+// ImageList:
+//   CARD32 N_IMAGES
+//   Image[N_IMAGES]:
+//     CARD16 DIRECTORY_INDEX
+//     CARD16 FLAGS
+//     CARD32 IMAGE_DATA_OFFSET
+//
+// The file is never trusted: every offset is checked against the size of the mapping.
+
+#include "icon-theme-cache.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "icon-theme-common.h"
+
+#define ICON_CACHE_NONE 0xffffffff
+
+static gboolean read_card16(const IconThemeCache *cache, size_t offset, guint16 *value)
+{
+    if (offset + 2 > cache->size)
+        return FALSE;
+    const unsigned char *p = cache->data + offset;
+    *value = (guint16)((p[0] << 8) | p[1]);
+    return TRUE;
+}
+
+static gboolean read_card32(const IconThemeCache *cache, size_t offset, guint32 *value)
+{
+    if (offset + 4 > cache->size)
+        return FALSE;
+    const unsigned char *p = cache->data + offset;
+    *value = ((guint32)p[0] << 24) | ((guint32)p[1] << 16) | ((guint32)p[2] << 8) | (guint32)p[3];
+    return TRUE;
+}
+
+// Returns the NUL-terminated string at offset, or NULL if it runs past the end of the file
+static const char *read_string(const IconThemeCache *cache, guint32 offset)
+{
+    if (offset >= cache->size)
+        return NULL;
+    if (!memchr(cache->data + offset, 0, cache->size - offset))
+        return NULL;
+    return (const char *)cache->data + offset;
+}
+
+// Same as icon_name_hash() in gtk/gtkiconcache.c, which hashes signed chars
+static guint32 icon_name_hash(const char *name)
+{
+    const signed char *p = (const signed char *)name;
+    guint32 h = (guint32)*p;
+    if (h)
+        for (p += 1; *p != '\0'; p++)
+            h = (h << 5) - h + (guint32)*p;
+    return h;
+}
+
+IconThemeCache *icon_theme_cache_open(const char *theme_dir)
+{
+    gchar *file_name = g_build_filename(theme_dir, "icon-theme.cache", NULL);
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0) {
+        g_free(file_name);
+        return NULL;
+    }
+
+    IconThemeCache *cache = NULL;
+    struct stat cache_st, dir_st;
+    if (fstat(fd, &cache_st) != 0 || stat(theme_dir, &dir_st) != 0)
+        goto out;
+    // Same staleness rule as GTK: icons added after the cache was generated touch the theme directory
+    if (cache_st.st_mtime < dir_st.st_mtime) {
+        if (debug_icons)
+            fprintf(stderr, "tint2: Ignoring stale icon cache %s\n", file_name);
+        goto out;
+    }
+    if (cache_st.st_size < 12 || (guint64)cache_st.st_size > G_MAXUINT32)
+        goto out;
+
+    void *data = mmap(NULL, (size_t)cache_st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        goto out;
+
+    cache = calloc(1, sizeof(IconThemeCache));
+    cache->path = strdup(theme_dir);
+    cache->data = data;
+    cache->size = (size_t)cache_st.st_size;
+
+    guint16 major, minor;
+    guint32 hash_offset, n_buckets, dir_list_offset, n_dirs;
+    if (!read_card16(cache, 0, &major) || !read_card16(cache, 2, &minor) || major != 1 || minor != 0 ||
+        !read_card32(cache, 4, &hash_offset) || !read_card32(cache, hash_offset, &n_buckets) || n_buckets == 0 ||
+        (size_t)hash_offset + 4 + 4 * (size_t)n_buckets > cache->size || !read_card32(cache, 8, &dir_list_offset) ||
+        !read_card32(cache, dir_list_offset, &n_dirs) ||
+        (size_t)dir_list_offset + 4 + 4 * (size_t)n_dirs > cache->size) {
+        fprintf(stderr, "tint2: Invalid icon cache %s\n", file_name);
+        icon_theme_cache_close(cache);
+        cache = NULL;
+        goto out;
+    }
+    if (debug_icons)
+        fprintf(stderr,
+                "tint2: Using icon cache %s (%u directories)\n",
+                file_name,
+                icon_theme_cache_n_directories(cache));
+
+out:
+    close(fd);
+    g_free(file_name);
+    return cache;
+}
+
+void icon_theme_cache_close(IconThemeCache *cache)
+{
+    if (!cache)
+        return;
+    munmap((void *)cache->data, cache->size);
+    free(cache->path);
+    free(cache);
+}
+
+guint32 icon_theme_cache_n_directories(const IconThemeCache *cache)
+{
+    guint32 dir_list_offset, n_dirs;
+    if (!read_card32(cache, 8, &dir_list_offset) || !read_card32(cache, dir_list_offset, &n_dirs))
+        return 0;
+    return n_dirs;
+}
+
+const char *icon_theme_cache_directory(const IconThemeCache *cache, guint32 index)
+{
+    guint32 dir_list_offset, n_dirs, dir_offset;
+    if (!read_card32(cache, 8, &dir_list_offset) || !read_card32(cache, dir_list_offset, &n_dirs) || index >= n_dirs)
+        return NULL;
+    if (!read_card32(cache, (size_t)dir_list_offset + 4 + 4 * (size_t)index, &dir_offset))
+        return NULL;
+    return read_string(cache, dir_offset);
+}
+
+int icon_theme_cache_lookup(const IconThemeCache *cache,
+                            const char *icon_name,
+                            IconThemeCacheImage *images,
+                            int max_images)
+{
+    guint32 hash_offset, n_buckets, icon_offset;
+    if (!read_card32(cache, 4, &hash_offset) || !read_card32(cache, hash_offset, &n_buckets) || n_buckets == 0)
+        return 0;
+    guint32 bucket = icon_name_hash(icon_name) % n_buckets;
+    if (!read_card32(cache, (size_t)hash_offset + 4 + 4 * (size_t)bucket, &icon_offset))
+        return 0;
+    // Every icon takes at least 12 bytes, which bounds the length of a chain even in a corrupt file
+    for (size_t steps = 0; icon_offset != ICON_CACHE_NONE && steps < cache->size / 12; steps++) {
+        guint32 chain_offset, name_offset, image_list_offset;
+        if (!read_card32(cache, icon_offset, &chain_offset) ||
+            !read_card32(cache, (size_t)icon_offset + 4, &name_offset) ||
+            !read_card32(cache, (size_t)icon_offset + 8, &image_list_offset))
+            return 0;
+        const char *name = read_string(cache, name_offset);
+        if (name && strcmp(name, icon_name) == 0) {
+            guint32 n_images;
+            if (!read_card32(cache, image_list_offset, &n_images) ||
+                (size_t)image_list_offset + 4 + 8 * (size_t)n_images > cache->size)
+                return 0;
+            int n = 0;
+            for (guint32 i = 0; i < n_images && n < max_images; i++) {
+                size_t image_offset = (size_t)image_list_offset + 4 + 8 * (size_t)i;
+                guint16 directory, flags;
+                if (!read_card16(cache, image_offset, &directory) || !read_card16(cache, image_offset + 2, &flags))
+                    break;
+                images[n].directory = directory;
+                images[n].flags = flags;
+                n++;
+            }
+            return n;
+        }
+        icon_offset = chain_offset;
+    }
+    return 0;
+}
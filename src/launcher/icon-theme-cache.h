@@ -0,0 +1,48 @@
+/**************************************************************************
+ * Reader for the icon-theme.cache files generated by gtk-update-icon-cache
+ *
+ **************************************************************************/
+
+#ifndef ICON_THEME_CACHE_H
+#define ICON_THEME_CACHE_H
+
+#include <glib.h>
+
+// Flags of an image in the cache, telling which files exist for it
+#define ICON_CACHE_HAS_XPM 1
+#define ICON_CACHE_HAS_SVG 2
+#define ICON_CACHE_HAS_PNG 4
+
+typedef struct IconThemeCache {
+    // The theme directory, e.g. /usr/share/icons/hicolor
+    char *path;
+    const unsigned char *data;
+    size_t size;
+} IconThemeCache;
+
+typedef struct IconThemeCacheImage {
+    // Index of the directory (relative to the theme directory) that holds the image
+    guint16 directory;
+    guint16 flags;
+} IconThemeCacheImage;
+
+// Maps theme_dir/icon-theme.cache into memory.
+// Returns NULL if the file does not exist, is older than the theme directory or is not valid.
+IconThemeCache *icon_theme_cache_open(const char *theme_dir);
+void icon_theme_cache_close(IconThemeCache *cache);
+
+// Returns the number of directories listed in the cache.
+guint32 icon_theme_cache_n_directories(const IconThemeCache *cache);
+
+// Returns the name of a directory of the cache, e.g. "48x48/apps", or NULL if the index is out of range.
+// Points into the mapped file, do not free.
+const char *icon_theme_cache_directory(const IconThemeCache *cache, guint32 index);
+
+// Looks up an icon name (without extension). Stores up to max_images entries in images and returns their
+// number; 0 if the icon is not in the theme.
+int icon_theme_cache_lookup(const IconThemeCache *cache,
+                            const char *icon_name,
+                            IconThemeCacheImage *images,
+                            int max_images);
+
+#endif
@@ -24,13 +24,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "apps-common.h"
 #include "common.h"
 #include "cache.h"
+#include "hash.h"
+#include "icon-theme-cache.h"
 
 gboolean debug_icons = FALSE;
 
+// Serializes the icon lookups, which may come from the icon loader threads
+static GMutex icon_theme_mutex;
+
+// Files directly in the icon locations (e.g. /usr/share/pixmaps/foo.png), built on first use.
+// Shared by all the wrappers; protected by icon_theme_mutex.
+static GHashTable *unthemed_icons = NULL;
+
+static void free_unthemed_icons()
+{
+    if (unthemed_icons)
+        g_hash_table_destroy(unthemed_icons);
+    unthemed_icons = NULL;
+}
+
 #define ICON_DIR_TYPE_SCALABLE 0
 #define ICON_DIR_TYPE_FIXED 1
 #define ICON_DIR_TYPE_THRESHOLD 2
@@ -41,8 +59,21 @@ typedef struct IconThemeDir {
     int max_size;
     int min_size;
     int threshold;
+    // Maps the names of the files found in the directory, in all the icon locations, to the position + 1
+    // of the first location that has them. Built the first time the directory is searched.
+    GHashTable *files;
 } IconThemeDir;
 
+// An icon-theme.cache file found for a theme in one of the icon locations
+typedef struct ThemeCache {
+    // Position + 1 of the icon location
+    int position;
+    IconThemeCache *cache;
+    // The IconThemeDir for each directory of the cache, or NULL if the theme does not declare it
+    IconThemeDir **dirs;
+    guint32 n_dirs;
+} ThemeCache;
+
 int parse_theme_line(char *line, char **key, char **value)
 {
     return parse_dektop_line(line, key, value);
@@ -95,6 +126,7 @@ IconTheme *make_theme(const char *name)
     theme->name = strdup(name);
     theme->list_inherits = NULL;
     theme->list_directories = NULL;
+    theme->sorted_for_size = -1;
     return theme;
 }
 
@@ -296,10 +328,32 @@ IconTheme *load_theme(const char *name)
     return load_theme_from_fs(name, theme);
 }
 
+// Frees what is known about the files of the theme: the directory listings and the icon-theme.cache files.
+// They are loaded again when needed.
+static void free_theme_index(IconTheme *theme)
+{
+    for (GSList *l_dir = theme->list_directories; l_dir; l_dir = l_dir->next) {
+        IconThemeDir *dir = (IconThemeDir *)l_dir->data;
+        if (dir->files)
+            g_hash_table_destroy(dir->files);
+        dir->files = NULL;
+    }
+    for (GSList *l_cache = theme->caches; l_cache; l_cache = l_cache->next) {
+        ThemeCache *cache = (ThemeCache *)l_cache->data;
+        icon_theme_cache_close(cache->cache);
+        free(cache->dirs);
+        free(cache);
+    }
+    g_slist_free(theme->caches);
+    theme->caches = NULL;
+    theme->caches_loaded = FALSE;
+}
+
 void free_icon_theme(IconTheme *theme)
 {
     if (!theme)
         return;
+    free_theme_index(theme);
     free(theme->name);
     theme->name = NULL;
     free(theme->description);
@@ -337,7 +391,12 @@ void free_themes(IconThemeWrapper *wrapper)
     g_slist_free(wrapper->themes_fallback);
     g_slist_free_full(wrapper->_queued, free);
     free_cache(&wrapper->_cache);
+    g_hash_table_destroy(wrapper->_cache_rechecked);
     free(wrapper);
+    // Indexed again on the next lookup, e.g. after the themes are reloaded because icons were installed
+    g_mutex_lock(&icon_theme_mutex);
+    free_unthemed_icons();
+    g_mutex_unlock(&icon_theme_mutex);
 }
 
 void test_launcher_read_theme_file()
@@ -471,11 +530,62 @@ gchar *get_icon_cache_path()
     return g_build_filename(g_get_user_cache_dir(), "tint2", "icon.cache", NULL);
 }
 
+GSList *get_icon_theme_dirs(const char *icon_theme_name)
+{
+    const char *theme_names[] = {"", icon_theme_name, "hicolor"};
+    GSList *dirs = NULL;
+    for (const GSList *location = get_icon_locations(); location; location = g_slist_next(location)) {
+        const gchar *path = (const gchar *)location->data;
+        for (size_t i = 0; i < sizeof(theme_names) / sizeof(theme_names[0]); i++)
+            dirs = g_slist_prepend(dirs, g_build_filename(path, theme_names[i], NULL));
+        // The inherited themes and the fallback themes (see load_fallbacks)
+        GDir *d = g_dir_open(path, 0, NULL);
+        if (!d)
+            continue;
+        const gchar *name;
+        while ((name = g_dir_read_name(d))) {
+            if (g_str_equal(name, icon_theme_name) || g_str_equal(name, "hicolor"))
+                continue;
+            gchar *dir = g_build_filename(path, name, NULL);
+            if (g_file_test(dir, G_FILE_TEST_IS_DIR))
+                dirs = g_slist_prepend(dirs, dir);
+            else
+                g_free(dir);
+        }
+        g_dir_close(d);
+    }
+    return g_slist_reverse(dirs);
+}
+
+// Returns a value that changes when icons are installed or removed: a hash of the modification times of the
+// directories returned by get_icon_theme_dirs. Used for the icons that could not be found, which may appear in
+// any of them.
+// As with icon-theme.cache files, changes deeper in a theme are detected when the theme directory is touched
+// (which gtk-update-icon-cache does).
+static guint64 get_icon_theme_stamp(const char *icon_theme_name)
+{
+    guint64 stamp = 0;
+    GSList *dirs = get_icon_theme_dirs(icon_theme_name);
+    for (GSList *l = dirs; l; l = l->next) {
+        struct stat st;
+        gint64 mtime[2] = {-1, -1};
+        if (stat((const char *)l->data, &st) == 0) {
+            mtime[0] = (gint64)st.st_mtim.tv_sec;
+            mtime[1] = (gint64)st.st_mtim.tv_nsec;
+        }
+        stamp = hash64(mtime, sizeof(mtime), stamp);
+    }
+    g_slist_free_full(dirs, g_free);
+    return stamp;
+}
+
 void load_icon_cache(IconThemeWrapper *wrapper)
 {
     if (wrapper->_cache.loaded)
         return;
 
+    wrapper->_cache_stamp = get_icon_theme_stamp(wrapper->icon_theme_name);
+
     fprintf(stderr, GREEN "tint2: Loading icon theme cache..." RESET "\n");
 
     gchar *cache_path = get_icon_cache_path();
@@ -485,13 +595,17 @@ void load_icon_cache(IconThemeWrapper *wrapper)
 
 void save_icon_cache(IconThemeWrapper *wrapper)
 {
-    if (!wrapper || !wrapper->_cache.dirty)
+    if (!wrapper)
         return;
 
-    fprintf(stderr, GREEN "tint2: Saving icon theme cache..." RESET "\n");
-    gchar *cache_path = get_icon_cache_path();
-    save_cache(&wrapper->_cache, cache_path);
-    g_free(cache_path);
+    g_mutex_lock(&icon_theme_mutex);
+    if (wrapper->_cache.dirty) {
+        fprintf(stderr, GREEN "tint2: Saving icon theme cache..." RESET "\n");
+        gchar *cache_path = get_icon_cache_path();
+        save_cache(&wrapper->_cache, cache_path);
+        g_free(cache_path);
+    }
+    g_mutex_unlock(&icon_theme_mutex);
 }
 
 IconThemeWrapper *load_themes(const char *icon_theme_name)
@@ -504,6 +618,8 @@ IconThemeWrapper *load_themes(const char *icon_theme_name)
     }
 
     wrapper->icon_theme_name = strdup(icon_theme_name);
+    wrapper->_cache_changed_rank = G_MAXINT;
+    wrapper->_cache_rechecked = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 
     return wrapper;
 }
@@ -573,6 +689,205 @@ char *icon_path_from_full_path(const char *s)
     return NULL;
 }
 
+// Maps the icon-theme.cache files of the theme into memory, in icon location order
+static void load_theme_caches(IconTheme *theme)
+{
+    theme->caches_loaded = TRUE;
+    if (getenv("TINT2_NO_ICON_THEME_CACHE"))
+        return;
+    GHashTable *dirs_by_name = NULL;
+    int position = 1;
+    for (const GSList *location = get_icon_locations(); location; location = g_slist_next(location), position++) {
+        gchar *theme_dir = g_build_filename(location->data, theme->name, NULL);
+        IconThemeCache *icon_cache = icon_theme_cache_open(theme_dir);
+        g_free(theme_dir);
+        if (!icon_cache)
+            continue;
+        if (!dirs_by_name) {
+            dirs_by_name = g_hash_table_new(g_str_hash, g_str_equal);
+            for (GSList *l_dir = theme->list_directories; l_dir; l_dir = l_dir->next)
+                g_hash_table_insert(dirs_by_name, ((IconThemeDir *)l_dir->data)->name, l_dir->data);
+        }
+        ThemeCache *cache = calloc(1, sizeof(ThemeCache));
+        cache->position = position;
+        cache->cache = icon_cache;
+        cache->n_dirs = icon_theme_cache_n_directories(icon_cache);
+        cache->dirs = calloc(MAX(cache->n_dirs, 1), sizeof(IconThemeDir *));
+        for (guint32 i = 0; i < cache->n_dirs; i++) {
+            const char *name = icon_theme_cache_directory(icon_cache, i);
+            if (name)
+                cache->dirs[i] = (IconThemeDir *)g_hash_table_lookup(dirs_by_name, name);
+        }
+        theme->caches = g_slist_append(theme->caches, cache);
+    }
+    if (dirs_by_name)
+        g_hash_table_destroy(dirs_by_name);
+}
+
+static gboolean theme_caches_have_position(GSList *caches, int position)
+{
+    for (GSList *l = caches; l; l = l->next) {
+        if (((ThemeCache *)l->data)->position == position)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static int extension_cache_flag(const char *extension)
+{
+    if (strcmp(extension, ".png") == 0)
+        return ICON_CACHE_HAS_PNG;
+    if (strcmp(extension, ".xpm") == 0)
+        return ICON_CACHE_HAS_XPM;
+    if (strcmp(extension, ".svg") == 0)
+        return ICON_CACHE_HAS_SVG;
+    return 0;
+}
+
+// A theme directory that has the icon according to an icon-theme.cache
+typedef struct CacheHit {
+    IconThemeDir *dir;
+    int position;
+    const char *extension;
+} CacheHit;
+
+#define MAX_CACHE_HITS 128
+
+// Looks up the icon in the icon-theme.cache files of the theme. Fills hits with at most one entry per
+// theme directory, for the first location that has the icon. Returns the number of hits.
+static int lookup_icon_in_theme_caches(IconTheme *theme, const char *icon_name, CacheHit *hits)
+{
+    if (!theme->caches)
+        return 0;
+    // The cache stores names without extension, but icon names may have one (e.g. Icon=foo.png)
+    gchar *name = g_strdup(icon_name);
+    int required_flag = 0;
+    char *suffix = strrchr(name, '.');
+    if (suffix && (required_flag = extension_cache_flag(suffix)))
+        *suffix = '\0';
+
+    int n_hits = 0;
+    IconThemeCacheImage images[MAX_CACHE_HITS];
+    for (GSList *l = theme->caches; l; l = l->next) {
+        ThemeCache *cache = (ThemeCache *)l->data;
+        int n_images = icon_theme_cache_lookup(cache->cache, name, images, MAX_CACHE_HITS);
+        for (int i = 0; i < n_images; i++) {
+            if (images[i].directory >= cache->n_dirs || !cache->dirs[images[i].directory])
+                continue;
+            const char *extension = NULL;
+            if (required_flag) {
+                if (images[i].flags & required_flag)
+                    extension = "";
+            } else {
+                for (const GSList *ext = get_icon_extensions(); ext; ext = g_slist_next(ext)) {
+                    int flag = extension_cache_flag((const char *)ext->data);
+                    if (flag && (images[i].flags & flag)) {
+                        extension = (const char *)ext->data;
+                        break;
+                    }
+                }
+            }
+            if (!extension)
+                continue;
+            gboolean found = FALSE;
+            for (int j = 0; j < n_hits && !found; j++)
+                found = hits[j].dir == cache->dirs[images[i].directory];
+            if (found || n_hits == MAX_CACHE_HITS)
+                continue;
+            hits[n_hits].dir = cache->dirs[images[i].directory];
+            hits[n_hits].position = cache->position;
+            hits[n_hits].extension = extension;
+            n_hits++;
+        }
+    }
+    g_free(name);
+    return n_hits;
+}
+
+// Lists the files of the given subdirectory of every icon location, except the locations that have an
+// icon-theme.cache for it (which are listed in caches). Returns a table that maps each file name to the
+// position + 1 of the first location that has it.
+static GHashTable *index_icon_locations(const char *subdir, GSList *caches)
+{
+    GHashTable *files = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    int position = 1;
+    for (const GSList *location = get_icon_locations(); location; location = g_slist_next(location), position++) {
+        if (theme_caches_have_position(caches, position))
+            continue;
+        gchar *path = subdir ? g_build_filename(location->data, subdir, NULL) : g_strdup(location->data);
+        GDir *d = g_dir_open(path, 0, NULL);
+        if (d) {
+            const gchar *name;
+            while ((name = g_dir_read_name(d))) {
+                if (!g_hash_table_contains(files, name))
+                    g_hash_table_insert(files, g_strdup(name), GINT_TO_POINTER(position));
+            }
+            g_dir_close(d);
+        }
+        g_free(path);
+    }
+    if (debug_icons)
+        fprintf(stderr, "tint2: Indexed %s: %u files\n", subdir ? subdir : "icon locations", g_hash_table_size(files));
+    return files;
+}
+
+// Looks up icon_name in an index built by index_icon_locations, trying all the icon extensions.
+// Returns the position + 1 of the first location that has the icon and sets extension, or returns 0.
+static int find_icon_in_index(GHashTable *files, const char *icon_name, const char **extension)
+{
+    int best_position = 0;
+    for (const GSList *ext = get_icon_extensions(); ext; ext = g_slist_next(ext)) {
+        gchar *file_name = g_strconcat(icon_name, (const char *)ext->data, NULL);
+        int position = GPOINTER_TO_INT(g_hash_table_lookup(files, file_name));
+        g_free(file_name);
+        if (position && (!best_position || position < best_position)) {
+            best_position = position;
+            *extension = (const char *)ext->data;
+        }
+    }
+    return best_position;
+}
+
+// Note: needs to be released with free().
+static char *build_icon_path(int position, const char *subdir, const char *icon_name, const char *extension)
+{
+    const char *base_name = (const char *)g_slist_nth_data((GSList *)get_icon_locations(), (guint)(position - 1));
+    size_t file_name_size =
+        strlen(base_name) + (subdir ? strlen(subdir) : 0) + strlen(icon_name) + strlen(extension) + 3;
+    char *file_name = calloc(file_name_size, 1);
+    if (subdir)
+        snprintf(file_name, file_name_size, "%s/%s/%s%s", base_name, subdir, icon_name, extension);
+    else
+        snprintf(file_name, file_name_size, "%s/%s%s", base_name, icon_name, extension);
+    return file_name;
+}
+
+// Returns the full path of the icon in the theme directory (in the first location that has it), or NULL.
+// hits are the results of lookup_icon_in_theme_caches for the theme.
+// Note: needs to be released with free().
+static char *find_icon_in_theme_directory(IconTheme *theme,
+                                          IconThemeDir *dir,
+                                          const char *icon_name,
+                                          const CacheHit *hits,
+                                          int n_hits)
+{
+    gchar *subdir = g_build_filename(theme->name, dir->name, NULL);
+    if (!dir->files)
+        dir->files = index_icon_locations(subdir, theme->caches);
+    const char *extension = NULL;
+    int position = find_icon_in_index(dir->files, icon_name, &extension);
+    for (int i = 0; i < n_hits; i++) {
+        if (hits[i].dir == dir && (!position || hits[i].position < position)) {
+            position = hits[i].position;
+            extension = hits[i].extension;
+        }
+    }
+    char *result = position ? build_icon_path(position, subdir, icon_name, extension) : NULL;
+    g_free(subdir);
+    return result;
+}
+
+
 char *get_icon_path_helper(GSList *themes, const char *icon_name, int size)
 {
     if (!icon_name)
@@ -582,9 +897,6 @@ char *get_icon_path_helper(GSList *themes, const char *icon_name, int size)
     if (result)
         return result;
 
-    const GSList *basenames = get_icon_locations();
-    const GSList *extensions = get_icon_extensions();
-
     GSList *theme;
 
     // Best size match
@@ -602,18 +914,22 @@ char *get_icon_path_helper(GSList *themes, const char *icon_name, int size)
     char *next_larger = NULL;
     GSList *next_larger_theme = NULL;
 
-    size_t file_name_size = 4096;
-    char *file_name = calloc(file_name_size, 1);
-
     for (theme = themes; theme; theme = g_slist_next(theme)) {
+        IconTheme *icon_theme = (IconTheme *)theme->data;
         if (debug_icons)
-            fprintf(stderr, "tint2: Searching theme: %s\n", ((IconTheme *)theme->data)->name);
-        ((IconTheme *)theme->data)->list_directories =
-            g_slist_sort_with_data(((IconTheme *)theme->data)->list_directories,
-                                   compare_theme_directories,
-                                   GINT_TO_POINTER(size));
+            fprintf(stderr, "tint2: Searching theme: %s\n", icon_theme->name);
+        if (!icon_theme->caches_loaded)
+            load_theme_caches(icon_theme);
+        CacheHit hits[MAX_CACHE_HITS];
+        int n_hits = lookup_icon_in_theme_caches(icon_theme, icon_name, hits);
+        // Most lookups are for the same size, so the order is usually already right
+        if (icon_theme->sorted_for_size != size) {
+            icon_theme->list_directories =
+                g_slist_sort_with_data(icon_theme->list_directories, compare_theme_directories, GINT_TO_POINTER(size));
+            icon_theme->sorted_for_size = size;
+        }
         GSList *dir;
-        for (dir = ((IconTheme *)theme->data)->list_directories; dir; dir = g_slist_next(dir)) {
+        for (dir = icon_theme->list_directories; dir; dir = g_slist_next(dir)) {
             // Closest match
             gboolean possible = directory_size_distance((IconThemeDir *)dir->data, size) < minimal_size &&
                                 (!best_file_theme ? TRUE : theme == best_file_theme);
@@ -625,62 +941,42 @@ char *get_icon_path_helper(GSList *themes, const char *icon_name, int size)
                 continue;
             if (debug_icons)
                 fprintf(stderr, "tint2: Searching directory: %s\n", ((IconThemeDir *)dir->data)->name);
-            const GSList *base;
-            for (base = basenames; base; base = g_slist_next(base)) {
-                for (const GSList *ext = extensions; ext; ext = g_slist_next(ext)) {
-                    char *base_name = (char *)base->data;
-                    char *theme_name = ((IconTheme *)theme->data)->name;
-                    char *dir_name = ((IconThemeDir *)dir->data)->name;
-                    char *extension = (char *)ext->data;
-                    if (strlen(base_name) + strlen(theme_name) + strlen(dir_name) + strlen(icon_name) +
-                            strlen(extension) + 100 >
-                        file_name_size) {
-                        file_name_size = strlen(base_name) + strlen(theme_name) + strlen(dir_name) + strlen(icon_name) +
-                                         strlen(extension) + 100;
-                        file_name = realloc(file_name, file_name_size);
-                    }
-                    file_name[0] = 0;
-                    // filename = directory/$(themename)/subdirectory/iconname.extension
-                    snprintf(file_name, (size_t)file_name_size, "%s/%s/%s/%s%s", base_name, theme_name, dir_name, icon_name, extension);
-                    if (debug_icons)
-                        fprintf(stderr, "tint2: Checking %s\n", file_name);
-                    if (g_file_test(file_name, G_FILE_TEST_EXISTS)) {
-                        if (debug_icons)
-                            fprintf(stderr, "tint2: Found potential match: %s\n", file_name);
-                        // Closest match
-                        if (directory_size_distance((IconThemeDir *)dir->data, size) < minimal_size &&
-                            (!best_file_theme ? 1 : theme == best_file_theme)) {
-                            if (best_file_name) {
-                                free(best_file_name);
-                                best_file_name = NULL;
-                            }
-                            best_file_name = strdup(file_name);
-                            minimal_size = directory_size_distance((IconThemeDir *)dir->data, size);
-                            best_file_theme = theme;
-                            if (debug_icons)
-                                fprintf(stderr, "tint2: best_file_name = %s; minimal_size = %d\n", best_file_name, minimal_size);
-                        }
-                        // Next larger match
-                        if (((IconThemeDir *)dir->data)->size >= size &&
-                            (next_larger_size == -1 || ((IconThemeDir *)dir->data)->size < next_larger_size) &&
-                            (!next_larger_theme ? 1 : theme == next_larger_theme)) {
-                            if (next_larger) {
-                                free(next_larger);
-                                next_larger = NULL;
-                            }
-                            next_larger = strdup(file_name);
-                            next_larger_size = ((IconThemeDir *)dir->data)->size;
-                            next_larger_theme = theme;
-                            if (debug_icons)
-                                fprintf(stderr, "tint2: next_larger = %s; next_larger_size = %d\n", next_larger, next_larger_size);
-                        }
-                    }
+            char *file_name =
+                find_icon_in_theme_directory(icon_theme, (IconThemeDir *)dir->data, icon_name, hits, n_hits);
+            if (!file_name)
+                continue;
+            if (debug_icons)
+                fprintf(stderr, "tint2: Found potential match: %s\n", file_name);
+            // Closest match
+            if (directory_size_distance((IconThemeDir *)dir->data, size) < minimal_size &&
+                (!best_file_theme ? 1 : theme == best_file_theme)) {
+                if (best_file_name) {
+                    free(best_file_name);
+                    best_file_name = NULL;
                 }
+                best_file_name = strdup(file_name);
+                minimal_size = directory_size_distance((IconThemeDir *)dir->data, size);
+                best_file_theme = theme;
+                if (debug_icons)
+                    fprintf(stderr, "tint2: best_file_name = %s; minimal_size = %d\n", best_file_name, minimal_size);
+            }
+            // Next larger match
+            if (((IconThemeDir *)dir->data)->size >= size &&
+                (next_larger_size == -1 || ((IconThemeDir *)dir->data)->size < next_larger_size) &&
+                (!next_larger_theme ? 1 : theme == next_larger_theme)) {
+                if (next_larger) {
+                    free(next_larger);
+                    next_larger = NULL;
+                }
+                next_larger = strdup(file_name);
+                next_larger_size = ((IconThemeDir *)dir->data)->size;
+                next_larger_theme = theme;
+                if (debug_icons)
+                    fprintf(stderr, "tint2: next_larger = %s; next_larger_size = %d\n", next_larger, next_larger_size);
             }
+            free(file_name);
         }
     }
-    free(file_name);
-    file_name = NULL;
     if (next_larger) {
         free(best_file_name);
         return next_larger;
@@ -690,34 +986,42 @@ char *get_icon_path_helper(GSList *themes, const char *icon_name, int size)
     }
 
     // Look in unthemed icons
-    {
-        if (debug_icons)
-            fprintf(stderr, "tint2: Searching unthemed icons\n");
-        for (const GSList *base = basenames; base; base = g_slist_next(base)) {
-            for (const GSList *ext = extensions; ext; ext = g_slist_next(ext)) {
-                char *base_name = (char *)base->data;
-                char *extension = (char *)ext->data;
-                size_t file_name_size2 = strlen(base_name) + strlen(icon_name) + strlen(extension) + 100;
-                file_name = calloc(file_name_size2, 1);
-                // filename = directory/iconname.extension
-                snprintf(file_name, file_name_size2, "%s/%s%s", base_name, icon_name, extension);
-                if (debug_icons)
-                    fprintf(stderr, "tint2: Checking %s\n", file_name);
-                if (g_file_test(file_name, G_FILE_TEST_EXISTS)) {
-                    if (debug_icons)
-                        fprintf(stderr, "tint2: Found %s\n", file_name);
-                    return file_name;
-                } else {
-                    free(file_name);
-                    file_name = NULL;
-                }
-            }
+    if (debug_icons)
+        fprintf(stderr, "tint2: Searching unthemed icons\n");
+    if (!unthemed_icons)
+        unthemed_icons = index_icon_locations(NULL, NULL);
+    const char *extension = NULL;
+    int position = find_icon_in_index(unthemed_icons, icon_name, &extension);
+    result = position ? build_icon_path(position, NULL, icon_name, extension) : NULL;
+    if (result && debug_icons)
+        fprintf(stderr, "tint2: Found %s\n", result);
+    return result;
+}
+
+// Returns the stamp of the directory an icon file was found in: the theme directory (e.g. /usr/share/icons/hicolor)
+// for themed icons, the icon location (e.g. /usr/share/pixmaps) for unthemed icons.
+static guint64 get_icon_path_stamp(const char *path)
+{
+    for (const GSList *location = get_icon_locations(); location; location = g_slist_next(location)) {
+        gchar *prefix = g_build_filename(location->data, "", NULL);
+        gboolean found = g_str_has_prefix(path, prefix);
+        if (!found) {
+            g_free(prefix);
+            continue;
         }
+        const char *slash = strchr(path + strlen(prefix), '/');
+        gchar *dir = slash ? g_strndup(path, (gsize)(slash - path)) : g_strdup(location->data);
+        guint64 stamp = get_file_stamp(dir);
+        g_free(dir);
+        g_free(prefix);
+        return stamp;
     }
-
-    return NULL;
+    return get_file_stamp(path);
 }
 
+static int get_icon_theme_rank(IconThemeWrapper *wrapper, const char *path);
+
+// Returns an empty string if the icon is known to be missing.
 char *get_icon_path_from_cache(IconThemeWrapper *wrapper, const char *icon_name, int size)
 {
     if (!wrapper || !icon_name || strlen(icon_name) == 0)
@@ -726,7 +1030,21 @@ char *get_icon_path_from_cache(IconThemeWrapper *wrapper, const char *icon_name,
     load_icon_cache(wrapper);
 
     gchar *key = g_strdup_printf("%s\t%s\t%d", wrapper->icon_theme_name, icon_name, size);
-    const gchar *value = get_from_cache(&wrapper->_cache, key);
+    guint64 stamp = 0;
+    const gchar *value = get_from_cache_with_stamp(&wrapper->_cache, key, &stamp);
+    if (value && !value[0]) {
+        if (stamp != wrapper->_cache_stamp)
+            value = NULL;
+    } else if (value) {
+        // The file may also have been removed since the theme directory was touched
+        if (stamp != get_icon_path_stamp(value) || access(value, R_OK) != 0)
+            value = NULL;
+        else if (wrapper->_cache_changed_rank != G_MAXINT && !g_hash_table_contains(wrapper->_cache_rechecked, key) &&
+                 get_icon_theme_rank(wrapper, value) >= wrapper->_cache_changed_rank)
+            value = NULL;
+    }
+    if (!value && wrapper->_cache_changed_rank != G_MAXINT)
+        g_hash_table_add(wrapper->_cache_rechecked, g_strdup(key));
     g_free(key);
 
     if (!value) {
@@ -738,18 +1056,16 @@ char *get_icon_path_from_cache(IconThemeWrapper *wrapper, const char *icon_name,
         return NULL;
     }
 
-    if (!g_file_test(value, G_FILE_TEST_EXISTS))
-        return NULL;
-
     // fprintf(stderr, "tint2: Icon path found in cache: theme = %s, icon = %s, size = %d, path = %s\n",
     // wrapper->icon_theme_name, icon_name, size, value);
 
     return strdup(value);
 }
 
+// An empty path records that the icon could not be found.
 void add_icon_path_to_cache(IconThemeWrapper *wrapper, const char *icon_name, int size, const char *path)
 {
-    if (!wrapper || !icon_name || strlen(icon_name) == 0 || !path || strlen(path) == 0)
+    if (!wrapper || !icon_name || strlen(icon_name) == 0 || !path)
         return;
 
     fprintf(stderr,
@@ -762,11 +1078,14 @@ void add_icon_path_to_cache(IconThemeWrapper *wrapper, const char *icon_name, in
     load_icon_cache(wrapper);
 
     gchar *key = g_strdup_printf("%s\t%s\t%d", wrapper->icon_theme_name, icon_name, size);
-    add_to_cache(&wrapper->_cache, key, path);
+    add_to_cache(&wrapper->_cache, key, path, path[0] ? get_icon_path_stamp(path) : wrapper->_cache_stamp);
     g_free(key);
 }
 
-char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size, gboolean use_fallbacks)
+static char *get_icon_path_unlocked(IconThemeWrapper *wrapper,
+                                    const char *icon_name,
+                                    int size,
+                                    gboolean use_fallbacks)
 {
     if (debug_icons)
         fprintf(stderr,
@@ -785,6 +1104,12 @@ char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size,
         goto notfound;
 
     char *path = get_icon_path_from_cache(wrapper, icon_name, size);
+    if (path && strlen(path) == 0) {
+        if (debug_icons)
+            fprintf(stderr, "Icon known to be missing from cache: %s\n", icon_name);
+        free(path);
+        goto default_icon;
+    }
     if (path) {
         if (debug_icons)
             fprintf(stderr,
@@ -813,12 +1138,125 @@ char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size,
         add_icon_path_to_cache(wrapper, icon_name, size, path);
         return path;
     }
+    // Remember the failure, so that the next lookups do not search all the themes again
+    add_icon_path_to_cache(wrapper, icon_name, size, "");
 
 notfound:
     fprintf(stderr, RED "tint2: Could not find icon '%s', using default." RESET "\n", icon_name);
+default_icon:
     path = get_icon_path_helper(wrapper->themes, DEFAULT_ICON, size);
     if (path)
         return path;
     path = get_icon_path_helper(wrapper->themes_fallback, DEFAULT_ICON, size);
     return path;
 }
+
+char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size, gboolean use_fallbacks)
+{
+    g_mutex_lock(&icon_theme_mutex);
+    char *path = get_icon_path_unlocked(wrapper, icon_name, size, use_fallbacks);
+    g_mutex_unlock(&icon_theme_mutex);
+    return path;
+}
+
+// Returns the position of the theme that provides the icon file path in the search order (the default themes,
+// then the fallback themes), or G_MAXINT if it does not come from a theme.
+static int get_icon_theme_rank(IconThemeWrapper *wrapper, const char *path)
+{
+    GSList *lists[] = {wrapper->themes, wrapper->themes_fallback};
+    int rank = 0;
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        for (GSList *l = lists[i]; l; l = l->next, rank++) {
+            IconTheme *theme = (IconTheme *)l->data;
+            for (const GSList *location = get_icon_locations(); location; location = g_slist_next(location)) {
+                gchar *prefix = g_build_filename(location->data, theme->name, "", NULL);
+                gboolean found = g_str_has_prefix(path, prefix);
+                g_free(prefix);
+                if (found)
+                    return rank;
+            }
+        }
+    }
+    return G_MAXINT;
+}
+
+// Returns TRUE if all the names are icon files (as opposed to theme directories)
+static gboolean names_are_icon_files(GHashTable *names)
+{
+    GHashTableIter iter;
+    gpointer name;
+    g_hash_table_iter_init(&iter, names);
+    while (g_hash_table_iter_next(&iter, &name, NULL)) {
+        gboolean icon_file = FALSE;
+        for (const GSList *ext = get_icon_extensions(); ext && !icon_file; ext = g_slist_next(ext)) {
+            const char *extension = (const char *)ext->data;
+            icon_file = strlen(extension) > 0 && g_str_has_suffix((const char *)name, extension);
+        }
+        if (!icon_file)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+int icon_theme_dir_changed(IconThemeWrapper *wrapper, const char *dir, GHashTable *names)
+{
+    if (!wrapper || !names)
+        return -1;
+
+    g_mutex_lock(&icon_theme_mutex);
+    int rank = -1;
+    int num_themes = (int)(g_slist_length(wrapper->themes) + g_slist_length(wrapper->themes_fallback));
+    gchar *parent = g_path_get_dirname(dir);
+    gchar *name = g_path_get_basename(dir);
+    if (str_list_contains(get_icon_locations(), dir)) {
+        // Only the unthemed icons are affected, unless themes have been installed or removed
+        if (names_are_icon_files(names)) {
+            free_unthemed_icons();
+            rank = num_themes;
+        }
+    } else if (str_list_contains(get_icon_locations(), parent) && !g_hash_table_contains(names, "index.theme")) {
+        // The directories of the theme are the same, only its files changed
+        rank = num_themes;
+        GSList *lists[] = {wrapper->themes, wrapper->themes_fallback};
+        int theme_rank = 0;
+        for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+            for (GSList *l = lists[i]; l; l = l->next, theme_rank++) {
+                IconTheme *theme = (IconTheme *)l->data;
+                if (g_str_equal(theme->name, name)) {
+                    free_theme_index(theme);
+                    rank = MIN(rank, theme_rank);
+                }
+            }
+        }
+    }
+    if (rank >= 0) {
+        wrapper->_cache_stamp = get_icon_theme_stamp(wrapper->icon_theme_name);
+        wrapper->_cache_changed_rank = MIN(wrapper->_cache_changed_rank, rank);
+        g_hash_table_remove_all(wrapper->_cache_rechecked);
+    }
+    g_free(parent);
+    g_free(name);
+    g_mutex_unlock(&icon_theme_mutex);
+    return rank;
+}
+
+gboolean icon_may_change(IconThemeWrapper *wrapper, const char *icon_name, const char *path, int rank)
+{
+    if (!path || !icon_name)
+        return TRUE;
+    if (is_full_path(icon_name))
+        return FALSE;
+    // The default icon is shown instead of a missing icon, which may have been installed anywhere
+    gchar *base_name = g_path_get_basename(path);
+    char *dot = strrchr(base_name, '.');
+    if (dot)
+        *dot = '\0';
+    gboolean missing = !g_str_equal(base_name, icon_name);
+    g_free(base_name);
+    if (missing)
+        return TRUE;
+    g_mutex_lock(&icon_theme_mutex);
+    gboolean result = get_icon_theme_rank(wrapper, path) >= rank;
+    g_mutex_unlock(&icon_theme_mutex);
+    return result;
+}
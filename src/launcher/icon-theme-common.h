@@ -21,6 +21,14 @@ typedef struct IconThemeWrapper {
     // Fallback themes are loaded lazily when needed.
     gboolean _fallback_loaded;
     Cache _cache;
+    // Stamp of the cache entries of missing icons that are valid for the currently installed icons.
+    // The entries of icons that were found are stamped with their theme directory instead.
+    guint64 _cache_stamp;
+    // Position of the first theme that changed since the cache was loaded (see icon_theme_dir_changed), or
+    // G_MAXINT: the cached paths found in it or in the themes searched after it are looked up again, once.
+    int _cache_changed_rank;
+    // Keys looked up again since the last change
+    GHashTable *_cache_rechecked;
     // List of icon theme names that have been queued for loading.
     // Used to avoid loading the same theme twice, and to avoid cycles.
     GSList *_queued;
@@ -31,6 +39,10 @@ typedef struct IconTheme {
     char *description;
     GSList *list_inherits;    // each item is a char* (theme name)
     GSList *list_directories; // each item is an IconThemeDir*
+    // The icon size for which list_directories was last sorted, or -1
+    int sorted_for_size;
+    GSList *caches; // each item is a ThemeCache*, for the icon-theme.cache files of the theme
+    gboolean caches_loaded;
 } IconTheme;
 
 // Parses a line of the form "key = value". Modifies the line.
@@ -50,6 +62,7 @@ void free_icon_theme(IconTheme *theme);
 #define DEFAULT_ICON "application-x-executable"
 
 // Returns the full path to an icon file (or NULL) given the list of icon themes to search and the icon name
+// Thread safe, but the wrapper must not be freed while lookups are in progress.
 // Note: needs to be released with free().
 char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size, gboolean use_fallbacks);
 
@@ -57,6 +70,22 @@ char *get_icon_path(IconThemeWrapper *wrapper, const char *icon_name, int size,
 // Do not free the result, it is cached.
 const GSList *get_icon_locations();
 
+// Returns the directories in which installing or removing icons of the theme icon_theme_name is noticed:
+// the icon locations, and in each of them the directories of the theme and of hicolor (not all exist), and of
+// all the other themes, which may be inherited or used as fallbacks.
+// Free the result with g_slist_free_full(dirs, g_free).
+GSList *get_icon_theme_dirs(const char *icon_theme_name);
+
+// To be called when the directory dir (one of get_icon_theme_dirs) changed. names are the names of the entries
+// that changed, or NULL if unknown. Forgets the files of the theme stored in dir, if it is loaded.
+// Returns the position of that theme in the search order: only the icons found in it or in the themes searched
+// after it may change (see icon_may_change). Returns -1 if the themes must be loaded again.
+int icon_theme_dir_changed(IconThemeWrapper *wrapper, const char *dir, GHashTable *names);
+
+// Returns TRUE if the icon icon_name, last found at path (NULL if not found), may change after
+// icon_theme_dir_changed returned rank.
+gboolean icon_may_change(IconThemeWrapper *wrapper, const char *icon_name, const char *path, int rank);
+
 extern gboolean debug_icons;
 
 #endif
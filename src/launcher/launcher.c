@@ -40,6 +40,9 @@
 #include "launcher.h"
 #include "apps-common.h"
 #include "icon-theme-common.h"
+#include "icon-loader.h"
+#include "fswatch.h"
+#include "startup.h"
 
 int launcher_enabled;
 int launcher_max_icon_size;
@@ -61,10 +64,13 @@ void launcher_icon_dump_geometry(void *obj, int indent);
 void launcher_reload_icon(Launcher *launcher, LauncherIcon *launcherIcon);
 void launcher_reload_icon_image(Launcher *launcher, LauncherIcon *launcherIcon);
 void launcher_reload_hidden_icons(Launcher *launcher);
+void launcher_watch_files(Launcher *launcher);
 void launcher_icon_on_change_layout(void *obj);
 int launcher_compute_desired_size(void *obj);
 
 void relayout_launcher();
+static void launcher_files_changed(const char *dir, GHashTable *names, void *userdata);
+static void icon_themes_changed(const char *dir, GHashTable *names, void *userdata);
 
 void default_launcher()
 {
@@ -124,6 +130,9 @@ void init_launcher_panel(void *p)
 
 void free_icon_themes()
 {
+    fswatch_remove(icon_themes_changed, NULL);
+    icon_loader_stop();
+    icon_pack_free();
     free_themes(icon_theme_wrapper);
     icon_theme_wrapper = NULL;
 }
@@ -153,10 +162,12 @@ void cleanup_launcher()
 
 void cleanup_launcher_theme(Launcher *launcher)
 {
+    fswatch_remove(launcher_files_changed, launcher);
     free_area(&launcher->area);
     for (GSList *l = launcher->list_icons; l; l = l->next) {
         LauncherIcon *launcherIcon = (LauncherIcon *)l->data;
         if (launcherIcon) {
+            icon_loader_cancel(launcherIcon);
             free_icon(launcherIcon->image);
             free_icon(launcherIcon->image_hover);
             free_icon(launcherIcon->image_pressed);
@@ -257,6 +268,7 @@ gboolean resize_launcher(void *obj)
         }
     }
     save_icon_cache(icon_theme_wrapper);
+    icon_pack_save();
 
     int count = 0;
     gboolean needs_repositioning = FALSE;
@@ -405,26 +417,8 @@ Imlib_Image scale_icon(Imlib_Image original, int icon_size)
         imlib_context_set_color(255, 255, 255, 255);
         imlib_image_fill_rectangle(0, 0, icon_size, icon_size);
     } else if (original) {
-        imlib_context_set_image(original);
-        icon_scaled = imlib_create_cropped_scaled_image(0,
-                                                        0,
-                                                        imlib_image_get_width(),
-                                                        imlib_image_get_height(),
-                                                        icon_size,
-                                                        icon_size);
-
-        imlib_context_set_image(icon_scaled);
-        imlib_image_set_has_alpha(1);
-        DATA32 *data = imlib_image_get_data();
-        adjust_asb(data,
-                   icon_size,
-                   icon_size,
-                   launcher_alpha / 100.0,
-                   launcher_saturation / 100.0,
-                   launcher_brightness / 100.0);
-        imlib_image_put_back_data(data);
-
-        imlib_context_set_image(icon_scaled);
+        icon_scaled =
+            scale_and_adjust_icon(original, icon_size, launcher_alpha, launcher_saturation, launcher_brightness);
     } else {
         icon_scaled = imlib_create_image(icon_size, icon_size);
         imlib_context_set_image(icon_scaled);
@@ -434,6 +428,22 @@ Imlib_Image scale_icon(Imlib_Image original, int icon_size)
     return icon_scaled;
 }
 
+Imlib_Image placeholder_icon(int icon_size)
+{
+    // A faint square, shown while the real icon is being loaded
+    int size = MAX(icon_size, 1);
+    DATA32 *data = calloc((size_t)size * size, sizeof(DATA32));
+    for (int i = 0; i < size * size; i++)
+        data[i] = 0x20ffffff;
+    Imlib_Image icon = imlib_create_image_using_copied_data(size, size, data);
+    free(data);
+    if (icon) {
+        imlib_context_set_image(icon);
+        imlib_image_set_has_alpha(1);
+    }
+    return icon;
+}
+
 void free_icon(Imlib_Image icon)
 {
     if (icon) {
@@ -494,12 +504,62 @@ void launcher_load_icons(Launcher *launcher)
         }
         launcherIcon->config_path = strdup(app->data);
         add_area(&launcherIcon->area, (Area *)launcher);
-        launcher->list_icons = g_slist_append(launcher->list_icons, launcherIcon);
+        launcher->list_icons = g_slist_prepend(launcher->list_icons, launcherIcon);
         launcherIcon->icon_size = launcher->icon_size;
         launcher_reload_icon(launcher, launcherIcon);
         instantiate_area_gradients(&launcherIcon->area);
         app = g_slist_next(app);
     }
+    launcher->list_icons = g_slist_reverse(launcher->list_icons);
+    save_desktop_entry_cache();
+    launcher_watch_files(launcher);
+}
+
+// Reloads the icons whose desktop files changed
+static void launcher_files_changed(const char *dir, GHashTable *names, void *userdata)
+{
+    Launcher *launcher = (Launcher *)userdata;
+    for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location)) {
+        if (g_str_equal(dir, location->data)) {
+            apps_locations_changed();
+            break;
+        }
+    }
+    gboolean changed = FALSE;
+    for (GSList *l = launcher->list_icons; l; l = l->next) {
+        LauncherIcon *launcherIcon = (LauncherIcon *)l->data;
+        gchar *name = g_path_get_basename(launcherIcon->config_path);
+        if (!names || g_hash_table_contains(names, name)) {
+            launcher_reload_icon(launcher, launcherIcon);
+            changed = TRUE;
+        }
+        g_free(name);
+    }
+    if (changed) {
+        save_desktop_entry_cache();
+        launcher->area.resize_needed = 1;
+        schedule_panel_redraw();
+    }
+}
+
+void launcher_watch_files(Launcher *launcher)
+{
+    // Entries given by name are looked up in the application directories, which are watched as a whole
+    gboolean watch_apps_locations = FALSE;
+    for (GSList *l = launcher->list_icons; l; l = l->next) {
+        LauncherIcon *launcherIcon = (LauncherIcon *)l->data;
+        if (strchr(launcherIcon->config_path, '/')) {
+            gchar *dir = g_path_get_dirname(launcherIcon->config_path);
+            fswatch_add(dir, launcher_files_changed, launcher);
+            g_free(dir);
+        } else {
+            watch_apps_locations = TRUE;
+        }
+    }
+    if (watch_apps_locations) {
+        for (const GSList *location = get_apps_locations(); location; location = g_slist_next(location))
+            fswatch_add(location->data, launcher_files_changed, launcher);
+    }
 }
 
 void launcher_reload_icon(Launcher *launcher, LauncherIcon *launcherIcon)
@@ -518,9 +578,14 @@ void launcher_reload_icon(Launcher *launcher, LauncherIcon *launcherIcon)
             launcherIcon->cwd = NULL;
         launcherIcon->start_in_terminal = entry.start_in_terminal;
         launcherIcon->startup_notification = entry.startup_notification;
-        if (launcherIcon->icon_name)
-            free(launcherIcon->icon_name);
-        launcherIcon->icon_name = entry.icon ? strdup(entry.icon) : strdup(DEFAULT_ICON);
+        const char *icon_name = entry.icon ? entry.icon : DEFAULT_ICON;
+        // Clicks reload the entry; the image only needs to be reloaded if the icon has changed
+        gboolean icon_changed = !launcherIcon->icon_name || strcmp(launcherIcon->icon_name, icon_name) != 0 ||
+                                !launcherIcon->image || !launcherIcon->area.on_screen;
+        free(launcherIcon->icon_name);
+        launcherIcon->icon_name = strdup(icon_name);
+        g_free(launcherIcon->icon_tooltip);
+        launcherIcon->icon_tooltip = NULL;
         if (entry.name) {
             if (entry.generic_name) {
                 launcherIcon->icon_tooltip = g_strdup_printf("%s (%s)", entry.name, entry.generic_name);
@@ -534,7 +599,8 @@ void launcher_reload_icon(Launcher *launcher, LauncherIcon *launcherIcon)
                 launcherIcon->icon_tooltip = g_strdup_printf("%s", entry.exec);
             }
         }
-        launcher_reload_icon_image(launcher, launcherIcon);
+        if (icon_changed)
+            launcher_reload_icon_image(launcher, launcherIcon);
         show(&launcherIcon->area);
     } else {
         hide(&launcherIcon->area);
@@ -551,28 +617,23 @@ void launcher_reload_hidden_icons(Launcher *launcher)
     }
 }
 
-void launcher_reload_icon_image(Launcher *launcher, LauncherIcon *launcherIcon)
+IconEffects launcher_icon_effects()
+{
+    IconEffects effects = {launcher_alpha, launcher_saturation, launcher_brightness};
+    return effects;
+}
+
+// Takes ownership of image (already scaled and adjusted) and icon_path
+static void launcher_set_icon_image(LauncherIcon *launcherIcon, Imlib_Image image, char *icon_path)
 {
     free_icon(launcherIcon->image);
     free_icon(launcherIcon->image_hover);
     free_icon(launcherIcon->image_pressed);
-    launcherIcon->image = NULL;
-
-    char *new_icon_path = get_icon_path(icon_theme_wrapper, launcherIcon->icon_name, launcherIcon->icon_size, TRUE);
-    if (new_icon_path)
-        launcherIcon->image = load_image(new_icon_path, TRUE);
-    // On loading error, fallback to default
-    if (!launcherIcon->image) {
-        free(new_icon_path);
-        new_icon_path = get_icon_path(icon_theme_wrapper, DEFAULT_ICON, launcherIcon->icon_size, TRUE);
-        if (new_icon_path)
-            launcherIcon->image = load_image(new_icon_path, TRUE);
-    }
-    Imlib_Image original = launcherIcon->image;
-    launcherIcon->image = scale_icon(launcherIcon->image, launcherIcon->icon_size);
-    free_icon(original);
+    launcherIcon->image_hover = NULL;
+    launcherIcon->image_pressed = NULL;
+    launcherIcon->image = image ? image : scale_icon(NULL, launcherIcon->icon_size);
     free(launcherIcon->icon_path);
-    launcherIcon->icon_path = new_icon_path;
+    launcherIcon->icon_path = icon_path;
     // fprintf(stderr, "tint2: launcher.c %d: Using icon %s\n", __LINE__, launcherIcon->icon_path);
 
     if (panel_config.mouse_effects) {
@@ -588,16 +649,85 @@ void launcher_reload_icon_image(Launcher *launcher, LauncherIcon *launcherIcon)
     schedule_redraw(&launcherIcon->area);
 }
 
+static void launcher_icon_loaded(void *owner, Imlib_Image image, const char *path)
+{
+    launcher_set_icon_image((LauncherIcon *)owner, image, path ? strdup(path) : NULL);
+}
+
+void launcher_reload_icon_image(Launcher *launcher, LauncherIcon *launcherIcon)
+{
+    IconEffects effects = launcher_icon_effects();
+    if (icon_loader_request(launcherIcon,
+                            icon_theme_wrapper,
+                            launcherIcon->icon_name,
+                            NULL,
+                            launcherIcon->icon_size,
+                            &effects,
+                            launcher_icon_loaded)) {
+        // Keep showing the current icon if it has the right size, otherwise a placeholder until the new one loads
+        gboolean keep = FALSE;
+        if (launcherIcon->image) {
+            imlib_context_set_image(launcherIcon->image);
+            keep = imlib_image_get_width() == launcherIcon->icon_size;
+        }
+        if (!keep) {
+            free_icon(launcherIcon->image);
+            free_icon(launcherIcon->image_hover);
+            free_icon(launcherIcon->image_pressed);
+            launcherIcon->image = placeholder_icon(launcherIcon->icon_size);
+            launcherIcon->image_hover = NULL;
+            launcherIcon->image_pressed = NULL;
+            schedule_redraw(&launcherIcon->area);
+        }
+        return;
+    }
+
+    char *new_icon_path;
+    Imlib_Image image = icon_loader_load(icon_theme_wrapper,
+                                         launcherIcon->icon_name,
+                                         NULL,
+                                         launcherIcon->icon_size,
+                                         &effects,
+                                         &new_icon_path);
+    launcher_set_icon_image(launcherIcon, image, new_icon_path);
+}
+
 void load_icon_themes()
 {
     if (icon_theme_wrapper)
         return;
+    startup_mark("panels");
     icon_theme_wrapper =
         load_themes(launcher_icon_theme_override
                         ? (icon_theme_name_config ? icon_theme_name_config
                                                   : icon_theme_name_xsettings ? icon_theme_name_xsettings : "hicolor")
                         : (icon_theme_name_xsettings ? icon_theme_name_xsettings
                                                      : icon_theme_name_config ? icon_theme_name_config : "hicolor"));
+
+    GSList *dirs = get_icon_theme_dirs(icon_theme_wrapper->icon_theme_name);
+    for (GSList *l = dirs; l; l = l->next)
+        fswatch_add((const char *)l->data, icon_themes_changed, NULL);
+    g_slist_free_full(dirs, g_free);
+    startup_mark("icon themes");
+}
+
+static void icon_themes_changed(const char *dir, GHashTable *names, void *userdata)
+{
+    int rank = icon_theme_dir_changed(icon_theme_wrapper, dir, names);
+    if (rank < 0) {
+        reload_icon_themes();
+        return;
+    }
+    for (int i = 0; i < num_panels; i++) {
+        Launcher *launcher = &panels[i].launcher;
+        for (GSList *l = launcher->list_icons; l; l = l->next) {
+            LauncherIcon *launcherIcon = (LauncherIcon *)l->data;
+            if (icon_may_change(icon_theme_wrapper, launcherIcon->icon_name, launcherIcon->icon_path, rank))
+                launcher_reload_icon_image(launcher, launcherIcon);
+        }
+    }
+    // Buttons do not remember where their icon was found, and there are few of them
+    button_default_icon_theme_changed();
 }
 
 void launcher_default_icon_theme_changed()
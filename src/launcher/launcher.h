@@ -11,10 +11,13 @@
 #include "area.h"
 #include "xsettings-client.h"
 #include "icon-theme-common.h"
+#include "icon-pack.h"
 
 extern IconThemeWrapper *icon_theme_wrapper;
 void load_icon_themes();
 void free_icon_themes();
+// The adjustments applied to launcher and button icons
+IconEffects launcher_icon_effects();
 
 typedef struct Launcher {
     // always start with area
@@ -32,6 +32,7 @@
 #include "server.h"
 #include "panel.h"
 #include "launcher.h"
+#include "window.h"
 
 struct _XSettingsClient {
     Display *display;
@@ -105,6 +106,8 @@ static void notify_changes(XSettingsClient *client, XSettingsList *old_list)
 
 static int ignore_errors(Display *display, XErrorEvent *event)
 {
+    if (display != server.display)
+        return thumbnail_x_error_handler(display, event);
     return True;
 }
 
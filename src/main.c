@@ -30,6 +30,7 @@
 #include <X11/Xatom.h>
 #include <X11/Xlocale.h>
 #include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xrandr.h>
 #include <Imlib2.h>
 #include <signal.h>
 #include <sys/types.h>
@@ -45,15 +46,20 @@
 #include "config.h"
 #include "drag_and_drop.h"
 #include "fps_distribution.h"
+#include "frame_cache.h"
+#include "fswatch.h"
+#include "icon-loader.h"
 #include "init.h"
 #include "launcher.h"
 #include "mouse_actions.h"
 #include "panel.h"
 #include "server.h"
 #include "signals.h"
+#include "startup.h"
 #include "systraybar.h"
 #include "task.h"
 #include "taskbar.h"
+#include "thumbnail_worker.h"
 #include "tooltip.h"
 #include "timer.h"
 #include "tracing.h"
@@ -298,8 +304,8 @@ void handle_event_property_notify(XEvent *e)
         }
         // Window icon changed
         else if (at == server.atom._NET_WM_ICON) {
-            task_update_icon(task);
-            schedule_panel_redraw();
+            if (task_update_icon(task))
+                schedule_panel_redraw();
         }
         // Window desktop changed
         else if (at == server.atom._NET_WM_DESKTOP) {
@@ -315,8 +321,10 @@ void handle_event_property_notify(XEvent *e)
                 add_urgent(task);
             }
             XFree(wmhints);
-            task_update_icon(task);
-            schedule_panel_redraw();
+            // The WM_HINTS icon pixmap is used only when the window has no _NET_WM_ICON,
+            // so urgency changes do not need to reload the icon
+            if (!task->icon_location.width && task_update_icon(task))
+                schedule_panel_redraw();
         }
 
         if (!server.got_root_win)
@@ -340,7 +348,9 @@ void handle_event_configure_notify(XEvent *e)
 
     // change in root window (xrandr)
     if (win == server.root_win) {
-        emit_self_restart("configuration change in the root window");
+        XRRUpdateConfiguration(e);
+        if (!update_panel_monitors())
+            emit_self_restart("monitor configuration change");
         return;
     }
 
@@ -351,27 +361,12 @@ void handle_event_configure_notify(XEvent *e)
     }
 
     // 'win' move in another monitor
-    if (num_panels > 1 || hide_task_diff_monitor) {
-        Task *task = get_task(win);
-        if (task) {
-            Panel *p = task->area.panel;
-            int monitor = get_window_monitor(win);
-            if ((hide_task_diff_monitor && p->monitor != monitor && task->area.on_screen) ||
-                (hide_task_diff_monitor && p->monitor == monitor && !task->area.on_screen) ||
-                (p->monitor != monitor && num_panels > 1)) {
-                remove_task(task);
-                task = add_task(win);
-                if (win == get_active_window()) {
-                    set_task_state(task, TASK_ACTIVE);
-                    active_task = task;
-                }
-                schedule_panel_redraw();
-            }
-        }
-    }
+    Task *task = get_task(win);
+    if (task)
+        task_update_monitor(task);
 
     if (server.viewports) {
-        Task *task = get_task(win);
+        task = get_task(win);
         if (task) {
             int desktop = get_window_desktop(win);
             if (task->desktop != desktop) {
@@ -511,7 +506,8 @@ void handle_x_event(XEvent *e)
     case DestroyNotify:
         if (e->xany.window == server.composite_manager) {
             // Stop real_transparency
-            emit_self_restart("compositor shutdown");
+            if (server_update_composite_manager())
+                update_panel_visual();
             break;
         }
         if (e->xany.window == g_tooltip.window || !systray_enabled)
@@ -527,13 +523,9 @@ void handle_x_event(XEvent *e)
     case ClientMessage: {
         XClientMessageEvent *ev = &e->xclient;
         if (ev->data.l[1] == server.atom._NET_WM_CM_S0) {
-            if (ev->data.l[2] == None) {
-                // Stop real_transparency
-                emit_self_restart("compositor changed");
-            } else {
-                // Start real_transparency
-                emit_self_restart("compositor changed");
-            }
+            // Start or stop real_transparency, unless the compositor has only been replaced
+            if (server_update_composite_manager())
+                update_panel_visual();
         }
         if (systray_enabled && e->xclient.message_type == server.atom._NET_SYSTEM_TRAY_OPCODE &&
             e->xclient.format == 32 && e->xclient.window == net_sel_win) {
@@ -570,6 +562,8 @@ void handle_x_event(XEvent *e)
             TrayWindow *traywin = systray_find_icon(de->drawable);
             if (traywin)
                 systray_render_icon(traywin);
+            else
+                taskbar_handle_damage(de->drawable);
         }
     }
 }
@@ -595,23 +589,23 @@ void prepare_fd_set(fd_set *set, int *max_fd)
         FD_SET(sigchild_pipe[0], set);
         *max_fd = MAX(*max_fd, sigchild_pipe[0]);
     }
-    for (GList *l = panel_config.execp_list; l; l = l->next) {
-        Execp *execp = (Execp *)l->data;
-        int fd = execp->backend->child_pipe_stdout;
-        if (fd > 0) {
-            FD_SET(fd, set);
-            *max_fd = MAX(*max_fd, fd);
-        }
-        fd = execp->backend->child_pipe_stderr;
-        if (fd > 0) {
-            FD_SET(fd, set);
-            *max_fd = MAX(*max_fd, fd);
-        }
-    }
+    execp_prepare_fd_set(set, max_fd);
     if (uevent_fd > 0) {
         FD_SET(uevent_fd, set);
         *max_fd = MAX(*max_fd, uevent_fd);
     }
+    if (thumbnail_worker_fd() >= 0) {
+        FD_SET(thumbnail_worker_fd(), set);
+        *max_fd = MAX(*max_fd, thumbnail_worker_fd());
+    }
+    if (icon_loader_fd() >= 0) {
+        FD_SET(icon_loader_fd(), set);
+        *max_fd = MAX(*max_fd, icon_loader_fd());
+    }
+    if (fswatch_fd() >= 0) {
+        FD_SET(fswatch_fd(), set);
+        *max_fd = MAX(*max_fd, fswatch_fd());
+    }
 }
 
 void handle_panel_refresh()
@@ -692,6 +686,7 @@ void handle_panel_refresh()
     }
     if (first_render) {
         first_render = FALSE;
+        hide_cached_frames();
         if (panel_shrink)
             schedule_panel_redraw();
     }
@@ -699,6 +694,7 @@ void handle_panel_refresh()
     if (debug_fps)
         ts_render_finished = get_time();
     XFlush(server.display);
+    startup_timeline_finish();
 
     if (debug_fps && ts_event_read > 0) {
         ts_flush_finished = get_time();
@@ -740,6 +736,19 @@ void handle_panel_refresh()
     frame++;
 }
 
+// Handles SIGUSR1 without restarting, when the config file changes allow it
+gboolean reload_config_in_place()
+{
+    // The reload is taken before reloading, so that the signals received meanwhile are not lost
+    if (!take_config_reload())
+        return FALSE;
+    if (!config_reload()) {
+        emit_restart_after_failed_reload();
+        return FALSE;
+    }
+    return TRUE;
+}
+
 void run_tint2_event_loop()
 {
     ts_event_read = 0;
@@ -748,7 +757,8 @@ void run_tint2_event_loop()
     ts_flush_finished = 0;
     first_render = TRUE;
 
-    while (!get_signal_pending()) {
+    startup_tasks_join();
+    while (!get_signal_pending() || reload_config_in_place()) {
         if (panel_refresh)
             handle_panel_refresh();
 
@@ -756,15 +766,24 @@ void run_tint2_event_loop()
         int max_fd;
         prepare_fd_set(&fds, &max_fd);
 
-        // Wait for an event and handle it
+        // Wait for an event and handle it. If X events are already queued, only check which other file descriptors
+        // are ready, so that the handlers only read from those.
         ts_event_read = 0;
-        if (XPending(server.display) > 0 || select(max_fd + 1, &fds, 0, 0, get_duration_to_next_timer_expiration()) >= 0) {
+        gboolean x_pending = XPending(server.display) > 0;
+        struct timeval no_wait = {0, 0};
+        int num_ready = select(max_fd + 1, &fds, 0, 0, x_pending ? &no_wait : get_duration_to_next_timer_expiration());
+        if (num_ready < 0)
+            FD_ZERO(&fds);
+        if (x_pending || num_ready >= 0) {
 #ifdef HAVE_TRACING
             start_tracing((void*)run_tint2_event_loop);
 #endif
             uevent_handler();
             handle_sigchld_events();
-            handle_execp_events();
+            handle_execp_events(&fds);
+            handle_thumbnail_worker_events();
+            handle_icon_loader_events();
+            handle_fswatch_events();
             handle_x_events();
         }
 
@@ -772,11 +791,30 @@ void run_tint2_event_loop()
     }
 }
 
+void config_file_changed(const char *dir, GHashTable *names, void *userdata)
+{
+    gchar *name = g_path_get_basename(config_path);
+    if (!names || g_hash_table_contains(names, name))
+        emit_config_reload("configuration file changed");
+    g_free(name);
+}
+
+void watch_config_file()
+{
+    if (!config_path)
+        return;
+    // Editors often replace the file instead of writing it, so watch its directory
+    gchar *dir = g_path_get_dirname(config_path);
+    fswatch_add(dir, config_file_changed, NULL);
+    g_free(dir);
+}
+
 void tint2(int argc, char **argv, gboolean *restart)
 {
     init(argc, argv);
 
     if (snapshot_path) {
+        startup_tasks_join();
         save_screenshot(snapshot_path);
         cleanup();
         return;
@@ -784,6 +822,7 @@ void tint2(int argc, char **argv, gboolean *restart)
 
     dnd_init();
     uevent_init();
+    watch_config_file();
     run_tint2_event_loop();
 
     if (get_signal_pending()) {
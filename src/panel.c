@@ -34,6 +34,7 @@
 #include "window.h"
 #include "task.h"
 #include "panel.h"
+#include "startup.h"
 #include "tooltip.h"
 
 void panel_clear_background(void *obj);
@@ -76,6 +77,10 @@ Panel panel_config;
 // panels (one panel per monitor)
 Panel *panels;
 int num_panels;
+// The panels are never moved in memory, since the areas, tasks and timers point into them.
+// Panels can be added without restarting as long as they fit in the allocated array.
+static int panels_capacity;
+#define MIN_PANELS_CAPACITY 8
 
 GArray *backgrounds;
 GArray *gradients;
@@ -122,6 +127,7 @@ void default_panel()
     panel_config.mouse_pressed_saturation = 0;
     panel_config.mouse_pressed_brightness = 0;
     panel_config.mouse_effects = 1;
+    panel_config.g_task.thumbnail_cache_size = 32;
 
     // First background is always fully transparent
     Background transparent_bg;
@@ -132,27 +138,29 @@ void default_panel()
     g_array_append_val(gradients, transparent_gradient);
 }
 
+static void free_panel(Panel *p)
+{
+    free_area(&p->area);
+    if (p->temp_pmap)
+        XFreePixmap(server.display, p->temp_pmap);
+    p->temp_pmap = 0;
+    if (p->hidden_pixmap)
+        XFreePixmap(server.display, p->hidden_pixmap);
+    p->hidden_pixmap = 0;
+    if (p->main_win)
+        XDestroyWindow(server.display, p->main_win);
+    p->main_win = 0;
+    destroy_timer(&p->autohide_timer);
+    cleanup_freespace(p);
+}
+
 void cleanup_panel()
 {
     if (!panels)
         return;
 
-    for (int i = 0; i < num_panels; i++) {
-        Panel *p = &panels[i];
-
-        free_area(&p->area);
-        if (p->temp_pmap)
-            XFreePixmap(server.display, p->temp_pmap);
-        p->temp_pmap = 0;
-        if (p->hidden_pixmap)
-            XFreePixmap(server.display, p->hidden_pixmap);
-        p->hidden_pixmap = 0;
-        if (p->main_win)
-            XDestroyWindow(server.display, p->main_win);
-        p->main_win = 0;
-        destroy_timer(&p->autohide_timer);
-        cleanup_freespace(p);
-    }
+    for (int i = 0; i < num_panels; i++)
+        free_panel(&panels[i]);
 
     free_icon_themes();
 
@@ -162,6 +170,7 @@ void cleanup_panel()
     panel_window_name = NULL;
     free(panels);
     panels = NULL;
+    panels_capacity = 0;
 
     free_area(&panel_config.area);
 
@@ -179,6 +188,117 @@ void cleanup_panel()
     panel_config.taskbarname_font_desc = NULL;
 }
 
+static double get_panel_scale(Panel *p)
+{
+    double scale = 1;
+    if (ui_scale_dpi_ref > 0 && server.monitors[p->monitor].dpi > 0)
+        scale = server.monitors[p->monitor].dpi / ui_scale_dpi_ref;
+    if (ui_scale_monitor_size_ref > 0)
+        scale *= server.monitors[p->monitor].height / ui_scale_monitor_size_ref;
+    if (scale > 8 || scale < 1./8) {
+        fprintf(stderr,
+                RED "tint2: panel %d having scale %g outside bounds, resetting to 1.0" RESET "\n",
+                (int)(p - panels) + 1,
+                scale);
+        scale = 1;
+    }
+    return scale;
+}
+
+static void copy_panel_config(Panel *p)
+{
+    memcpy(p, &panel_config, sizeof(Panel));
+    INIT_TIMER(p->autohide_timer);
+}
+
+static void create_panel_window(Panel *p)
+{
+    // catch some events
+    XSetWindowAttributes att = {.colormap = server.colormap, .background_pixel = 0, .border_pixel = 0};
+    unsigned long mask = CWEventMask | CWColormap | CWBackPixel | CWBorderPixel;
+    p->main_win = XCreateWindow(server.display,
+                                server.root_win,
+                                p->posx,
+                                p->posy,
+                                p->area.width,
+                                p->area.height,
+                                0,
+                                server.depth,
+                                InputOutput,
+                                server.visual,
+                                mask,
+                                &att);
+
+    set_panel_event_mask(p);
+
+    if (!server.gc) {
+        XGCValues gcv;
+        server.gc = XCreateGC(server.display, p->main_win, 0, &gcv);
+    }
+    // fprintf(stderr, "tint2: panel %d : %d, %d, %d, %d\n", i, p->posx, p->posy, p->area.width, p->area.height);
+    set_panel_properties(p);
+    set_panel_background(p);
+    if (!snapshot_path) {
+        // if we are not in 'snapshot' mode then map new panel
+        XMapWindow(server.display, p->main_win);
+    }
+
+    if (panel_autohide)
+        autohide_trigger_hide(p, false);
+}
+
+// Initializes panels[i], after copy_panel_config. num_panels must already count it.
+static void init_panel_at(int i)
+{
+    Panel *p = &panels[i];
+
+    if (panel_config.monitor < 0)
+        p->monitor = i;
+    p->scale = get_panel_scale(p);
+    fprintf(stderr, BLUE "tint2: panel %d uses scale %g " RESET "\n", i + 1, p->scale);
+    if (!p->area.bg)
+        p->area.bg = &g_array_index(backgrounds, Background, 0);
+    p->area.parent = p;
+    p->area.panel = p;
+    snprintf(p->area.name, sizeof(p->area.name), "Panel %d", i);
+    p->area.on_screen = TRUE;
+    p->area.resize_needed = 1;
+    p->area.size_mode = LAYOUT_DYNAMIC;
+    p->area._resize = resize_panel;
+    p->area._clear = panel_clear_background;
+    p->separator_list = NULL;
+    init_panel_size_and_position(p);
+    instantiate_area_gradients(&p->area);
+    // add children according to panel_items
+    for (int k = 0; k < strlen(panel_items_order); k++) {
+        if (panel_items_order[k] == 'L')
+            init_launcher_panel(p);
+        if (panel_items_order[k] == 'T')
+            init_taskbar_panel(p);
+#ifdef ENABLE_BATTERY
+        if (panel_items_order[k] == 'B')
+            init_battery_panel(p);
+#endif
+        if (panel_items_order[k] == 'S' && systray_on_monitor(i, num_panels)) {
+            init_systray_panel(p);
+            refresh_systray = 1;
+        }
+        if (panel_items_order[k] == 'C')
+            init_clock_panel(p);
+        if (panel_items_order[k] == 'F' && !strstr(panel_items_order, "T"))
+            init_freespace_panel(p);
+        if (panel_items_order[k] == ':')
+            init_separator_panel(p);
+        if (panel_items_order[k] == 'E') {
+            init_execp_panel(p);
+        }
+        if (panel_items_order[k] == 'P')
+            init_button_panel(p);
+    }
+    set_panel_items_order(p);
+    create_panel_window(p);
+}
+
 void init_panel()
 {
     if (panel_config.monitor > (server.num_monitors - 1)) {
@@ -199,6 +319,7 @@ void init_panel()
     init_battery();
 #endif
     init_taskbar();
+    init_window_thumbnails();
     init_separator();
     init_execp();
     init_button();
@@ -209,120 +330,219 @@ void init_panel()
     else
         num_panels = server.num_monitors;
 
-    panels = calloc(num_panels, sizeof(Panel));
-    for (int i = 0; i < num_panels; i++) {
-        memcpy(&panels[i], &panel_config, sizeof(Panel));
-        INIT_TIMER(panels[i].autohide_timer);
-    }
+    // With panel_monitor = all, room is kept for the monitors plugged in later (see update_panel_monitors)
+    panels_capacity = panel_config.monitor >= 0 ? 1 : MAX(num_panels, MIN_PANELS_CAPACITY);
+    panels = calloc(panels_capacity, sizeof(Panel));
+    for (int i = 0; i < num_panels; i++)
+        copy_panel_config(&panels[i]);
 
     fprintf(stderr,
             "tint2: nb monitors %d, nb monitors used %d, nb desktops %d\n",
             server.num_monitors,
             num_panels,
             server.num_desktops);
-    for (int i = 0; i < num_panels; i++) {
-        Panel *p = &panels[i];
+    for (int i = 0; i < num_panels; i++)
+        init_panel_at(i);
 
-        if (panel_config.monitor < 0)
-            p->monitor = i;
-        if (ui_scale_dpi_ref > 0 && server.monitors[p->monitor].dpi > 0)
-            p->scale = server.monitors[p->monitor].dpi / ui_scale_dpi_ref;
-        else
-            p->scale = 1;
-        if (ui_scale_monitor_size_ref > 0)
-            p->scale *= server.monitors[p->monitor].height / ui_scale_monitor_size_ref;
-        if (p->scale > 8 || p->scale < 1./8) {
-            fprintf(stderr, RED "tint2: panel %d having scale %g outside bounds, resetting to 1.0" RESET "\n", i + 1, p->scale);
-            p->scale = 1;
-        }
-        fprintf(stderr, BLUE "tint2: panel %d uses scale %g " RESET "\n", i + 1, p->scale);
-        if (!p->area.bg)
-            p->area.bg = &g_array_index(backgrounds, Background, 0);
-        p->area.parent = p;
-        p->area.panel = p;
-        snprintf(p->area.name, sizeof(p->area.name), "Panel %d", i);
-        p->area.on_screen = TRUE;
-        p->area.resize_needed = 1;
-        p->area.size_mode = LAYOUT_DYNAMIC;
-        p->area._resize = resize_panel;
-        p->area._clear = panel_clear_background;
-        p->separator_list = NULL;
+    startup_mark("panels");
+    taskbar_refresh_tasklist();
+    reset_active_task();
+    update_all_taskbars_visibility();
+    startup_mark("tasklist");
+}
+
+void set_panel_event_mask(Panel *p)
+{
+    long event_mask = ExposureMask | ButtonPressMask | ButtonReleaseMask | ButtonMotionMask | PropertyChangeMask;
+    if (p->mouse_effects || p->g_task.tooltip_enabled || p->clock.area._get_tooltip_text ||
+        (launcher_enabled && launcher_tooltip_enabled))
+        event_mask |= PointerMotionMask | LeaveWindowMask;
+    if (panel_autohide)
+        event_mask |= LeaveWindowMask | EnterWindowMask;
+    XChangeWindowAttributes(server.display,
+                            p->main_win,
+                            CWEventMask,
+                            &(XSetWindowAttributes){.event_mask = event_mask});
+}
+
+static gboolean same_monitors(const Monitor *monitors1, int num1, const Monitor *monitors2, int num2)
+{
+    if (num1 != num2)
+        return FALSE;
+    for (int i = 0; i < num1; i++) {
+        const Monitor *m1 = &monitors1[i];
+        const Monitor *m2 = &monitors2[i];
+        if (m1->x != m2->x || m1->y != m2->y || m1->width != m2->width || m1->height != m2->height ||
+            m1->dpi != m2->dpi || m1->primary != m2->primary)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean has_monitor_executors()
+{
+    for (GList *l = panel_config.execp_list; l; l = l->next) {
+        Execp *execp = (Execp *)l->data;
+        if (execp->backend->monitor >= 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// Returns the index of the panel showing the systray when there are n_panels panels, or -1
+static int get_systray_panel(int n_panels)
+{
+    if (!systray_enabled || !strchr(panel_items_order, 'S'))
+        return -1;
+    for (int i = 0; i < n_panels; i++) {
+        if (systray_on_monitor(i, n_panels))
+            return i;
+    }
+    return -1;
+}
+
+// Destroys the last panel, after its monitor has been unplugged.
+static void remove_last_panel()
+{
+    Panel *p = &panels[num_panels - 1];
+    // From now on add_task places windows on the remaining panels
+    num_panels--;
+    GList *windows = g_hash_table_get_keys(win_to_task);
+    for (GList *l = windows; l; l = l->next) {
+        Task *task = get_task(*(Window *)l->data);
+        if (task && task->area.panel == p)
+            readd_task(task);
+    }
+    g_list_free(windows);
+
+    if (g_tooltip.panel == p) {
+        tooltip_trigger_hide();
+        tooltip_hide(NULL);
+        g_tooltip.panel = NULL;
+    }
+    cleanup_button_panel(p);
+    cleanup_execp_panel(p);
+    cleanup_launcher_theme(&p->launcher);
+    cleanup_separator_panel(p);
+    cleanup_taskbar_panel(p);
+    free_panel(p);
+    memset(p, 0, sizeof(Panel));
+}
+
+gboolean update_panel_monitors()
+{
+    Monitor *old_monitors = server.monitors;
+    int old_num_monitors = server.num_monitors;
+    server.monitors = NULL;
+    server.num_monitors = 0;
+    get_monitors();
+
+    gboolean same = same_monitors(old_monitors, old_num_monitors, server.monitors, server.num_monitors);
+    for (int i = 0; i < old_num_monitors; i++)
+        g_strfreev(old_monitors[i].names);
+    free(old_monitors);
+    if (same)
+        return TRUE;
+    print_monitors();
+
+    int monitor = config_get_panel_monitor();
+    if (monitor > server.num_monitors - 1)
+        monitor = 0;
+    int new_num_panels = monitor >= 0 ? 1 : server.num_monitors;
+    if (new_num_panels > panels_capacity)
+        return FALSE;
+    // Executors are bound to monitors when they are created
+    if ((old_num_monitors != server.num_monitors || monitor != panel_config.monitor) && has_monitor_executors())
+        return FALSE;
+    int num_kept = MIN(num_panels, new_num_panels);
+    panel_config.monitor = monitor;
+    for (int i = 0; i < num_kept; i++) {
+        panels[i].monitor = monitor >= 0 ? monitor : i;
+        if (get_panel_scale(&panels[i]) != panels[i].scale)
+            return FALSE;
+    }
+
+    // The systray icons are embedded in the window of their panel. If the systray moves, they are docked again
+    // (start_net is called when the systray is resized).
+    int old_systray_panel = get_systray_panel(num_panels);
+    int new_systray_panel = get_systray_panel(new_num_panels);
+    if (old_systray_panel != new_systray_panel && old_systray_panel >= 0) {
+        stop_net();
+        remove_area(&systray.area);
+        free_area(&systray.area);
+    }
+
+    while (num_panels > new_num_panels)
+        remove_last_panel();
+    // Same as init_panel: the new panels are initialized once they are all counted in num_panels
+    for (int i = num_kept; i < new_num_panels; i++)
+        copy_panel_config(&panels[i]);
+    num_panels = new_num_panels;
+
+    for (int i = 0; i < num_kept; i++) {
+        Panel *p = &panels[i];
+        // The size may be a percentage of the monitor size
+        p->area.width = panel_config.area.width;
+        p->area.height = panel_config.area.height;
+        p->fractional_width = panel_config.fractional_width;
+        p->fractional_height = panel_config.fractional_height;
         init_panel_size_and_position(p);
-        instantiate_area_gradients(&p->area);
-        // add children according to panel_items
-        for (int k = 0; k < strlen(panel_items_order); k++) {
-            if (panel_items_order[k] == 'L')
-                init_launcher_panel(p);
-            if (panel_items_order[k] == 'T')
-                init_taskbar_panel(p);
-#ifdef ENABLE_BATTERY
-            if (panel_items_order[k] == 'B')
-                init_battery_panel(p);
-#endif
-            if (panel_items_order[k] == 'S' && systray_on_monitor(i, num_panels)) {
-                init_systray_panel(p);
-                refresh_systray = 1;
-            }
-            if (panel_items_order[k] == 'C')
-                init_clock_panel(p);
-            if (panel_items_order[k] == 'F' && !strstr(panel_items_order, "T"))
-                init_freespace_panel(p);
-            if (panel_items_order[k] == ':')
-                init_separator_panel(p);
-            if (panel_items_order[k] == 'E') {
-                init_execp_panel(p);
-            }
-            if (panel_items_order[k] == 'P')
-                init_button_panel(p);
+        set_panel_window_geometry(p);
+        if (i == new_systray_panel && i != old_systray_panel) {
+            init_systray_panel(p);
+            refresh_systray = TRUE;
         }
         set_panel_items_order(p);
-
-        // catch some events
-        XSetWindowAttributes att = {.colormap = server.colormap, .background_pixel = 0, .border_pixel = 0};
-        unsigned long mask = CWEventMask | CWColormap | CWBackPixel | CWBorderPixel;
-        p->main_win = XCreateWindow(server.display,
-                                    server.root_win,
-                                    p->posx,
-                                    p->posy,
-                                    p->area.width,
-                                    p->area.height,
-                                    0,
-                                    server.depth,
-                                    InputOutput,
-                                    server.visual,
-                                    mask,
-                                    &att);
-
-        long event_mask = ExposureMask | ButtonPressMask | ButtonReleaseMask | ButtonMotionMask | PropertyChangeMask;
-        if (p->mouse_effects || p->g_task.tooltip_enabled || p->clock.area._get_tooltip_text ||
-            (launcher_enabled && launcher_tooltip_enabled))
-            event_mask |= PointerMotionMask | LeaveWindowMask;
-        if (panel_autohide)
-            event_mask |= LeaveWindowMask | EnterWindowMask;
-        XChangeWindowAttributes(server.display,
-                                p->main_win,
-                                CWEventMask,
-                                &(XSetWindowAttributes){.event_mask = event_mask});
-
-        if (!server.gc) {
-            XGCValues gcv;
-            server.gc = XCreateGC(server.display, p->main_win, 0, &gcv);
-        }
-        // fprintf(stderr, "tint2: panel %d : %d, %d, %d, %d\n", i, p->posx, p->posy, p->area.width, p->area.height);
-        set_panel_properties(p);
+        schedule_resize_tree(&p->area);
         set_panel_background(p);
-        if (!snapshot_path) {
-            // if we are not in 'snapshot' mode then map new panel
-            XMapWindow(server.display, p->main_win);
-        }
-
-        if (panel_autohide)
-            autohide_trigger_hide(p, false);
     }
 
-    taskbar_refresh_tasklist();
-    reset_active_task();
+    for (int i = num_kept; i < num_panels; i++)
+        init_panel_at(i);
+
+    // Windows may now be on another monitor
+    GList *windows = g_hash_table_get_keys(win_to_task);
+    for (GList *l = windows; l; l = l->next) {
+        Task *task = get_task(*(Window *)l->data);
+        if (task)
+            task_update_monitor(task);
+    }
+    g_list_free(windows);
     update_all_taskbars_visibility();
+
+    schedule_panel_redraw();
+    return TRUE;
+}
+
+void update_panel_visual()
+{
+    // The systray icons are embedded in the panel window: they are docked again (start_net is called when the
+    // systray is resized)
+    stop_net();
+    systray.area.resize_needed = TRUE;
+    refresh_systray = TRUE;
+
+    imlib_context_set_visual(server.visual);
+    imlib_context_set_colormap(server.colormap);
+    tooltip_hide(NULL);
+    init_tooltip();
+
+    // The GC depends on the depth of the panel windows
+    if (server.gc)
+        XFreeGC(server.display, server.gc);
+    server.gc = NULL;
+    for (int i = 0; i < num_panels; i++) {
+        Panel *p = &panels[i];
+        if (p->temp_pmap)
+            XFreePixmap(server.display, p->temp_pmap);
+        p->temp_pmap = 0;
+        XDestroyWindow(server.display, p->main_win);
+        stop_timer(&p->autohide_timer);
+        p->is_hidden = FALSE;
+        // Redraws all the areas, so that their pixmaps are created again with the new depth
+        create_panel_window(p);
+    }
+    schedule_panel_redraw();
 }
 
 void panel_compute_size(Panel *panel)
@@ -1224,6 +1444,11 @@ void default_icon_theme_changed()
     if (launcher_icon_theme_override && icon_theme_name_config)
         return;
 
+    reload_icon_themes();
+}
+
+void reload_icon_themes()
+{
     free_icon_themes();
     load_icon_themes();
 
@@ -1252,7 +1477,7 @@ void _schedule_panel_redraw(const char *file, const char *function, const int li
     }
 }
 
-void save_panel_screenshot(const Panel *panel, const char *path)
+Imlib_Image get_panel_image(const Panel *panel)
 {
     imlib_context_set_drawable(panel->temp_pmap);
     Imlib_Image img = imlib_create_image_from_drawable(0, 0, 0, panel->area.width, panel->area.height, 1);
@@ -1280,7 +1505,12 @@ void save_panel_screenshot(const Panel *panel, const char *path)
             img = imlib_create_image_using_data(panel->area.width, panel->area.height, pixels);
         }
     }
+    return img;
+}
 
+void save_panel_screenshot(const Panel *panel, const char *path)
+{
+    Imlib_Image img = get_panel_image(panel);
     if (img) {
         imlib_context_set_image(img);
         if (!panel_horizontal) {
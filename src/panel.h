@@ -99,6 +99,7 @@ extern gboolean debug_thumbnails;
 extern double ui_scale_dpi_ref;
 extern double ui_scale_monitor_size_ref;
 extern gboolean thumb_use_shm;
+extern gboolean thumb_use_xrender;
 extern gboolean debug_blink;
 
 typedef struct Panel {
@@ -175,6 +176,12 @@ void cleanup_panel();
 void init_panel();
 
 void init_panel_size_and_position(Panel *panel);
+// Reads the monitors again, adds or removes panels (with panel_monitor = all), and moves and resizes them.
+// Returns FALSE if this requires a restart: more panels than allocated, panels rescaled, or executors bound to
+// monitors that have been renumbered.
+gboolean update_panel_monitors();
+// Creates the panel windows again after the visual changed (see server_update_composite_manager).
+void update_panel_visual();
 gboolean resize_panel(void *obj);
 void render_panel(Panel *panel);
 void shrink_panel(Panel *panel);
@@ -187,6 +194,8 @@ void replace_panel_all_desktops(Panel *p);
 void set_panel_properties(Panel *p);
 void set_panel_window_geometry(Panel *panel);
 void set_panel_layer(Panel *p, Layer layer);
+// Selects the events of the panel window needed by the current configuration
+void set_panel_event_mask(Panel *p);
 
 // draw background panel
 void set_panel_background(Panel *p);
@@ -216,12 +225,17 @@ void autohide_trigger_hide(Panel *p, bool forced);
 const char *get_default_font();
 
 void default_icon_theme_changed();
+// Reloads the icon themes and the icons that use them, e.g. after icons were installed.
+void reload_icon_themes();
 void default_font_changed();
 
 void free_icon(Imlib_Image icon);
 Imlib_Image scale_icon(Imlib_Image original, int icon_size);
+Imlib_Image placeholder_icon(int icon_size);
 
 void save_screenshot(const char *path);
+// Returns the last frame rendered by the panel, in the orientation of the panel. Free it with imlib_free_image().
+Imlib_Image get_panel_image(const Panel *panel);
 void save_panel_screenshot(const Panel *panel, const char *path);
 
 void panel_action(const Panel* panel, int mouse_button);
@@ -99,13 +99,18 @@ void init_separator_panel(void *p)
     }
 }
 
+void cleanup_separator_panel(void *p)
+{
+    Panel *panel = (Panel *)p;
+    g_list_free_full(panel->separator_list, destroy_separator);
+    panel->separator_list = NULL;
+}
+
 void cleanup_separator()
 {
     // Cleanup frontends
-    for (int i = 0; i < num_panels; i++) {
-        g_list_free_full(panels[i].separator_list, destroy_separator);
-        panels[i].separator_list = NULL;
-    }
+    for (int i = 0; i < num_panels; i++)
+        cleanup_separator_panel(&panels[i]);
 
     // Cleanup backends
     g_list_free_full(panel_config.separator_list, destroy_separator);
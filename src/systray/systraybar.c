@@ -375,17 +375,16 @@ void start_net()
     // freedesktop systray specification
     if (win != None) {
         // search pid
-        Atom _NET_WM_PID, actual_type;
+        Atom actual_type;
         int actual_format;
         unsigned long nitems;
         unsigned long bytes_after;
         unsigned char *prop = 0;
         int pid;
 
-        _NET_WM_PID = XInternAtom(server.display, "_NET_WM_PID", True);
         int ret = XGetWindowProperty(server.display,
                                      win,
-                                     _NET_WM_PID,
+                                     server.atom._NET_WM_PID,
                                      0,
                                      1024,
                                      False,
@@ -449,7 +448,7 @@ void start_net()
         vid = XVisualIDFromVisual(server.visual);
     XChangeProperty(server.display,
                     net_sel_win,
-                    XInternAtom(server.display, "_NET_SYSTEM_TRAY_VISUAL", False),
+                    server.atom._NET_SYSTEM_TRAY_VISUAL,
                     XA_VISUALID,
                     32,
                     PropModeReplace,
@@ -529,6 +528,8 @@ void stop_net()
 gboolean error;
 int window_error_handler(Display *d, XErrorEvent *e)
 {
+    if (d != server.display)
+        return thumbnail_x_error_handler(d, e);
     if (systray_profile)
         fprintf(stderr, RED "tint2: [%f] %s:%d" RESET "\n", profiling_get_time(), __func__, __LINE__);
     error = TRUE;
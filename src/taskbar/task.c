@@ -27,10 +27,14 @@
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
 
+#include "hash.h"
+#include "icon-theme-common.h"
 #include "panel.h"
 #include "server.h"
 #include "task.h"
 #include "taskbar.h"
+#include "thumbnail_store.h"
+#include "thumbnail_worker.h"
 #include "timer.h"
 #include "tooltip.h"
 #include "window.h"
@@ -54,10 +58,10 @@ cairo_surface_t *task_get_thumbnail(void *obj)
     if (!panel_config.g_task.thumbnail_enabled)
         return NULL;
     Task *t = (Task *)obj;
-    if (!t->thumbnail)
-        task_refresh_thumbnail(t);
+    if (!thumbnail_store_contains(t->win))
+        taskbar_queue_thumbnail(t);
     taskbar_start_thumbnail_timer(THUMB_MODE_TOOLTIP_WINDOW);
-    return t->thumbnail;
+    return thumbnail_store_get(t->win);
 }
 
 Task *add_task(Window win)
@@ -101,6 +105,10 @@ Task *add_task(Window win)
     }
     task_update_title(&task_template);
     task_update_icon(&task_template);
+    if (panel_config.g_task.thumbnail_enabled && server.has_xdamage) {
+        task_template.thumbnail_damage = XDamageCreate(server.display, win, XDamageReportNonEmpty);
+        task_template.thumbnail_dirty = TRUE;
+    }
     snprintf(task_template.area.name,
              sizeof(task_template.area.name),
              "Task %d %s",
@@ -162,6 +170,10 @@ Task *add_task(Window win)
         }
         task_instance->icon_width = task_template.icon_width;
         task_instance->icon_height = task_template.icon_height;
+        task_instance->icon_location = task_template.icon_location;
+        task_instance->icon_hash = task_template.icon_hash;
+        task_instance->thumbnail_damage = task_template.thumbnail_damage;
+        task_instance->thumbnail_dirty = task_template.thumbnail_dirty;
 
         add_area(&task_instance->area, &taskbar->area);
         g_ptr_array_add(task_buttons, task_instance);
@@ -228,8 +240,9 @@ void remove_task(Task *task)
     // even with task_on_all_desktop and with task_on_all_panel
     if (task->title)
         free(task->title);
-    if (task->thumbnail)
-        cairo_surface_destroy(task->thumbnail);
+    if (task->thumbnail_damage)
+        XDamageDestroy(server.display, task->thumbnail_damage);
+    thumbnail_store_remove(win);
     if (task->application)
         free(task->application);
     task_remove_icon(task);
@@ -299,30 +312,26 @@ gboolean task_update_title(Task *task)
     return TRUE;
 }
 
-Imlib_Image task_get_icon(Window win, int icon_size)
+Imlib_Image task_get_icon(Task *task, int icon_size)
 {
+    Window win = task->win;
     Imlib_Image img = NULL;
 
     if (!img) {
-        int len;
-        gulong *data = server_get_property(win, server.atom._NET_WM_ICON, XA_CARDINAL, &len);
+        // get ARGB icon
+        int w, h;
+        gulong *data = get_window_icon(win, icon_size, &w, &h, &task->icon_location);
         if (data) {
-            if (len > 0) {
-                // get ARGB icon
-                int w, h;
-                gulong *tmp_data = get_best_icon(data, get_icon_count(data, len), len, &w, &h, icon_size);
-                if (tmp_data) {
-                    int array_size = w * h;
-                    // imlib needs the array in DATA32 type
-                    // using malloc for the array to protect from stack overflow
-                    DATA32 *icon_data = (DATA32*) g_try_malloc(sizeof(*icon_data) * array_size);
-                    if (icon_data) {
-                        for (int j = 0; j < array_size; ++j)
-                            icon_data[j] = tmp_data[j];
-                        img = imlib_create_image_using_copied_data(w, h, icon_data);
-                        g_free(icon_data);
-                    }
-                }
+            gulong *tmp_data = data + 2;
+            int array_size = w * h;
+            // imlib needs the array in DATA32 type
+            // using malloc for the array to protect from stack overflow
+            DATA32 *icon_data = (DATA32*) g_try_malloc(sizeof(*icon_data) * array_size);
+            if (icon_data) {
+                for (int j = 0; j < array_size; ++j)
+                    icon_data[j] = tmp_data[j];
+                img = imlib_create_image_using_copied_data(w, h, icon_data);
+                g_free(icon_data);
             }
             XFree(data);
         }
@@ -371,22 +380,78 @@ void task_set_icon_color(Task *task, Imlib_Image icon)
     }
 }
 
-void task_update_icon(Task *task)
+// Hashes the source icon together with the settings used to process it (see task_update_icon), so that the icon
+// is processed again when they change (e.g. the task moved to a panel with another icon size)
+static uint64_t task_icon_hash(Task *task, Imlib_Image img)
+{
+    Panel *panel = task->area.panel;
+    int settings[] = {panel->g_task.icon_size1,
+                      panel_config.mouse_effects,
+                      panel_config.mouse_over_alpha,
+                      panel_config.mouse_over_saturation,
+                      panel_config.mouse_over_brightness,
+                      panel_config.mouse_pressed_alpha,
+                      panel_config.mouse_pressed_saturation,
+                      panel_config.mouse_pressed_brightness};
+    uint64_t seed = hash64(settings, sizeof(settings), 0);
+    seed = hash64(panel->g_task.alpha, sizeof(panel->g_task.alpha), seed);
+    seed = hash64(panel->g_task.saturation, sizeof(panel->g_task.saturation), seed);
+    seed = hash64(panel->g_task.brightness, sizeof(panel->g_task.brightness), seed);
+
+    imlib_context_set_image(img);
+    int w = imlib_image_get_width();
+    int h = imlib_image_get_height();
+    uint64_t size = ((uint64_t)w << 32) | (uint32_t)h;
+    DATA32 *data = imlib_image_get_data_for_reading_only();
+    return hash64(data, (size_t)w * h * sizeof(DATA32), hash64(&size, sizeof(size), seed));
+}
+
+// Returns TRUE if the icon did not change since the last update, in which case img is freed.
+static gboolean task_icon_unchanged(Task *task, Imlib_Image img, gboolean has_icon)
+{
+    static int num_updates = 0;
+    static int num_skipped = 0;
+
+    uint64_t hash = task_icon_hash(task, img);
+    num_updates++;
+    if (hash != task->icon_hash || !task->icon_hash || (has_icon && !task->icon[0])) {
+        task->icon_hash = hash;
+        return FALSE;
+    }
+
+    num_skipped++;
+    if (debug_icons)
+        fprintf(stderr,
+                "tint2: icon unchanged for window %s, skipped %d of %d icon updates\n",
+                task->title ? task->title : "",
+                num_skipped,
+                num_updates);
+    imlib_context_set_image(img);
+    imlib_free_image();
+    return TRUE;
+}
+
+gboolean task_update_icon(Task *task)
 {
     Panel *panel = task->area.panel;
     if (!panel->g_task.has_icon) {
         if (panel_config.g_task.has_content_tint) {
-            Imlib_Image img = task_get_icon(task->win, panel->g_task.icon_size1);
+            Imlib_Image img = task_get_icon(task, panel->g_task.icon_size1);
+            if (task_icon_unchanged(task, img, FALSE))
+                return FALSE;
             task_set_icon_color(task, img);
             imlib_context_set_image(img);
             imlib_free_image();
+            return TRUE;
         }
-        return;
+        return FALSE;
     }
 
-    task_remove_icon(task);
+    Imlib_Image img = task_get_icon(task, panel->g_task.icon_size1);
+    if (task_icon_unchanged(task, img, TRUE))
+        return FALSE;
 
-    Imlib_Image img = task_get_icon(task->win, panel->g_task.icon_size1);
+    task_remove_icon(task);
     task_set_icon_color(task, img);
 
     // transform icons
@@ -426,6 +491,8 @@ void task_update_icon(Task *task)
             Task *task2 = (Task *)g_ptr_array_index(task_buttons, i);
             task2->icon_width = task->icon_width;
             task2->icon_height = task->icon_height;
+            task2->icon_location = task->icon_location;
+            task2->icon_hash = task->icon_hash;
             task2->icon_color = task->icon_color;
             task2->icon_color_hover = task->icon_color_hover;
             task2->icon_color_press = task->icon_color_press;
@@ -437,6 +504,7 @@ void task_update_icon(Task *task)
             schedule_redraw(&task2->area);
         }
     }
+    return TRUE;
 }
 
 // TODO icons look too large when the panel is large
@@ -673,35 +741,113 @@ void reset_active_task()
     }
 }
 
+double task_thumbnail_staleness_budget(Task *task)
+{
+    GPtrArray *task_buttons = get_task_buttons(task->win);
+    if (task_buttons) {
+        for (int i = 0; i < task_buttons->len; ++i) {
+            Task *task2 = g_ptr_array_index(task_buttons, i);
+            if (g_tooltip.mapped && g_tooltip.area == &task2->area)
+                return 1.0;
+        }
+    }
+    if (active_task && active_task->win == task->win)
+        return 1.0;
+    return 10.0;
+}
+
+static void task_clear_thumbnail_dirty(Window win)
+{
+    GPtrArray *task_buttons = get_task_buttons(win);
+    for (int i = 0; task_buttons && i < task_buttons->len; ++i) {
+        Task *task2 = g_ptr_array_index(task_buttons, i);
+        task2->thumbnail_dirty = FALSE;
+    }
+}
+
 void task_refresh_thumbnail(Task *task)
 {
     if (!panel_config.g_task.thumbnail_enabled)
         return;
     if (task->current_state == TASK_ICONIFIED)
         return;
+    // Window contents did not change since the last capture
+    if (task->thumbnail_damage && !task->thumbnail_dirty && thumbnail_store_contains(task->win))
+        return;
     Panel *panel = (Panel*)task->area.panel;
     double now = get_time();
     if (now - task->thumbnail_last_update < 0.1)
         return;
     if (debug_thumbnails)
         fprintf(stderr, "tint2: thumbnail for window: %s" RESET "\n", task->title ? task->title : "");
-    cairo_surface_t *thumbnail = get_window_thumbnail(task->win, panel_config.g_task.thumbnail_width * panel->scale);
+    // Reset the damage before capturing, so that changes made during the capture are reported again
+    if (task->thumbnail_damage)
+        XDamageSubtract(server.display, task->thumbnail_damage, None, None);
+    int size = panel_config.g_task.thumbnail_width * panel->scale;
+    if (thumbnail_worker_enabled()) {
+        // The capture is delivered later to task_set_thumbnail; changes made meanwhile mark the window dirty again
+        task_clear_thumbnail_dirty(task->win);
+        thumbnail_worker_request(task->win, size);
+        return;
+    }
+    cairo_surface_t *thumbnail = get_window_thumbnail(task->win, size);
     if (!thumbnail)
         return;
-    if (task->thumbnail)
-        cairo_surface_destroy(task->thumbnail);
-    task->thumbnail = thumbnail;
-    task->thumbnail_last_update = get_time();
     if (debug_thumbnails)
         fprintf(stderr,
                 YELLOW "tint2: %s took %f ms (window: %s)" RESET "\n",
                 __func__,
-                1000 * (task->thumbnail_last_update - now),
+                1000 * (get_time() - now),
                 task->title ? task->title : "");
-    if (g_tooltip.mapped && (g_tooltip.area == &task->area)) {
-        tooltip_update_contents_for(&task->area);
-        tooltip_update();
+    task_clear_thumbnail_dirty(task->win);
+    task_set_thumbnail(task->win, thumbnail);
+}
+
+void task_set_thumbnail(Window win, cairo_surface_t *thumbnail)
+{
+    if (!thumbnail)
+        return;
+    GPtrArray *task_buttons = get_task_buttons(win);
+    if (!task_buttons) {
+        // The window was closed during the capture
+        cairo_surface_destroy(thumbnail);
+        return;
     }
+    // The thumbnail is shared by all the buttons of the window through the store
+    thumbnail_store_put(win, thumbnail);
+    double now = get_time();
+    for (int i = 0; i < task_buttons->len; ++i) {
+        Task *task2 = g_ptr_array_index(task_buttons, i);
+        task2->thumbnail_last_update = now;
+        if (g_tooltip.mapped && (g_tooltip.area == &task2->area)) {
+            tooltip_update_contents_for(&task2->area);
+            tooltip_update();
+        }
+    }
+}
+
+void readd_task(Task *task)
+{
+    Window win = task->win;
+    remove_task(task);
+    task = add_task(win);
+    if (task && win == get_active_window()) {
+        set_task_state(task, TASK_ACTIVE);
+        active_task = task;
+    }
+    schedule_panel_redraw();
+}
+
+void task_update_monitor(Task *task)
+{
+    if (num_panels <= 1 && !hide_task_diff_monitor)
+        return;
+    Panel *p = task->area.panel;
+    int monitor = get_window_monitor(task->win);
+    if ((hide_task_diff_monitor && p->monitor != monitor && task->area.on_screen) ||
+        (hide_task_diff_monitor && p->monitor == monitor && !task->area.on_screen) ||
+        (p->monitor != monitor && num_panels > 1))
+        readd_task(task);
 }
 
 void set_task_state(Task *task, TaskState state)
@@ -709,8 +855,8 @@ void set_task_state(Task *task, TaskState state)
     if (!task || state == TASK_UNDEFINED || state >= TASK_STATE_COUNT)
         return;
 
-    if (!task->thumbnail)
-        task_refresh_thumbnail(task);
+    if (!thumbnail_store_contains(task->win))
+        taskbar_queue_thumbnail(task);
     if (state == TASK_ACTIVE) {
         // For active windows, we get the thumbnail twice with a small delay in between.
         // This is because they sometimes redraw their windows slowly.
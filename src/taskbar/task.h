@@ -8,11 +8,13 @@
 #define TASK_H
 
 #include <X11/Xlib.h>
+#include <X11/extensions/Xdamage.h>
 #include <pango/pangocairo.h>
 #include <Imlib2.h>
 
 #include "common.h"
 #include "timer.h"
+#include "window.h"
 
 typedef enum TaskState {
     TASK_NORMAL = 0,
@@ -49,6 +51,8 @@ typedef struct GlobalTask {
     gboolean tooltip_enabled;
     gboolean thumbnail_enabled;
     int thumbnail_width;
+    // Memory budget for all the thumbnails, in MiB
+    int thumbnail_cache_size;
 } GlobalTask;
 
 // Stores information about a task.
@@ -64,6 +68,10 @@ typedef struct Task {
     Imlib_Image icon_press[TASK_STATE_COUNT];
     unsigned int icon_width;
     unsigned int icon_height;
+    // Where the icon was found in _NET_WM_ICON last time
+    WindowIconLocation icon_location;
+    // Hash of the source icon pixels and of the icon settings, used to skip reprocessing unchanged icons
+    uint64_t icon_hash;
     Color icon_color;
     Color icon_color_hover;
     Color icon_color_press;
@@ -81,8 +89,12 @@ typedef struct Task {
     double _text_posy;
     int _icon_x;
     int _icon_y;
-    cairo_surface_t *thumbnail;
+    // The thumbnail itself is kept in the thumbnail store, see thumbnail_store.h
     double thumbnail_last_update;
+    // Reports changes to the window contents, so that only damaged windows get new thumbnails
+    Damage thumbnail_damage;
+    // TRUE if the window was damaged since the thumbnail was captured
+    gboolean thumbnail_dirty;
 } Task;
 
 extern Timer urgent_timer;
@@ -94,13 +106,24 @@ void remove_task(Task *task);
 void draw_task(void *obj, cairo_t *c);
 void on_change_task(void *obj);
 
-void task_update_icon(Task *task);
+// Reloads the window icon. Returns TRUE if the icon changed.
+gboolean task_update_icon(Task *task);
 void task_update_desktop(Task *task);
 gboolean task_update_title(Task *task);
 void reset_active_task();
+// Removes the task and adds it again, on the panel of the monitor of its window
+void readd_task(Task *task);
+// Moves the task to the panel of the monitor of its window (or hides it), if the window changed monitor
+void task_update_monitor(Task *task);
 void set_task_state(Task *task, TaskState state);
 void task_handle_mouse_event(Task *task, MouseAction action);
 void task_refresh_thumbnail(Task *task);
+// Tooltip image callback of task buttons
+cairo_surface_t *task_get_thumbnail(void *obj);
+// Stores a new thumbnail for the window in the thumbnail store. Takes ownership of the reference.
+void task_set_thumbnail(Window win, cairo_surface_t *thumbnail);
+// Returns how long (in seconds) the thumbnail of a damaged window may stay out of date.
+double task_thumbnail_staleness_budget(Task *task);
 
 // Given a pointer to the task that is currently under the mouse (current_task),
 // returns a pointer to the Task for the active window on the same taskbar.
@@ -32,6 +32,8 @@
 #include "window.h"
 #include "panel.h"
 #include "strnatcmp.h"
+#include "thumbnail_store.h"
+#include "thumbnail_worker.h"
 #include "tooltip.h"
 
 GHashTable *win_to_task;
@@ -50,9 +52,16 @@ Alignment taskbar_alignment;
 static Timer thumbnail_update_timer_all;
 static Timer thumbnail_update_timer_active;
 static Timer thumbnail_update_timer_tooltip;
+static Timer thumbnail_update_timer_damage;
+static double thumbnail_damage_due;
+// Thumbnails waiting to be refreshed, one queue per ThumbnailPriority
+static GQueue thumbnail_queue[THUMB_PRIORITY_COUNT];
+// Maps each queued window to its priority + 1
+static GHashTable *thumbnail_queued_windows;
+static Timer thumbnail_queue_timer;
+int thumbnail_budget_ms = 10;
 
 static GList *taskbar_task_orderings = NULL;
-static GList *taskbar_thumbnail_jobs_done = NULL;
 
 void taskbar_init_fonts();
 int taskbar_compute_desired_size(void *obj);
@@ -61,6 +70,7 @@ int taskbar_compute_desired_size(void *obj);
 void taskbar_remove_task(Window *win);
 
 void taskbar_update_thumbnails(void *arg);
+static void taskbar_clear_thumbnail_queue();
 
 guint win_hash(gconstpointer key)
 {
@@ -88,7 +98,6 @@ void default_taskbar()
     hide_task_diff_monitor = FALSE;
     hide_taskbar_if_empty = FALSE;
     always_show_all_desktop_tasks = FALSE;
-    taskbar_thumbnail_jobs_done = NULL;
     taskbar_sort_method = TASKBAR_NOSORT;
     taskbar_alignment = ALIGN_LEFT;
     default_taskbarname();
@@ -128,12 +137,31 @@ void taskbar_save_orderings()
     }
 }
 
+void cleanup_taskbar_panel(void *p)
+{
+    Panel *panel = (Panel *)p;
+    cleanup_taskbarname_panel(panel);
+    for (int j = 0; j < panel->num_desktops; j++) {
+        Taskbar *taskbar = &panel->taskbar[j];
+        free_area(&taskbar->area);
+        // remove taskbar from the panel
+        remove_area((Area *)taskbar);
+    }
+    if (panel->taskbar) {
+        free(panel->taskbar);
+        panel->taskbar = NULL;
+    }
+}
+
 void cleanup_taskbar()
 {
+    thumbnail_worker_stop();
     destroy_timer(&thumbnail_update_timer_all);
     destroy_timer(&thumbnail_update_timer_active);
     destroy_timer(&thumbnail_update_timer_tooltip);
-    g_list_free(taskbar_thumbnail_jobs_done);
+    destroy_timer(&thumbnail_update_timer_damage);
+    destroy_timer(&thumbnail_queue_timer);
+    taskbar_clear_thumbnail_queue();
     taskbar_save_orderings();
     if (win_to_task) {
         while (g_hash_table_size(win_to_task)) {
@@ -148,20 +176,9 @@ void cleanup_taskbar()
         g_hash_table_destroy(win_to_task);
         win_to_task = NULL;
     }
-    cleanup_taskbarname();
-    for (int i = 0; i < num_panels; i++) {
-        Panel *panel = &panels[i];
-        for (int j = 0; j < panel->num_desktops; j++) {
-            Taskbar *taskbar = &panel->taskbar[j];
-            free_area(&taskbar->area);
-            // remove taskbar from the panel
-            remove_area((Area *)taskbar);
-        }
-        if (panel->taskbar) {
-            free(panel->taskbar);
-            panel->taskbar = NULL;
-        }
-    }
+    cleanup_thumbnail_store();
+    for (int i = 0; i < num_panels; i++)
+        cleanup_taskbar_panel(&panels[i]);
 
     g_slist_free(urgent_list);
     urgent_list = NULL;
@@ -184,6 +201,8 @@ void init_taskbar()
     INIT_TIMER(thumbnail_update_timer_all);
     INIT_TIMER(thumbnail_update_timer_active);
     INIT_TIMER(thumbnail_update_timer_tooltip);
+    INIT_TIMER(thumbnail_update_timer_damage);
+    INIT_TIMER(thumbnail_queue_timer);
 
     if (!panel_config.g_task.has_text && !panel_config.g_task.has_icon) {
         panel_config.g_task.has_text = panel_config.g_task.has_icon = 1;
@@ -191,6 +210,12 @@ void init_taskbar()
 
     if (panel_config.g_task.thumbnail_width < 8)
         panel_config.g_task.thumbnail_width = 210;
+    if (panel_config.g_task.thumbnail_enabled) {
+        init_thumbnail_store((size_t)panel_config.g_task.thumbnail_cache_size * 1024 * 1024);
+        if (!thumbnail_queued_windows)
+            thumbnail_queued_windows = g_hash_table_new(g_direct_hash, g_direct_equal);
+        thumbnail_worker_start(task_set_thumbnail);
+    }
 
     if (!win_to_task)
         win_to_task = g_hash_table_new_full(win_hash, win_compare, free, free_ptr_array);
@@ -199,6 +224,19 @@ void init_taskbar()
     task_drag = 0;
 }
 
+void init_task_font_colors(void *p)
+{
+    Panel *panel = (Panel *)p;
+    if ((panel->g_task.config_font_mask & (1 << TASK_NORMAL)) == 0)
+        panel->g_task.font[TASK_NORMAL] = (Color){{1, 1, 1}, 1};
+    if ((panel->g_task.config_font_mask & (1 << TASK_ACTIVE)) == 0)
+        panel->g_task.font[TASK_ACTIVE] = panel->g_task.font[TASK_NORMAL];
+    if ((panel->g_task.config_font_mask & (1 << TASK_ICONIFIED)) == 0)
+        panel->g_task.font[TASK_ICONIFIED] = panel->g_task.font[TASK_NORMAL];
+    if ((panel->g_task.config_font_mask & (1 << TASK_URGENT)) == 0)
+        panel->g_task.font[TASK_URGENT] = panel->g_task.font[TASK_ACTIVE];
+}
+
 void init_taskbar_panel(void *p)
 {
     Panel *panel = (Panel *)p;
@@ -279,14 +317,7 @@ void init_taskbar_panel(void *p)
         panel->g_task.saturation[TASK_URGENT] = panel->g_task.saturation[TASK_ACTIVE];
         panel->g_task.brightness[TASK_URGENT] = panel->g_task.brightness[TASK_ACTIVE];
     }
-    if ((panel->g_task.config_font_mask & (1 << TASK_NORMAL)) == 0)
-        panel->g_task.font[TASK_NORMAL] = (Color){{1, 1, 1}, 1};
-    if ((panel->g_task.config_font_mask & (1 << TASK_ACTIVE)) == 0)
-        panel->g_task.font[TASK_ACTIVE] = panel->g_task.font[TASK_NORMAL];
-    if ((panel->g_task.config_font_mask & (1 << TASK_ICONIFIED)) == 0)
-        panel->g_task.font[TASK_ICONIFIED] = panel->g_task.font[TASK_NORMAL];
-    if ((panel->g_task.config_font_mask & (1 << TASK_URGENT)) == 0)
-        panel->g_task.font[TASK_URGENT] = panel->g_task.font[TASK_ACTIVE];
+    init_task_font_colors(panel);
     if ((panel->g_task.config_background_mask & (1 << TASK_NORMAL)) == 0)
         panel->g_task.background[TASK_NORMAL] = &g_array_index(backgrounds, Background, 0);
     if ((panel->g_task.config_background_mask & (1 << TASK_ACTIVE)) == 0)
@@ -828,48 +859,185 @@ void update_minimized_icon_positions(void *p)
     }
 }
 
+// Returns how urgently the thumbnail of the window is needed
+static ThumbnailPriority task_thumbnail_priority(Task *t)
+{
+    gboolean visible = FALSE;
+    GPtrArray *task_buttons = get_task_buttons(t->win);
+    for (int i = 0; task_buttons && i < task_buttons->len; ++i) {
+        Task *task2 = g_ptr_array_index(task_buttons, i);
+        if (g_tooltip.mapped && g_tooltip.area == &task2->area)
+            return THUMB_PRIORITY_TOOLTIP;
+        Taskbar *taskbar = (Taskbar *)task2->area.parent;
+        if (task2->area.on_screen && taskbar && taskbar->desktop == server.desktop)
+            visible = TRUE;
+    }
+    if (active_task && active_task->win == t->win)
+        return THUMB_PRIORITY_ACTIVE;
+    return visible ? THUMB_PRIORITY_VISIBLE : THUMB_PRIORITY_OTHER;
+}
+
+static void taskbar_process_thumbnail_queue(void *arg)
+{
+    double start_time = get_time();
+    for (int priority = 0; priority < THUMB_PRIORITY_COUNT; priority++) {
+        while (!g_queue_is_empty(&thumbnail_queue[priority])) {
+            if (get_time() - start_time > thumbnail_budget_ms / 1000.0) {
+                // Out of time for this event loop iteration, continue in the next one
+                change_timer(&thumbnail_queue_timer, true, 0, 0, taskbar_process_thumbnail_queue, NULL);
+                return;
+            }
+            Window win = (Window)GPOINTER_TO_SIZE(g_queue_pop_head(&thumbnail_queue[priority]));
+            g_hash_table_remove(thumbnail_queued_windows, GSIZE_TO_POINTER(win));
+            Task *t = get_task(win);
+            if (t)
+                task_refresh_thumbnail(t);
+        }
+    }
+}
+
+void taskbar_queue_thumbnail(Task *t)
+{
+    if (!panel_config.g_task.thumbnail_enabled || !thumbnail_queued_windows)
+        return;
+    ThumbnailPriority priority = task_thumbnail_priority(t);
+    // The table holds priority + 1 for each queued window, so that NULL means not queued
+    gpointer queued = g_hash_table_lookup(thumbnail_queued_windows, GSIZE_TO_POINTER(t->win));
+    if (queued) {
+        ThumbnailPriority old_priority = (ThumbnailPriority)(GPOINTER_TO_INT(queued) - 1);
+        if (old_priority <= priority)
+            return;
+        g_queue_remove(&thumbnail_queue[old_priority], GSIZE_TO_POINTER(t->win));
+    }
+    g_queue_push_tail(&thumbnail_queue[priority], GSIZE_TO_POINTER(t->win));
+    g_hash_table_insert(thumbnail_queued_windows, GSIZE_TO_POINTER(t->win), GINT_TO_POINTER(priority + 1));
+    if (!thumbnail_queue_timer.enabled_)
+        change_timer(&thumbnail_queue_timer, true, 0, 0, taskbar_process_thumbnail_queue, NULL);
+}
+
+static void taskbar_clear_thumbnail_queue()
+{
+    for (int priority = 0; priority < THUMB_PRIORITY_COUNT; priority++)
+        g_queue_clear(&thumbnail_queue[priority]);
+    if (thumbnail_queued_windows) {
+        g_hash_table_destroy(thumbnail_queued_windows);
+        thumbnail_queued_windows = NULL;
+    }
+}
+
 void taskbar_update_thumbnails(void *arg)
 {
-    if (!panel_config.g_task.thumbnail_enabled)
+    if (!panel_config.g_task.thumbnail_enabled || !win_to_task)
         return;
     ThumbnailUpdateMode mode = (ThumbnailUpdateMode)(long)arg;
     if (debug_thumbnails)
         fprintf(stderr, BLUE "tint2: taskbar_update_thumbnails %s" RESET "\n", mode == THUMB_MODE_ACTIVE_WINDOW ? "active" : mode == THUMB_MODE_TOOLTIP_WINDOW ? "tooltip" : "all");
-    double start_time = get_time();
-    for (int i = 0; i < num_panels; i++) {
-        Panel *panel = &panels[i];
-        for (int j = 0; j < panel->num_desktops; j++) {
-            Taskbar *taskbar = &panel->taskbar[j];
-            for (GList *c = (taskbar->area.children && taskbarname_enabled) ? taskbar->area.children->next
-                                                                            : taskbar->area.children;
-                 c;
-                 c = c->next) {
-                Task *t = (Task *)c->data;
-                if ((mode == THUMB_MODE_ALL && t->current_state == TASK_ACTIVE && !g_list_find(taskbar_thumbnail_jobs_done, t)) ||
-                    (mode == THUMB_MODE_ACTIVE_WINDOW && t->current_state == TASK_ACTIVE) ||
-                    (mode == THUMB_MODE_TOOLTIP_WINDOW && g_tooltip.mapped && g_tooltip.area == &t->area)) {
-                    task_refresh_thumbnail(t);
-                    if (mode == THUMB_MODE_ALL)
-                        taskbar_thumbnail_jobs_done = g_list_append(taskbar_thumbnail_jobs_done, t);
-                    if (t->thumbnail && mode == THUMB_MODE_TOOLTIP_WINDOW) {
-                        taskbar_start_thumbnail_timer(THUMB_MODE_TOOLTIP_WINDOW);
-                    }
-                }
-                if (mode == THUMB_MODE_ALL) {
-                    double now = get_time();
-                    if (now - start_time > 0.030) {
-                        change_timer(&thumbnail_update_timer_all, true, 50, 10 * 1000, taskbar_update_thumbnails, arg);
-                        return;
-                    }
-                }
-            }
+    if (mode == THUMB_MODE_ACTIVE_WINDOW) {
+        if (active_task)
+            taskbar_queue_thumbnail(active_task);
+        return;
+    }
+    if (mode == THUMB_MODE_TOOLTIP_WINDOW) {
+        if (!g_tooltip.mapped || !g_tooltip.area || g_tooltip.area->_get_tooltip_image != task_get_thumbnail)
+            return;
+        Task *t = (Task *)g_tooltip.area;
+        taskbar_queue_thumbnail(t);
+        // With XDamage, the tooltip thumbnail is refreshed when the window reports changes
+        if (!t->thumbnail_damage && thumbnail_store_contains(t->win))
+            taskbar_start_thumbnail_timer(THUMB_MODE_TOOLTIP_WINDOW);
+        return;
+    }
+    // Refresh the stale thumbnails, once per window even if it has buttons on several taskbars.
+    // Missing thumbnails are only captured ahead of time for the windows that are likely to be hovered.
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, win_to_task);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        GPtrArray *task_buttons = (GPtrArray *)value;
+        if (!task_buttons->len)
+            continue;
+        Task *t = g_ptr_array_index(task_buttons, 0);
+        if (t->current_state == TASK_ICONIFIED)
+            continue;
+        if (thumbnail_store_contains(t->win)) {
+            if (t->thumbnail_damage && !t->thumbnail_dirty)
+                continue;
+        } else if (task_thumbnail_priority(t) > THUMB_PRIORITY_VISIBLE) {
+            continue;
         }
+        taskbar_queue_thumbnail(t);
     }
-    if (mode == THUMB_MODE_ALL) {
-        if (taskbar_thumbnail_jobs_done) {
-            g_list_free(taskbar_thumbnail_jobs_done);
-            taskbar_thumbnail_jobs_done = NULL;
-            change_timer(&thumbnail_update_timer_all, true, 10 * 1000, 10 * 1000, taskbar_update_thumbnails, arg);
+}
+
+void taskbar_update_damaged_thumbnails(void *arg)
+{
+    if (!panel_config.g_task.thumbnail_enabled || !win_to_task)
+        return;
+    double now = get_time();
+    double next_due = -1;
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, win_to_task);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        GPtrArray *task_buttons = (GPtrArray *)value;
+        if (!task_buttons->len)
+            continue;
+        Task *t = g_ptr_array_index(task_buttons, 0);
+        // Minimized windows are damaged again when they are mapped
+        if (!t->thumbnail_dirty || t->current_state == TASK_ICONIFIED)
+            continue;
+        double due = t->thumbnail_last_update + task_thumbnail_staleness_budget(t);
+        if (due <= now) {
+            // If the capture fails, the window stays dirty and is picked up by the periodic update
+            taskbar_queue_thumbnail(t);
+            continue;
         }
+        if (next_due < 0 || due < next_due)
+            next_due = due;
+    }
+    if (next_due >= 0) {
+        thumbnail_damage_due = next_due;
+        change_timer(&thumbnail_update_timer_damage,
+                     true,
+                     (int)(1000 * (next_due - now)),
+                     0,
+                     taskbar_update_damaged_thumbnails,
+                     NULL);
+    } else {
+        stop_timer(&thumbnail_update_timer_damage);
     }
 }
+
+gboolean taskbar_handle_damage(Window win)
+{
+    GPtrArray *task_buttons = get_task_buttons(win);
+    if (!task_buttons || !task_buttons->len)
+        return FALSE;
+    Task *t = g_ptr_array_index(task_buttons, 0);
+    if (!t->thumbnail_damage)
+        return FALSE;
+    if (t->thumbnail_dirty)
+        return TRUE;
+    for (int i = 0; i < task_buttons->len; ++i) {
+        Task *task2 = g_ptr_array_index(task_buttons, i);
+        task2->thumbnail_dirty = TRUE;
+    }
+    // Refresh at most once per staleness budget, no matter how often the window redraws
+    double now = get_time();
+    double due = MAX(now, t->thumbnail_last_update + task_thumbnail_staleness_budget(t));
+    if (!thumbnail_update_timer_damage.enabled_ || due < thumbnail_damage_due) {
+        thumbnail_damage_due = due;
+        change_timer(&thumbnail_update_timer_damage,
+                     true,
+                     (int)(1000 * (due - now)),
+                     0,
+                     taskbar_update_damaged_thumbnails,
+                     NULL);
+    }
+    if (debug_thumbnails)
+        fprintf(stderr,
+                "tint2: window damaged: %s, thumbnail update in %.0f ms\n",
+                t->title ? t->title : "",
+                1000 * (due - now));
+    return TRUE;
+}
@@ -32,6 +32,15 @@ typedef enum ThumbnailUpdateMode {
     THUMB_MODE_ALL
 } ThumbnailUpdateMode;
 
+// Thumbnails are refreshed in this order
+typedef enum ThumbnailPriority {
+    THUMB_PRIORITY_TOOLTIP = 0,
+    THUMB_PRIORITY_ACTIVE,
+    THUMB_PRIORITY_VISIBLE,
+    THUMB_PRIORITY_OTHER,
+    THUMB_PRIORITY_COUNT
+} ThumbnailPriority;
+
 typedef struct {
     Area area;
     gchar *name;
@@ -63,6 +72,8 @@ extern gboolean hide_taskbar_if_empty;
 extern gboolean always_show_all_desktop_tasks;
 extern TaskbarSortMethod taskbar_sort_method;
 extern Alignment taskbar_alignment;
+// Time that may be spent refreshing thumbnails in each event loop iteration
+extern int thumbnail_budget_ms;
 
 // win_to_task holds for every Window an array of tasks. Usually the array contains only one
 // element. However for omnipresent windows (windows which are visible in every taskbar) the array
@@ -76,10 +87,20 @@ void default_taskbar();
 void cleanup_taskbar();
 void init_taskbar();
 void init_taskbar_panel(void *p);
+// Sets the font colors of the task states that have none configured (see config_font_mask)
+void init_task_font_colors(void *p);
+// Frees the taskbars of a panel, which must not have tasks anymore.
+void cleanup_taskbar_panel(void *p);
 
 gboolean resize_taskbar(void *obj);
 void taskbar_default_font_changed();
 void taskbar_start_thumbnail_timer(ThumbnailUpdateMode mode);
+// Schedules a refresh of the thumbnail of the task's window. Requests are de-duplicated per window and
+// processed by priority, within a time budget of thumbnail_budget_ms per event loop iteration.
+void taskbar_queue_thumbnail(Task *t);
+
+// Handles an XDamage notification for a window. Returns TRUE if the window belongs to a task.
+gboolean taskbar_handle_damage(Window win);
 
 // Reloads the entire list of tasks from the window manager and recreates the task buttons.
 void taskbar_refresh_tasklist();
@@ -116,20 +116,24 @@ void taskbarname_default_font_changed()
     schedule_panel_redraw();
 }
 
-void cleanup_taskbarname()
+void cleanup_taskbarname_panel(void *p)
 {
-    for (int i = 0; i < num_panels; i++) {
-        Panel *panel = &panels[i];
-        for (int j = 0; j < panel->num_desktops; j++) {
-            Taskbar *taskbar = &panel->taskbar[j];
-            g_free(taskbar->bar_name.name);
-            taskbar->bar_name.name = NULL;
-            free_area(&taskbar->bar_name.area);
-            remove_area((Area *)&taskbar->bar_name);
-        }
+    Panel *panel = (Panel *)p;
+    for (int j = 0; j < panel->num_desktops; j++) {
+        Taskbar *taskbar = &panel->taskbar[j];
+        g_free(taskbar->bar_name.name);
+        taskbar->bar_name.name = NULL;
+        free_area(&taskbar->bar_name.area);
+        remove_area((Area *)&taskbar->bar_name);
     }
 }
 
+void cleanup_taskbarname()
+{
+    for (int i = 0; i < num_panels; i++)
+        cleanup_taskbarname_panel(&panels[i]);
+}
+
 int taskbarname_compute_desired_size(void *obj)
 {
     TaskbarName *taskbar_name = (TaskbarName *)obj;
@@ -16,6 +16,7 @@ void default_taskbarname();
 void cleanup_taskbarname();
 
 void init_taskbarname_panel(void *p);
+void cleanup_taskbarname_panel(void *p);
 
 void draw_taskbarname(void *obj, cairo_t *c);
 
@@ -0,0 +1,141 @@
+/**************************************************************************
+*
+* Tint2 : bounded store of window thumbnails
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "panel.h"
+#include "thumbnail_store.h"
+
+typedef struct ThumbnailEntry {
+    Window win;
+    cairo_surface_t *thumbnail;
+    size_t size;
+    // Node in lru_list, which holds the most recently used entries first
+    GList *link;
+} ThumbnailEntry;
+
+typedef struct ThumbnailStoreStats {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    size_t peak_bytes;
+} ThumbnailStoreStats;
+
+static GHashTable *entries;
+static GQueue lru_list = G_QUEUE_INIT;
+static size_t total_bytes;
+static size_t budget;
+static ThumbnailStoreStats stats;
+
+static void print_thumbnail_store_stats()
+{
+    fprintf(stderr,
+            "tint2: thumbnail store: %u thumbnails, %zu / %zu KiB (peak %zu KiB), "
+            "%lu hits, %lu misses, %lu evictions\n",
+            g_hash_table_size(entries),
+            total_bytes / 1024,
+            budget / 1024,
+            stats.peak_bytes / 1024,
+            stats.hits,
+            stats.misses,
+            stats.evictions);
+}
+
+static void free_thumbnail_entry(gpointer data)
+{
+    ThumbnailEntry *entry = (ThumbnailEntry *)data;
+    g_queue_delete_link(&lru_list, entry->link);
+    total_bytes -= entry->size;
+    cairo_surface_destroy(entry->thumbnail);
+    free(entry);
+}
+
+void init_thumbnail_store(size_t budget_bytes)
+{
+    if (!entries)
+        entries = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free_thumbnail_entry);
+    budget = budget_bytes;
+}
+
+void cleanup_thumbnail_store()
+{
+    if (!entries)
+        return;
+    if (debug_thumbnails)
+        print_thumbnail_store_stats();
+    g_hash_table_destroy(entries);
+    entries = NULL;
+    total_bytes = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+cairo_surface_t *thumbnail_store_get(Window win)
+{
+    if (!entries)
+        return NULL;
+    ThumbnailEntry *entry = (ThumbnailEntry *)g_hash_table_lookup(entries, GINT_TO_POINTER(win));
+    if (!entry) {
+        stats.misses++;
+        return NULL;
+    }
+    stats.hits++;
+    g_queue_unlink(&lru_list, entry->link);
+    g_queue_push_head_link(&lru_list, entry->link);
+    return entry->thumbnail;
+}
+
+gboolean thumbnail_store_contains(Window win)
+{
+    return entries && g_hash_table_contains(entries, GINT_TO_POINTER(win));
+}
+
+void thumbnail_store_put(Window win, cairo_surface_t *thumbnail)
+{
+    if (!entries) {
+        cairo_surface_destroy(thumbnail);
+        return;
+    }
+    ThumbnailEntry *entry = calloc(1, sizeof(ThumbnailEntry));
+    entry->win = win;
+    entry->thumbnail = thumbnail;
+    entry->size = (size_t)cairo_image_surface_get_stride(thumbnail) * (size_t)cairo_image_surface_get_height(thumbnail);
+    g_queue_push_head(&lru_list, entry);
+    entry->link = lru_list.head;
+    total_bytes += entry->size;
+    // Replaces (and frees) the previous entry of the window, if any
+    g_hash_table_insert(entries, GINT_TO_POINTER(win), entry);
+
+    // Evict the least recently used thumbnails; the new one is always kept
+    while (total_bytes > budget && lru_list.tail != entry->link) {
+        ThumbnailEntry *victim = (ThumbnailEntry *)lru_list.tail->data;
+        if (debug_thumbnails)
+            fprintf(stderr, "tint2: evicting thumbnail of window %lu (%zu KiB)\n", victim->win, victim->size / 1024);
+        g_hash_table_remove(entries, GINT_TO_POINTER(victim->win));
+        stats.evictions++;
+    }
+    stats.peak_bytes = MAX(stats.peak_bytes, total_bytes);
+    if (debug_thumbnails)
+        print_thumbnail_store_stats();
+}
+
+void thumbnail_store_remove(Window win)
+{
+    if (entries)
+        g_hash_table_remove(entries, GINT_TO_POINTER(win));
+}
@@ -0,0 +1,23 @@
+#ifndef THUMBNAIL_STORE_H
+#define THUMBNAIL_STORE_H
+
+#include <glib.h>
+#include <X11/Xlib.h>
+#include <cairo.h>
+
+// Keeps the window thumbnails, shared by all the task buttons of a window.
+// The total size is bounded by a byte budget; the least recently used thumbnails are evicted first.
+
+void init_thumbnail_store(size_t budget_bytes);
+void cleanup_thumbnail_store();
+
+// Returns the thumbnail of the window and marks it as recently used, or NULL if there is none.
+// The store keeps ownership; take a reference to keep the surface.
+cairo_surface_t *thumbnail_store_get(Window win);
+// Like thumbnail_store_get, without affecting the eviction order.
+gboolean thumbnail_store_contains(Window win);
+// Stores the thumbnail of the window, replacing the previous one. Takes ownership of the reference.
+void thumbnail_store_put(Window win, cairo_surface_t *thumbnail);
+void thumbnail_store_remove(Window win);
+
+#endif
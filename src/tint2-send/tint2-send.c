@@ -6,11 +6,10 @@
 #include <string.h>
 
 static Display *display = 0;
+static Atom tint2_refresh_execp = None;
 
 /* From wmctrl */
-char *get_property(Window window, Atom xa_prop_type, const char *prop_name) {
-    Atom xa_prop_name = XInternAtom(display, prop_name, False);
-
+char *get_property(Window window, Atom xa_prop_type, Atom xa_prop_name) {
     Atom xa_ret_type;
     int ret_format;
     unsigned long ret_nitems;
@@ -48,7 +47,7 @@ int is_tint2(Window window)
     // if (attr.map_state != IsViewable)
     //     return 0;
 
-    char *wm_class = get_property(window, XA_STRING, "WM_NAME");
+    char *wm_class = get_property(window, XA_STRING, XA_WM_NAME);
     if (!wm_class) {
         return 0;
     }
@@ -103,7 +102,7 @@ void handle_tint2_window(Window window, char *action, char **args)
         event.xclient.type = ClientMessage;
         event.xclient.window = window;
         event.xclient.send_event = True;
-        event.xclient.message_type = XInternAtom(display, "_TINT2_REFRESH_EXECP", False);
+        event.xclient.message_type = tint2_refresh_execp;
         event.xclient.format = 8;
         strncpy(event.xclient.data.b, name, sizeof(event.xclient.data.b));
         XSendEvent(display, window, False, 0, &event);
@@ -146,6 +145,8 @@ int main(int argc, char **argv)
     }
     char *action = argv[0];
     char **args = argv + 1;
+    // Interned once, not for every window visited
+    tint2_refresh_execp = XInternAtom(display, "_TINT2_REFRESH_EXECP", False);
     walk_windows(DefaultRootWindow(display), handle_tint2_window, action, args);
 
     return 0;
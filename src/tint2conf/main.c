@@ -29,6 +29,7 @@
 #include "theme_view.h"
 #include "properties.h"
 #include "properties_rw.h"
+#include "../launcher/apps-common.h"
 
 void refresh_theme(const char *given_path);
 void remove_theme(const char *given_path);
@@ -701,6 +702,7 @@ static gboolean edit_theme(gpointer ignored)
     GtkWidget *prop = create_properties();
     config_read_file(filepath);
     save_icon_cache(icon_theme);
+    save_desktop_entry_cache();
     gtk_window_present(GTK_WINDOW(prop));
     g_free(filepath);
 
@@ -101,7 +101,8 @@ GtkWidget *systray_background, *systray_monitor, *systray_name_filter;
 
 // tooltip
 GtkWidget *tooltip_padding_x, *tooltip_padding_y, *tooltip_font, *tooltip_font_set, *tooltip_font_color;
-GtkWidget *tooltip_task_show, *tooltip_show_after, *tooltip_hide_after, *tooltip_task_thumbnail, *tooltip_task_thumbnail_size;
+GtkWidget *tooltip_task_show, *tooltip_show_after, *tooltip_hide_after, *tooltip_task_thumbnail, *tooltip_task_thumbnail_size,
+    *tooltip_task_thumbnail_cache_size;
 GtkWidget *clock_format_tooltip, *clock_tmz_tooltip;
 GtkWidget *tooltip_background;
 
@@ -1860,6 +1861,7 @@ void icon_theme_changed(gpointer data)
     load_icons(launcher_apps);
     load_icons(all_apps);
     save_icon_cache(icon_theme);
+    save_desktop_entry_cache();
 
     destroy_please_wait();
 }
@@ -3444,6 +3446,24 @@ void create_task(GtkWidget *parent)
     gtk_table_attach(GTK_TABLE(table), tooltip_task_thumbnail_size, col, col + 1, row, row + 1, GTK_FILL, 0, 0, 0);
     col++;
 
+    row++, col = 2;
+    label = gtk_label_new(_("Thumbnail memory (MiB)"));
+    gtk_misc_set_alignment(GTK_MISC(label), 0, 0);
+    gtk_widget_show(label);
+    gtk_table_attach(GTK_TABLE(table), label, col, col + 1, row, row + 1, GTK_FILL, 0, 0, 0);
+    col++;
+
+    tooltip_task_thumbnail_cache_size = gtk_spin_button_new_with_range(1, 4096, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_task_thumbnail_cache_size), 32);
+    gtk_widget_show(tooltip_task_thumbnail_cache_size);
+    gtk_table_attach(GTK_TABLE(table), tooltip_task_thumbnail_cache_size, col, col + 1, row, row + 1, GTK_FILL, 0, 0, 0);
+    col++;
+    gtk_tooltips_set_tip(tooltips,
+                         tooltip_task_thumbnail_cache_size,
+                         _("Specifies how much memory the window thumbnails may use in total. "
+                           "When the limit is reached, the least recently used thumbnails are discarded."),
+                         NULL);
+
     row++, col = 2;
     label = gtk_label_new(_("Maximum width"));
     gtk_misc_set_alignment(GTK_MISC(label), 0, 0);
@@ -4478,6 +4498,25 @@ void create_execp(GtkWidget *notebook, int i)
                            "such as 'ping 127.0.0.1'. If zero, the output of the command is "
                            "displayed after it finishes executing."),
                          NULL);
+
+    row++, col = 2;
+    label = gtk_label_new(_("Maximum output size"));
+    gtk_misc_set_alignment(GTK_MISC(label), 0, 0);
+    gtk_widget_show(label);
+    gtk_table_attach(GTK_TABLE(table), label, col, col + 1, row, row + 1, GTK_FILL, 0, 0, 0);
+    col++;
+
+    executor->execp_max_buffer_size = gtk_spin_button_new_with_range(1024, 1000000000, 1024);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(executor->execp_max_buffer_size), 65536);
+    gtk_widget_show(executor->execp_max_buffer_size);
+    gtk_table_attach(GTK_TABLE(table), executor->execp_max_buffer_size, col, col + 1, row, row + 1, GTK_FILL, 0, 0, 0);
+    col++;
+    gtk_tooltips_set_tip(tooltips,
+                         executor->execp_max_buffer_size,
+                         _("Specifies the maximum number of bytes of output buffered for the command. "
+                           "Output beyond this size is dropped; in continuous mode, records larger than "
+                           "this size are skipped."),
+                         NULL);
     row++, col = 2;
     label = gtk_label_new(_("Display markup"));
     gtk_misc_set_alignment(GTK_MISC(label), 0, 0);
@@ -6,6 +6,7 @@
 #include "common.h"
 #include "properties.h"
 #include "properties_rw.h"
+#include "../config_keys.h"
 #include "gradient_gui.h"
 
 void finalize_gradient();
@@ -109,7 +110,8 @@ void config_write_gradients(FILE *fp)
 
         fprintf(fp, "# Gradient %d\n", index);
         fprintf(fp,
-                "gradient = %s\n",
+                "%s = %s\n",
+                CONFIG_KEY_NAME(GRADIENT),
                 g->type == GRADIENT_CONFIG_HORIZONTAL ? "horizontal" : g->type == GRADIENT_CONFIG_VERTICAL ? "vertical"
                                                                                                            : "radial");
 
@@ -118,11 +120,11 @@ void config_write_gradients(FILE *fp)
                             g->start_color.color.rgb[2],
                             &color);
         opacity = g->start_color.color.alpha * 100;
-        config_write_color(fp, "start_color", color, opacity);
+        config_write_color(fp, CONFIG_KEY_NAME(START_COLOR), color, opacity);
 
         cairoColor2GdkColor(g->end_color.color.rgb[0], g->end_color.color.rgb[1], g->end_color.color.rgb[2], &color);
         opacity = g->end_color.color.alpha * 100;
-        config_write_color(fp, "end_color", color, opacity);
+        config_write_color(fp, CONFIG_KEY_NAME(END_COLOR), color, opacity);
 
         for (GList *l = g->extra_color_stops; l; l = l->next) {
             GradientConfigColorStop *stop = (GradientConfigColorStop *)l->data;
@@ -130,7 +132,8 @@ void config_write_gradients(FILE *fp)
             cairoColor2GdkColor(stop->color.rgb[0], stop->color.rgb[1], stop->color.rgb[2], &color);
             opacity = stop->color.alpha * 100;
             fprintf(fp,
-                    "color_stop = %f #%02x%02x%02x %d\n",
+                    "%s = %f #%02x%02x%02x %d\n",
+                    CONFIG_KEY_NAME(COLOR_STOP),
                     stop->offset * 100,
                     color.red >> 8,
                     color.green >> 8,
@@ -236,8 +239,8 @@ void config_write_backgrounds(FILE *fp)
                            &border_weight,
                            -1);
         fprintf(fp, "# Background %d: %s\n", index, text ? text : "");
-        fprintf(fp, "rounded = %d\n", r);
-        fprintf(fp, "border_width = %d\n", b);
+        fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(ROUNDED), r);
+        fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(BORDER_WIDTH), b);
 
         char sides[10];
         sides[0] = '\0';
@@ -249,23 +252,23 @@ void config_write_backgrounds(FILE *fp)
             strlcat(sides, "L", sizeof(sides));
         if (sideRight)
             strlcat(sides, "R", sizeof(sides));
-        fprintf(fp, "border_sides = %s\n", sides);
+        fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BORDER_SIDES), sides);
 
-        fprintf(fp, "border_content_tint_weight = %d\n", (int)(border_weight));
-        fprintf(fp, "background_content_tint_weight = %d\n", (int)(fill_weight));
+        fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(BORDER_CONTENT_TINT_WEIGHT), (int)(border_weight));
+        fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(BACKGROUND_CONTENT_TINT_WEIGHT), (int)(fill_weight));
 
-        config_write_color(fp, "background_color", *fillColor, fillOpacity);
-        config_write_color(fp, "border_color", *borderColor, borderOpacity);
+        config_write_color(fp, CONFIG_KEY_NAME(BACKGROUND_COLOR), *fillColor, fillOpacity);
+        config_write_color(fp, CONFIG_KEY_NAME(BORDER_COLOR), *borderColor, borderOpacity);
         if (gradient_id >= 0)
-            fprintf(fp, "gradient_id = %d\n", gradient_id);
-        config_write_color(fp, "background_color_hover", *fillColorOver, fillOpacityOver);
-        config_write_color(fp, "border_color_hover", *borderColorOver, borderOpacityOver);
+            fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(GRADIENT_ID), gradient_id);
+        config_write_color(fp, CONFIG_KEY_NAME(BACKGROUND_COLOR_HOVER), *fillColorOver, fillOpacityOver);
+        config_write_color(fp, CONFIG_KEY_NAME(BORDER_COLOR_HOVER), *borderColorOver, borderOpacityOver);
         if (gradient_id_over >= 0)
-            fprintf(fp, "gradient_id_hover = %d\n", gradient_id_over);
-        config_write_color(fp, "background_color_pressed", *fillColorPress, fillOpacityPress);
-        config_write_color(fp, "border_color_pressed", *borderColorPress, borderOpacityPress);
+            fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(GRADIENT_ID_HOVER), gradient_id_over);
+        config_write_color(fp, CONFIG_KEY_NAME(BACKGROUND_COLOR_PRESSED), *fillColorPress, fillOpacityPress);
+        config_write_color(fp, CONFIG_KEY_NAME(BORDER_COLOR_PRESSED), *borderColorPress, borderOpacityPress);
         if (gradient_id_press >= 0)
-            fprintf(fp, "gradient_id_pressed = %d\n", gradient_id_press);
+            fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(GRADIENT_ID_PRESSED), gradient_id_press);
         fprintf(fp, "\n");
     }
 }
@@ -275,29 +278,44 @@ void config_write_panel(FILE *fp)
     fprintf(fp, "#-------------------------------------\n");
     fprintf(fp, "# Panel\n");
     char *items = get_panel_items();
-    fprintf(fp, "panel_items = %s\n", items);
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(PANEL_ITEMS), items);
     free(items);
     fprintf(fp,
-            "panel_size = %d%s %d%s\n",
+            "%s = %d%s %d%s\n",
+            CONFIG_KEY_NAME(PANEL_SIZE),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_width)),
             gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_width_type)) == 0 ? "%" : "",
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_height)),
             gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_height_type)) == 0 ? "%" : "");
     fprintf(fp,
-            "panel_margin = %d %d\n",
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(PANEL_MARGIN),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_margin_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_margin_y)));
     fprintf(fp,
-            "panel_padding = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(PANEL_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_padding_y)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_spacing)));
-    fprintf(fp, "panel_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(panel_background)));
-    fprintf(fp, "wm_menu = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_wm_menu)) ? 1 : 0);
-    fprintf(fp, "panel_dock = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_dock)) ? 1 : 0);
-    fprintf(fp, "panel_pivot_struts = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_pivot_struts)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(PANEL_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(panel_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(WM_MENU),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_wm_menu)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(PANEL_DOCK),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_dock)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(PANEL_PIVOT_STRUTS),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_pivot_struts)) ? 1 : 0);
 
-    fprintf(fp, "panel_position = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(PANEL_POSITION));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(screen_position[POS_BLH]))) {
         fprintf(fp, "bottom left horizontal");
     } else if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(screen_position[POS_BCH]))) {
@@ -325,7 +343,7 @@ void config_write_panel(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "panel_layer = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(PANEL_LAYER));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_layer)) == 0) {
         fprintf(fp, "top");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_layer)) == 1) {
@@ -335,7 +353,7 @@ void config_write_panel(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "panel_monitor = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(PANEL_MONITOR));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_monitor)) <= 0) {
         fprintf(fp, "all");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_monitor)) == 1) {
@@ -345,20 +363,44 @@ void config_write_panel(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "panel_shrink = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_shrink)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(PANEL_SHRINK),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_shrink)) ? 1 : 0);
 
-    fprintf(fp, "autohide = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_autohide)) ? 1 : 0);
-    fprintf(fp, "autohide_show_timeout = %g\n", gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_show_time)));
-    fprintf(fp, "autohide_hide_timeout = %g\n", gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_hide_time)));
-    fprintf(fp, "autohide_height = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_size)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(AUTOHIDE),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_autohide)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %g\n",
+            CONFIG_KEY_NAME(AUTOHIDE_SHOW_TIMEOUT),
+            gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_show_time)));
+    fprintf(fp,
+            "%s = %g\n",
+            CONFIG_KEY_NAME(AUTOHIDE_HIDE_TIMEOUT),
+            gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_hide_time)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(AUTOHIDE_HEIGHT),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(panel_autohide_size)));
 
-    fprintf(fp, "panel_lclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_left_command)));
-    fprintf(fp, "panel_rclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_right_command)));
-    fprintf(fp, "panel_mclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_mclick_command)));
-    fprintf(fp, "panel_uwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_uwheel_command)));
-    fprintf(fp, "panel_dwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_dwheel_command)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(PANEL_LCLICK_COMMAND), gtk_entry_get_text(GTK_ENTRY(panel_left_command)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(PANEL_RCLICK_COMMAND), gtk_entry_get_text(GTK_ENTRY(panel_right_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(PANEL_MCLICK_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(panel_mclick_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(PANEL_UWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(panel_uwheel_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(PANEL_DWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(panel_dwheel_command)));
 
-    fprintf(fp, "strut_policy = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(STRUT_POLICY));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_strut_policy)) == 0) {
         fprintf(fp, "follow_size");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(panel_combo_strut_policy)) == 1) {
@@ -368,28 +410,39 @@ void config_write_panel(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "panel_window_name = %s\n", gtk_entry_get_text(GTK_ENTRY(panel_window_name)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(PANEL_WINDOW_NAME), gtk_entry_get_text(GTK_ENTRY(panel_window_name)));
     fprintf(fp,
-            "disable_transparency = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(DISABLE_TRANSPARENCY),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(disable_transparency)) ? 1 : 0);
-    fprintf(fp, "mouse_effects = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_mouse_effects)) ? 1 : 0);
-    fprintf(fp, "font_shadow = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(font_shadow)) ? 1 : 0);
     fprintf(fp,
-            "mouse_hover_icon_asb = %d %d %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(MOUSE_EFFECTS),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(panel_mouse_effects)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(FONT_SHADOW),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(font_shadow)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(MOUSE_HOVER_ICON_ASB),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_hover_icon_opacity)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_hover_icon_saturation)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_hover_icon_brightness)));
     fprintf(fp,
-            "mouse_pressed_icon_asb = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(MOUSE_PRESSED_ICON_ASB),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_pressed_icon_opacity)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_pressed_icon_saturation)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(mouse_pressed_icon_brightness)));
 
     fprintf(fp,
-            "scale_relative_to_dpi = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(SCALE_RELATIVE_TO_DPI),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(scale_relative_to_dpi)));
     fprintf(fp,
-            "scale_relative_to_screen_height = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(SCALE_RELATIVE_TO_SCREEN_HEIGHT),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(scale_relative_to_screen_height)));
 
     fprintf(fp, "\n");
@@ -401,64 +454,85 @@ void config_write_taskbar(FILE *fp)
     fprintf(fp, "# Taskbar\n");
 
     fprintf(fp,
-            "taskbar_mode = %s\n",
+            "%s = %s\n",
+            CONFIG_KEY_NAME(TASKBAR_MODE),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_show_desktop)) ? "multi_desktop" : "single_desktop");
     fprintf(fp,
-            "taskbar_hide_if_empty = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_HIDE_IF_EMPTY),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_hide_empty)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_padding = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(TASKBAR_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(taskbar_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(taskbar_padding_y)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(taskbar_spacing)));
-    fprintf(fp, "taskbar_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_inactive_background)));
     fprintf(fp,
-            "taskbar_active_background_id = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_inactive_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_ACTIVE_BACKGROUND_ID),
             gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_active_background)));
-    fprintf(fp, "taskbar_name = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_show_name)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_hide_inactive_tasks = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_NAME),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_show_name)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_HIDE_INACTIVE_TASKS),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_hide_inactive_tasks)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_hide_different_monitor = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_HIDE_DIFFERENT_MONITOR),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_hide_diff_monitor)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_hide_different_desktop = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_HIDE_DIFFERENT_DESKTOP),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_hide_diff_desktop)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_always_show_all_desktop_tasks = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_ALWAYS_SHOW_ALL_DESKTOP_TASKS),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_always_show_all_desktop_tasks)) ? 1 : 0);
     fprintf(fp,
-            "taskbar_name_padding = %d %d\n",
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(TASKBAR_NAME_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(taskbar_name_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(taskbar_name_padding_y)));
     fprintf(fp,
-            "taskbar_name_background_id = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_NAME_BACKGROUND_ID),
             gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_name_inactive_background)));
     fprintf(fp,
-            "taskbar_name_active_background_id = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_NAME_ACTIVE_BACKGROUND_ID),
             gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_name_active_background)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_name_font_set)))
-        fprintf(fp, "taskbar_name_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(taskbar_name_font)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(TASKBAR_NAME_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(taskbar_name_font)));
 
     GdkColor color;
     gtk_color_button_get_color(GTK_COLOR_BUTTON(taskbar_name_inactive_color), &color);
     config_write_color(fp,
-                       "taskbar_name_font_color",
+                       CONFIG_KEY_NAME(TASKBAR_NAME_FONT_COLOR),
                        color,
                        gtk_color_button_get_alpha(GTK_COLOR_BUTTON(taskbar_name_inactive_color)) * 100 / 0xffff);
 
     gtk_color_button_get_color(GTK_COLOR_BUTTON(taskbar_name_active_color), &color);
     config_write_color(fp,
-                       "taskbar_name_active_font_color",
+                       CONFIG_KEY_NAME(TASKBAR_NAME_ACTIVE_FONT_COLOR),
                        color,
                        gtk_color_button_get_alpha(GTK_COLOR_BUTTON(taskbar_name_active_color)) * 100 / 0xffff);
 
     fprintf(fp,
-            "taskbar_distribute_size = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASKBAR_DISTRIBUTE_SIZE),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(taskbar_distribute_size)) ? 1 : 0);
 
-    fprintf(fp, "taskbar_sort_order = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(TASKBAR_SORT_ORDER));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_sort_order)) <= 0) {
         fprintf(fp, "none");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_sort_order)) == 1) {
@@ -476,7 +550,7 @@ void config_write_taskbar(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "task_align = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(TASK_ALIGN));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_alignment)) <= 0) {
         fprintf(fp, "left");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_alignment)) == 1) {
@@ -489,36 +563,33 @@ void config_write_taskbar(FILE *fp)
     fprintf(fp, "\n");
 }
 
-void config_write_task_font_color(FILE *fp, char *name, GtkWidget *task_color)
+void config_write_task_font_color(FILE *fp, ConfigKeyId key_id, GtkWidget *task_color)
 {
     GdkColor color;
     gtk_color_button_get_color(GTK_COLOR_BUTTON(task_color), &color);
-    char full_name[128];
-    snprintf(full_name, sizeof(full_name), "task%s_font_color", name);
-    config_write_color(fp, full_name, color, gtk_color_button_get_alpha(GTK_COLOR_BUTTON(task_color)) * 100 / 0xffff);
+    config_write_color(fp,
+                       config_keys[key_id].name,
+                       color,
+                       gtk_color_button_get_alpha(GTK_COLOR_BUTTON(task_color)) * 100 / 0xffff);
 }
 
 void config_write_task_icon_osb(FILE *fp,
-                                char *name,
+                                ConfigKeyId key_id,
                                 GtkWidget *widget_opacity,
                                 GtkWidget *widget_saturation,
                                 GtkWidget *widget_brightness)
 {
-    char full_name[128];
-    snprintf(full_name, sizeof(full_name), "task%s_icon_asb", name);
     fprintf(fp,
             "%s = %d %d %d\n",
-            full_name,
+            config_keys[key_id].name,
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(widget_opacity)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(widget_saturation)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(widget_brightness)));
 }
 
-void config_write_task_background(FILE *fp, char *name, GtkWidget *task_background)
+void config_write_task_background(FILE *fp, ConfigKeyId key_id, GtkWidget *task_background)
 {
-    char full_name[128];
-    snprintf(full_name, sizeof(full_name), "task%s_background_id", name);
-    fprintf(fp, "%s = %d\n", full_name, gtk_combo_box_get_active(GTK_COMBO_BOX(task_background)));
+    fprintf(fp, "%s = %d\n", config_keys[key_id].name, gtk_combo_box_get_active(GTK_COMBO_BOX(task_background)));
 }
 
 void config_write_task(FILE *fp)
@@ -526,77 +597,102 @@ void config_write_task(FILE *fp)
     fprintf(fp, "#-------------------------------------\n");
     fprintf(fp, "# Task\n");
 
-    fprintf(fp, "task_text = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_show_text)) ? 1 : 0);
-    fprintf(fp, "task_icon = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_show_icon)) ? 1 : 0);
-    fprintf(fp, "task_centered = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_align_center)) ? 1 : 0);
-    fprintf(fp, "urgent_nb_of_blink = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_urgent_blinks)));
     fprintf(fp,
-            "task_maximum_size = %d %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_TEXT),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_show_text)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_ICON),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_show_icon)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_CENTERED),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_align_center)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(URGENT_NB_OF_BLINK),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_urgent_blinks)));
+    fprintf(fp,
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(TASK_MAXIMUM_SIZE),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_maximum_width)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_maximum_height)));
     fprintf(fp,
-            "task_padding = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(TASK_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_padding_y)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(task_spacing)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_font_set)))
-        fprintf(fp, "task_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(task_font)));
-    fprintf(fp, "task_tooltip = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(tooltip_task_show)) ? 1 : 0);
-    fprintf(fp, "task_thumbnail = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(tooltip_task_thumbnail)) ? 1 : 0);
+        fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(TASK_FONT), gtk_font_button_get_font_name(GTK_FONT_BUTTON(task_font)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_TOOLTIP),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(tooltip_task_show)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_THUMBNAIL),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(tooltip_task_thumbnail)) ? 1 : 0);
     fprintf(fp,
-            "task_thumbnail_size = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_THUMBNAIL_SIZE),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_task_thumbnail_size)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TASK_THUMBNAIL_CACHE_SIZE),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_task_thumbnail_cache_size)));
 
 
     // same for: "" _normal _active _urgent _iconified
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_default_color_set))) {
-        config_write_task_font_color(fp, "", task_default_color);
+        config_write_task_font_color(fp, CONFIG_KEY_TASK_FONT_COLOR, task_default_color);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_normal_color_set))) {
-        config_write_task_font_color(fp, "_normal", task_normal_color);
+        config_write_task_font_color(fp, CONFIG_KEY_TASK_NORMAL_FONT_COLOR, task_normal_color);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_active_color_set))) {
-        config_write_task_font_color(fp, "_active", task_active_color);
+        config_write_task_font_color(fp, CONFIG_KEY_TASK_ACTIVE_FONT_COLOR, task_active_color);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_urgent_color_set))) {
-        config_write_task_font_color(fp, "_urgent", task_urgent_color);
+        config_write_task_font_color(fp, CONFIG_KEY_TASK_URGENT_FONT_COLOR, task_urgent_color);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_iconified_color_set))) {
-        config_write_task_font_color(fp, "_iconified", task_iconified_color);
+        config_write_task_font_color(fp, CONFIG_KEY_TASK_ICONIFIED_FONT_COLOR, task_iconified_color);
     }
 
     // same for: "" _normal _active _urgent _iconified
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_default_icon_osb_set))) {
         config_write_task_icon_osb(fp,
-                                   "",
+                                   CONFIG_KEY_TASK_ICON_ASB,
                                    task_default_icon_opacity,
                                    task_default_icon_saturation,
                                    task_default_icon_brightness);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_normal_icon_osb_set))) {
         config_write_task_icon_osb(fp,
-                                   "_normal",
+                                   CONFIG_KEY_TASK_NORMAL_ICON_ASB,
                                    task_normal_icon_opacity,
                                    task_normal_icon_saturation,
                                    task_normal_icon_brightness);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_active_icon_osb_set))) {
         config_write_task_icon_osb(fp,
-                                   "_active",
+                                   CONFIG_KEY_TASK_ACTIVE_ICON_ASB,
                                    task_active_icon_opacity,
                                    task_active_icon_saturation,
                                    task_active_icon_brightness);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_urgent_icon_osb_set))) {
         config_write_task_icon_osb(fp,
-                                   "_urgent",
+                                   CONFIG_KEY_TASK_URGENT_ICON_ASB,
                                    task_urgent_icon_opacity,
                                    task_urgent_icon_saturation,
                                    task_urgent_icon_brightness);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_iconified_icon_osb_set))) {
         config_write_task_icon_osb(fp,
-                                   "_iconified",
+                                   CONFIG_KEY_TASK_ICONIFIED_ICON_ASB,
                                    task_iconified_icon_opacity,
                                    task_iconified_icon_saturation,
                                    task_iconified_icon_brightness);
@@ -604,26 +700,26 @@ void config_write_task(FILE *fp)
 
     // same for: "" _normal _active _urgent _iconified
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_default_background_set))) {
-        config_write_task_background(fp, "", task_default_background);
+        config_write_task_background(fp, CONFIG_KEY_TASK_BACKGROUND_ID, task_default_background);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_normal_background_set))) {
-        config_write_task_background(fp, "_normal", task_normal_background);
+        config_write_task_background(fp, CONFIG_KEY_TASK_NORMAL_BACKGROUND_ID, task_normal_background);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_active_background_set))) {
-        config_write_task_background(fp, "_active", task_active_background);
+        config_write_task_background(fp, CONFIG_KEY_TASK_ACTIVE_BACKGROUND_ID, task_active_background);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_urgent_background_set))) {
-        config_write_task_background(fp, "_urgent", task_urgent_background);
+        config_write_task_background(fp, CONFIG_KEY_TASK_URGENT_BACKGROUND_ID, task_urgent_background);
     }
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(task_iconified_background_set))) {
-        config_write_task_background(fp, "_iconified", task_iconified_background);
+        config_write_task_background(fp, CONFIG_KEY_TASK_ICONIFIED_BACKGROUND_ID, task_iconified_background);
     }
 
-    fprintf(fp, "mouse_left = %s\n", get_action(task_mouse_left));
-    fprintf(fp, "mouse_middle = %s\n", get_action(task_mouse_middle));
-    fprintf(fp, "mouse_right = %s\n", get_action(task_mouse_right));
-    fprintf(fp, "mouse_scroll_up = %s\n", get_action(task_mouse_scroll_up));
-    fprintf(fp, "mouse_scroll_down = %s\n", get_action(task_mouse_scroll_down));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(MOUSE_LEFT), get_action(task_mouse_left));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(MOUSE_MIDDLE), get_action(task_mouse_middle));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(MOUSE_RIGHT), get_action(task_mouse_right));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(MOUSE_SCROLL_UP), get_action(task_mouse_scroll_up));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(MOUSE_SCROLL_DOWN), get_action(task_mouse_scroll_down));
 
     fprintf(fp, "\n");
 }
@@ -634,13 +730,17 @@ void config_write_systray(FILE *fp)
     fprintf(fp, "# System tray (notification area)\n");
 
     fprintf(fp,
-            "systray_padding = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(SYSTRAY_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_padding_y)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_spacing)));
-    fprintf(fp, "systray_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(systray_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(SYSTRAY_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(systray_background)));
 
-    fprintf(fp, "systray_sort = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(SYSTRAY_SORT));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(systray_icon_order)) == 0) {
         fprintf(fp, "ascending");
     } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(systray_icon_order)) == 1) {
@@ -652,14 +752,18 @@ void config_write_systray(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "systray_icon_size = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_icon_size)));
     fprintf(fp,
-            "systray_icon_asb = %d %d %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(SYSTRAY_ICON_SIZE),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_icon_size)));
+    fprintf(fp,
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(SYSTRAY_ICON_ASB),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_icon_opacity)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_icon_saturation)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(systray_icon_brightness)));
 
-    fprintf(fp, "systray_monitor = ");
+    fprintf(fp, "%s = ", CONFIG_KEY_NAME(SYSTRAY_MONITOR));
     if (gtk_combo_box_get_active(GTK_COMBO_BOX(systray_monitor)) <= 0) {
         fprintf(fp, "primary");
     } else {
@@ -667,7 +771,7 @@ void config_write_systray(FILE *fp)
     }
     fprintf(fp, "\n");
 
-    fprintf(fp, "systray_name_filter = %s\n", gtk_entry_get_text(GTK_ENTRY(systray_name_filter)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(SYSTRAY_NAME_FILTER), gtk_entry_get_text(GTK_ENTRY(systray_name_filter)));
 
     fprintf(fp, "\n");
 }
@@ -678,33 +782,47 @@ void config_write_launcher(FILE *fp)
     fprintf(fp, "# Launcher\n");
 
     fprintf(fp,
-            "launcher_padding = %d %d %d\n",
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_padding_y)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_spacing)));
-    fprintf(fp, "launcher_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(launcher_background)));
     fprintf(fp,
-            "launcher_icon_background_id = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(launcher_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_ICON_BACKGROUND_ID),
             gtk_combo_box_get_active(GTK_COMBO_BOX(launcher_icon_background)));
-    fprintf(fp, "launcher_icon_size = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_icon_size)));
     fprintf(fp,
-            "launcher_icon_asb = %d %d %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_ICON_SIZE),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_icon_size)));
+    fprintf(fp,
+            "%s = %d %d %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_ICON_ASB),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_icon_opacity)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_icon_saturation)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(launcher_icon_brightness)));
     gchar *icon_theme = get_current_icon_theme();
     if (icon_theme && !g_str_equal(icon_theme, "")) {
-        fprintf(fp, "launcher_icon_theme = %s\n", icon_theme);
+        fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(LAUNCHER_ICON_THEME), icon_theme);
         g_free(icon_theme);
         icon_theme = NULL;
     }
     fprintf(fp,
-            "launcher_icon_theme_override = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_ICON_THEME_OVERRIDE),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(launcher_icon_theme_override)) ? 1 : 0);
     fprintf(fp,
-            "startup_notifications = %d\n",
+            "%s = %d\n",
+            CONFIG_KEY_NAME(STARTUP_NOTIFICATIONS),
             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(startup_notifications)) ? 1 : 0);
-    fprintf(fp, "launcher_tooltip = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(launcher_tooltip)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(LAUNCHER_TOOLTIP),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(launcher_tooltip)) ? 1 : 0);
 
     int index;
     for (index = 0;; index++) {
@@ -722,7 +840,7 @@ void config_write_launcher(FILE *fp)
         gchar *app_path;
         gtk_tree_model_get(GTK_TREE_MODEL(launcher_apps), &iter, appsColPath, &app_path, -1);
         char *contracted = contract_tilde(app_path);
-        fprintf(fp, "launcher_item_app = %s\n", contracted);
+        fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(LAUNCHER_ITEM_APP), contracted);
         free(contracted);
         g_free(app_path);
     }
@@ -733,7 +851,7 @@ void config_write_launcher(FILE *fp)
         g_strstrip(dir);
         if (strlen(dir) > 0) {
             char *contracted = contract_tilde(dir);
-            fprintf(fp, "launcher_apps_dir = %s\n", contracted);
+            fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(LAUNCHER_APPS_DIR), contracted);
             free(contracted);
         }
     }
@@ -747,34 +865,53 @@ void config_write_clock(FILE *fp)
     fprintf(fp, "#-------------------------------------\n");
     fprintf(fp, "# Clock\n");
 
-    fprintf(fp, "time1_format = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_format_line1)));
-    fprintf(fp, "time2_format = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_format_line2)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(TIME1_FORMAT), gtk_entry_get_text(GTK_ENTRY(clock_format_line1)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(TIME2_FORMAT), gtk_entry_get_text(GTK_ENTRY(clock_format_line2)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(clock_font_line1_set)))
-        fprintf(fp, "time1_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(clock_font_line1)));
-    fprintf(fp, "time1_timezone = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_tmz_line1)));
-    fprintf(fp, "time2_timezone = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_tmz_line2)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(TIME1_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(clock_font_line1)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(TIME1_TIMEZONE), gtk_entry_get_text(GTK_ENTRY(clock_tmz_line1)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(TIME2_TIMEZONE), gtk_entry_get_text(GTK_ENTRY(clock_tmz_line2)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(clock_font_line2_set)))
-        fprintf(fp, "time2_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(clock_font_line2)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(TIME2_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(clock_font_line2)));
 
     GdkColor color;
     gtk_color_button_get_color(GTK_COLOR_BUTTON(clock_font_color), &color);
     config_write_color(fp,
-                       "clock_font_color",
+                       CONFIG_KEY_NAME(CLOCK_FONT_COLOR),
                        color,
                        gtk_color_button_get_alpha(GTK_COLOR_BUTTON(clock_font_color)) * 100 / 0xffff);
 
     fprintf(fp,
-            "clock_padding = %d %d\n",
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(CLOCK_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(clock_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(clock_padding_y)));
-    fprintf(fp, "clock_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(clock_background)));
-    fprintf(fp, "clock_tooltip = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_format_tooltip)));
-    fprintf(fp, "clock_tooltip_timezone = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_tmz_tooltip)));
-    fprintf(fp, "clock_lclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_left_command)));
-    fprintf(fp, "clock_rclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_right_command)));
-    fprintf(fp, "clock_mclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_mclick_command)));
-    fprintf(fp, "clock_uwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_uwheel_command)));
-    fprintf(fp, "clock_dwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(clock_dwheel_command)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(CLOCK_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(clock_background)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(CLOCK_TOOLTIP), gtk_entry_get_text(GTK_ENTRY(clock_format_tooltip)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(CLOCK_TOOLTIP_TIMEZONE), gtk_entry_get_text(GTK_ENTRY(clock_tmz_tooltip)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(CLOCK_LCLICK_COMMAND), gtk_entry_get_text(GTK_ENTRY(clock_left_command)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(CLOCK_RCLICK_COMMAND), gtk_entry_get_text(GTK_ENTRY(clock_right_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(CLOCK_MCLICK_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(clock_mclick_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(CLOCK_UWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(clock_uwheel_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(CLOCK_DWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(clock_dwheel_command)));
 
     fprintf(fp, "\n");
 }
@@ -784,36 +921,70 @@ void config_write_battery(FILE *fp)
     fprintf(fp, "#-------------------------------------\n");
     fprintf(fp, "# Battery\n");
 
-    fprintf(fp, "battery_tooltip = %d\n", gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(battery_tooltip)) ? 1 : 0);
-    fprintf(fp, "battery_low_status = %g\n", gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_alert_if_lower)));
-    fprintf(fp, "battery_low_cmd = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_alert_cmd)));
-    fprintf(fp, "battery_full_cmd = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_alert_full_cmd)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(BATTERY_TOOLTIP),
+            gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(battery_tooltip)) ? 1 : 0);
+    fprintf(fp,
+            "%s = %g\n",
+            CONFIG_KEY_NAME(BATTERY_LOW_STATUS),
+            gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_alert_if_lower)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BATTERY_LOW_CMD), gtk_entry_get_text(GTK_ENTRY(battery_alert_cmd)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BATTERY_FULL_CMD), gtk_entry_get_text(GTK_ENTRY(battery_alert_full_cmd)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(battery_font_line1_set)))
-        fprintf(fp, "bat1_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(battery_font_line1)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BAT1_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(battery_font_line1)));
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(battery_font_line2_set)))
-        fprintf(fp, "bat2_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(battery_font_line2)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BAT2_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(battery_font_line2)));
     GdkColor color;
     gtk_color_button_get_color(GTK_COLOR_BUTTON(battery_font_color), &color);
     config_write_color(fp,
-                       "battery_font_color",
+                       CONFIG_KEY_NAME(BATTERY_FONT_COLOR),
                        color,
                        gtk_color_button_get_alpha(GTK_COLOR_BUTTON(battery_font_color)) * 100 / 0xffff);
-    fprintf(fp, "bat1_format = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_format1)));
-    fprintf(fp, "bat2_format = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_format2)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BAT1_FORMAT), gtk_entry_get_text(GTK_ENTRY(battery_format1)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BAT2_FORMAT), gtk_entry_get_text(GTK_ENTRY(battery_format2)));
     fprintf(fp,
-            "battery_padding = %d %d\n",
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(BATTERY_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_padding_y)));
-    fprintf(fp, "battery_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(battery_background)));
-    fprintf(fp, "battery_hide = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_hide_if_higher)));
-    fprintf(fp, "battery_lclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_left_command)));
-    fprintf(fp, "battery_rclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_right_command)));
-    fprintf(fp, "battery_mclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_mclick_command)));
-    fprintf(fp, "battery_uwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_uwheel_command)));
-    fprintf(fp, "battery_dwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(battery_dwheel_command)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(BATTERY_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(battery_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(BATTERY_HIDE),
+            (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(battery_hide_if_higher)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(BATTERY_LCLICK_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(battery_left_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(BATTERY_RCLICK_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(battery_right_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(BATTERY_MCLICK_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(battery_mclick_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(BATTERY_UWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(battery_uwheel_command)));
+    fprintf(fp,
+            "%s = %s\n",
+            CONFIG_KEY_NAME(BATTERY_DWHEEL_COMMAND),
+            gtk_entry_get_text(GTK_ENTRY(battery_dwheel_command)));
 
-    fprintf(fp, "ac_connected_cmd = %s\n", gtk_entry_get_text(GTK_ENTRY(ac_connected_cmd)));
-    fprintf(fp, "ac_disconnected_cmd = %s\n", gtk_entry_get_text(GTK_ENTRY(ac_disconnected_cmd)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(AC_CONNECTED_CMD), gtk_entry_get_text(GTK_ENTRY(ac_connected_cmd)));
+    fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(AC_DISCONNECTED_CMD), gtk_entry_get_text(GTK_ENTRY(ac_disconnected_cmd)));
 
     fprintf(fp, "\n");
 }
@@ -826,28 +997,32 @@ void config_write_separator(FILE *fp)
 
         Separator *separator = &g_array_index(separators, Separator, i);
 
-        fprintf(fp, "separator = new\n");
+        fprintf(fp, "%s = new\n", CONFIG_KEY_NAME(SEPARATOR));
         fprintf(fp,
-                "separator_background_id = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(SEPARATOR_BACKGROUND_ID),
                 gtk_combo_box_get_active(GTK_COMBO_BOX(separator->separator_background)));
         GdkColor color;
         gtk_color_button_get_color(GTK_COLOR_BUTTON(separator->separator_color), &color);
         config_write_color(fp,
-                           "separator_color",
+                           CONFIG_KEY_NAME(SEPARATOR_COLOR),
                            color,
                            gtk_color_button_get_alpha(GTK_COLOR_BUTTON(separator->separator_color)) * 100 / 0xffff);
-        // fprintf(fp, "separator_style = %d\n",
+        // fprintf(fp, "%s = %d\n", CONFIG_KEY_NAME(SEPARATOR_STYLE),
         // (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(separator->separator_style)));
         fprintf(fp,
-                "separator_style = %s\n",
+                "%s = %s\n",
+                CONFIG_KEY_NAME(SEPARATOR_STYLE),
                 gtk_combo_box_get_active(GTK_COMBO_BOX(separator->separator_style)) == 0
                     ? "empty"
                     : gtk_combo_box_get_active(GTK_COMBO_BOX(separator->separator_style)) == 1 ? "line" : "dots");
         fprintf(fp,
-                "separator_size = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(SEPARATOR_SIZE),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(separator->separator_size)));
         fprintf(fp,
-                "separator_padding = %d %d\n",
+                "%s = %d %d\n",
+                CONFIG_KEY_NAME(SEPARATOR_PADDING),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(separator->separator_padding_x)),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(separator->separator_padding_y)));
         fprintf(fp, "\n");
@@ -862,26 +1037,41 @@ void config_write_execp(FILE *fp)
 
         Executor *executor = &g_array_index(executors, Executor, i);
 
-        fprintf(fp, "execp = new\n");
-        fprintf(fp, "execp_name = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_name)));
-        fprintf(fp, "execp_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_command)));
-        fprintf(fp, "execp_interval = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_interval)));
+        fprintf(fp, "%s = new\n", CONFIG_KEY_NAME(EXECP));
+        fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(EXECP_NAME), gtk_entry_get_text(GTK_ENTRY(executor->execp_name)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_command)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_INTERVAL),
+                (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_interval)));
         fprintf(fp,
-                "execp_isolate = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_ISOLATE),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_isolate)) ? 1 : 0);
         fprintf(fp,
-                "execp_has_icon = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_HAS_ICON),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_has_icon)) ? 1 : 0);
         fprintf(fp,
-                "execp_cache_icon = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_CACHE_ICON),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_cache_icon)) ? 1 : 0);
         fprintf(fp,
-                "execp_continuous = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_CONTINUOUS),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_continuous)));
         fprintf(fp,
-                "execp_markup = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_MAX_BUFFER_SIZE),
+                (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_max_buffer_size)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_MARKUP),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_markup)) ? 1 : 0);
-        fprintf(fp, "execp_monitor = ");
+        fprintf(fp, "%s = ", CONFIG_KEY_NAME(EXECP_MONITOR));
         if (gtk_combo_box_get_active(GTK_COMBO_BOX(executor->execp_monitor)) <= 0) {
             fprintf(fp, "all");
         } else if (gtk_combo_box_get_active(GTK_COMBO_BOX(executor->execp_monitor)) == 1) {
@@ -892,37 +1082,66 @@ void config_write_execp(FILE *fp)
         fprintf(fp, "\n");
 
         if (!gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_show_tooltip))) {
-            fprintf(fp, "execp_tooltip = \n");
+            fprintf(fp, "%s = \n", CONFIG_KEY_NAME(EXECP_TOOLTIP));
         } else {
             const gchar *text = gtk_entry_get_text(GTK_ENTRY(executor->execp_tooltip));
             if (strlen(text) > 0)
-                fprintf(fp, "execp_tooltip = %s\n", text);
+                fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(EXECP_TOOLTIP), text);
         }
 
-        fprintf(fp, "execp_lclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_left_command)));
-        fprintf(fp, "execp_rclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_right_command)));
-        fprintf(fp, "execp_mclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_mclick_command)));
-        fprintf(fp, "execp_uwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_uwheel_command)));
-        fprintf(fp, "execp_dwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(executor->execp_dwheel_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_LCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_left_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_RCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_right_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_MCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_mclick_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_UWHEEL_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_uwheel_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(EXECP_DWHEEL_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(executor->execp_dwheel_command)));
 
         if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_font_set)))
-            fprintf(fp, "execp_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(executor->execp_font)));
+            fprintf(fp,
+                    "%s = %s\n",
+                    CONFIG_KEY_NAME(EXECP_FONT),
+                    gtk_font_button_get_font_name(GTK_FONT_BUTTON(executor->execp_font)));
         GdkColor color;
         gtk_color_button_get_color(GTK_COLOR_BUTTON(executor->execp_font_color), &color);
         config_write_color(fp,
-                           "execp_font_color",
+                           CONFIG_KEY_NAME(EXECP_FONT_COLOR),
                            color,
                            gtk_color_button_get_alpha(GTK_COLOR_BUTTON(executor->execp_font_color)) * 100 / 0xffff);
         fprintf(fp,
-                "execp_padding = %d %d\n",
+                "%s = %d %d\n",
+                CONFIG_KEY_NAME(EXECP_PADDING),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_padding_x)),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_padding_y)));
-        fprintf(fp, "execp_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(executor->execp_background)));
         fprintf(fp,
-                "execp_centered = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_BACKGROUND_ID),
+                gtk_combo_box_get_active(GTK_COMBO_BOX(executor->execp_background)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_CENTERED),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(executor->execp_centered)) ? 1 : 0);
-        fprintf(fp, "execp_icon_w = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_icon_w)));
-        fprintf(fp, "execp_icon_h = %d\n", (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_icon_h)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_ICON_W),
+                (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_icon_w)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(EXECP_ICON_H),
+                (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(executor->execp_icon_h)));
 
         fprintf(fp, "\n");
     }
@@ -936,38 +1155,65 @@ void config_write_button(FILE *fp)
 
         Button *button = &g_array_index(buttons, Button, i);
 
-        fprintf(fp, "button = new\n");
+        fprintf(fp, "%s = new\n", CONFIG_KEY_NAME(BUTTON));
         if (strlen(gtk_entry_get_text(GTK_ENTRY(button->button_icon))))
-            fprintf(fp, "button_icon = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_icon)));
+            fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BUTTON_ICON), gtk_entry_get_text(GTK_ENTRY(button->button_icon)));
         if (gtk_entry_get_text(GTK_ENTRY(button->button_text)))
-            fprintf(fp, "button_text = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_text)));
+            fprintf(fp, "%s = %s\n", CONFIG_KEY_NAME(BUTTON_TEXT), gtk_entry_get_text(GTK_ENTRY(button->button_text)));
         if (strlen(gtk_entry_get_text(GTK_ENTRY(button->button_tooltip))))
-            fprintf(fp, "button_tooltip = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_tooltip)));
+            fprintf(fp,
+                    "%s = %s\n",
+                    CONFIG_KEY_NAME(BUTTON_TOOLTIP),
+                    gtk_entry_get_text(GTK_ENTRY(button->button_tooltip)));
 
-        fprintf(fp, "button_lclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_left_command)));
-        fprintf(fp, "button_rclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_right_command)));
-        fprintf(fp, "button_mclick_command = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_mclick_command)));
-        fprintf(fp, "button_uwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_uwheel_command)));
-        fprintf(fp, "button_dwheel_command = %s\n", gtk_entry_get_text(GTK_ENTRY(button->button_dwheel_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BUTTON_LCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(button->button_left_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BUTTON_RCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(button->button_right_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BUTTON_MCLICK_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(button->button_mclick_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BUTTON_UWHEEL_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(button->button_uwheel_command)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(BUTTON_DWHEEL_COMMAND),
+                gtk_entry_get_text(GTK_ENTRY(button->button_dwheel_command)));
 
         if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(button->button_font_set)))
-            fprintf(fp, "button_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(button->button_font)));
+            fprintf(fp,
+                    "%s = %s\n",
+                    CONFIG_KEY_NAME(BUTTON_FONT),
+                    gtk_font_button_get_font_name(GTK_FONT_BUTTON(button->button_font)));
         GdkColor color;
         gtk_color_button_get_color(GTK_COLOR_BUTTON(button->button_font_color), &color);
         config_write_color(fp,
-                           "button_font_color",
+                           CONFIG_KEY_NAME(BUTTON_FONT_COLOR),
                            color,
                            gtk_color_button_get_alpha(GTK_COLOR_BUTTON(button->button_font_color)) * 100 / 0xffff);
         fprintf(fp,
-                "button_padding = %d %d\n",
+                "%s = %d %d\n",
+                CONFIG_KEY_NAME(BUTTON_PADDING),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(button->button_padding_x)),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(button->button_padding_y)));
-        fprintf(fp, "button_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(button->button_background)));
         fprintf(fp,
-                "button_centered = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(BUTTON_BACKGROUND_ID),
+                gtk_combo_box_get_active(GTK_COMBO_BOX(button->button_background)));
+        fprintf(fp,
+                "%s = %d\n",
+                CONFIG_KEY_NAME(BUTTON_CENTERED),
                 gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(button->button_centered)) ? 1 : 0);
         fprintf(fp,
-                "button_max_icon_size = %d\n",
+                "%s = %d\n",
+                CONFIG_KEY_NAME(BUTTON_MAX_ICON_SIZE),
                 (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(button->button_max_icon_size)));
 
         fprintf(fp, "\n");
@@ -979,23 +1225,36 @@ void config_write_tooltip(FILE *fp)
     fprintf(fp, "#-------------------------------------\n");
     fprintf(fp, "# Tooltip\n");
 
-    fprintf(fp, "tooltip_show_timeout = %g\n", gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_show_after)));
-    fprintf(fp, "tooltip_hide_timeout = %g\n", gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_hide_after)));
     fprintf(fp,
-            "tooltip_padding = %d %d\n",
+            "%s = %g\n",
+            CONFIG_KEY_NAME(TOOLTIP_SHOW_TIMEOUT),
+            gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_show_after)));
+    fprintf(fp,
+            "%s = %g\n",
+            CONFIG_KEY_NAME(TOOLTIP_HIDE_TIMEOUT),
+            gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_hide_after)));
+    fprintf(fp,
+            "%s = %d %d\n",
+            CONFIG_KEY_NAME(TOOLTIP_PADDING),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_padding_x)),
             (int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(tooltip_padding_y)));
-    fprintf(fp, "tooltip_background_id = %d\n", gtk_combo_box_get_active(GTK_COMBO_BOX(tooltip_background)));
+    fprintf(fp,
+            "%s = %d\n",
+            CONFIG_KEY_NAME(TOOLTIP_BACKGROUND_ID),
+            gtk_combo_box_get_active(GTK_COMBO_BOX(tooltip_background)));
 
     GdkColor color;
     gtk_color_button_get_color(GTK_COLOR_BUTTON(tooltip_font_color), &color);
     config_write_color(fp,
-                       "tooltip_font_color",
+                       CONFIG_KEY_NAME(TOOLTIP_FONT_COLOR),
                        color,
                        gtk_color_button_get_alpha(GTK_COLOR_BUTTON(tooltip_font_color)) * 100 / 0xffff);
 
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(tooltip_font_set)))
-        fprintf(fp, "tooltip_font = %s\n", gtk_font_button_get_font_name(GTK_FONT_BUTTON(tooltip_font)));
+        fprintf(fp,
+                "%s = %s\n",
+                CONFIG_KEY_NAME(TOOLTIP_FONT),
+                gtk_font_button_get_font_name(GTK_FONT_BUTTON(tooltip_font)));
 
     fprintf(fp, "\n");
 }
@@ -1137,14 +1396,19 @@ void add_entry(char *key, char *value)
 {
     char *value1 = 0, *value2 = 0, *value3 = 0;
 
-    /* Gradients */
-    if (strcmp(key, "scale_relative_to_dpi") == 0) {
+    ConfigKeyId key_id = config_key_lookup(key);
+    switch (key_id) {
+    case CONFIG_KEY_SCALE_RELATIVE_TO_DPI:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(scale_relative_to_dpi), atoi(value1));
-    } else if (strcmp(key, "scale_relative_to_screen_height") == 0) {
+        break;
+    case CONFIG_KEY_SCALE_RELATIVE_TO_SCREEN_HEIGHT:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(scale_relative_to_screen_height), atoi(value1));
-    } else if (strcmp(key, "gradient") == 0) {
+        break;
+
+    /* Gradients */
+    case CONFIG_KEY_GRADIENT: {
         finalize_gradient();
         GradientConfigType t;
         if (g_str_equal(value, "horizontal"))
@@ -1156,7 +1420,9 @@ void add_entry(char *key, char *value)
         gradient_create_new(t);
         num_gr++;
         gradient_force_update();
-    } else if (strcmp(key, "start_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_START_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1164,7 +1430,9 @@ void add_entry(char *key, char *value)
         int alpha = value2 ? atoi(value2) : 50;
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(gradient_start_color), (alpha * 65535) / 100);
         gradient_force_update();
-    } else if (strcmp(key, "end_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_END_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1172,7 +1440,9 @@ void add_entry(char *key, char *value)
         int alpha = value2 ? atoi(value2) : 50;
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(gradient_end_color), (alpha * 65535) / 100);
         gradient_force_update();
-    } else if (strcmp(key, "color_stop") == 0) {
+        break;
+    }
+    case CONFIG_KEY_COLOR_STOP: {
         GradientConfig *g = (GradientConfig *)g_list_last(gradients)->data;
         extract_values(value, &value1, &value2, &value3);
         GradientConfigColorStop *color_stop = (GradientConfigColorStop *)calloc(1, sizeof(GradientConfigColorStop));
@@ -1184,10 +1454,11 @@ void add_entry(char *key, char *value)
             color_stop->color.alpha = 0.5;
         g->extra_color_stops = g_list_append(g->extra_color_stops, color_stop);
         current_gradient_changed(NULL, NULL);
-    } else
+        break;
+    }
 
-        /* Background and border */
-        if (strcmp(key, "rounded") == 0) {
+    /* Background and border */
+    case CONFIG_KEY_ROUNDED:
         // 'rounded' is the first parameter => alloc a new background
         finalize_bg();
         background_create_new();
@@ -1198,10 +1469,12 @@ void add_entry(char *key, char *value)
         read_border_color_press = 0;
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(background_corner_radius), atoi(value));
         background_force_update();
-    } else if (strcmp(key, "border_width") == 0) {
+        break;
+    case CONFIG_KEY_BORDER_WIDTH:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(background_border_width), atoi(value));
         background_force_update();
-    } else if (strcmp(key, "background_color") == 0) {
+        break;
+    case CONFIG_KEY_BACKGROUND_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1209,7 +1482,9 @@ void add_entry(char *key, char *value)
         int alpha = value2 ? atoi(value2) : 50;
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_fill_color), (alpha * 65535) / 100);
         background_force_update();
-    } else if (strcmp(key, "border_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1217,7 +1492,9 @@ void add_entry(char *key, char *value)
         int alpha = value2 ? atoi(value2) : 50;
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_border_color), (alpha * 65535) / 100);
         background_force_update();
-    } else if (strcmp(key, "background_color_hover") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_COLOR_HOVER: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1226,7 +1503,9 @@ void add_entry(char *key, char *value)
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_fill_color_over), (alpha * 65535) / 100);
         background_force_update();
         read_bg_color_hover = 1;
-    } else if (strcmp(key, "border_color_hover") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR_HOVER: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1235,7 +1514,9 @@ void add_entry(char *key, char *value)
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_border_color_over), (alpha * 65535) / 100);
         background_force_update();
         read_border_color_hover = 1;
-    } else if (strcmp(key, "background_color_pressed") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BACKGROUND_COLOR_PRESSED: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1244,7 +1525,9 @@ void add_entry(char *key, char *value)
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_fill_color_press), (alpha * 65535) / 100);
         background_force_update();
         read_bg_color_press = 1;
-    } else if (strcmp(key, "border_color_pressed") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_COLOR_PRESSED: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1253,7 +1536,9 @@ void add_entry(char *key, char *value)
         gtk_color_button_set_alpha(GTK_COLOR_BUTTON(background_border_color_press), (alpha * 65535) / 100);
         background_force_update();
         read_border_color_press = 1;
-    } else if (strcmp(key, "border_sides") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_SIDES:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(background_border_sides_top),
                                      strchr(value, 't') || strchr(value, 'T'));
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(background_border_sides_bottom),
@@ -1263,27 +1548,36 @@ void add_entry(char *key, char *value)
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(background_border_sides_right),
                                      strchr(value, 'r') || strchr(value, 'R'));
         background_force_update();
-    } else if (strcmp(key, "gradient_id") == 0) {
+        break;
+    case CONFIG_KEY_GRADIENT_ID: {
         int id = gradient_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(background_gradient), id);
         background_force_update();
-    } else if (strcmp(key, "gradient_id_hover") == 0 || strcmp(key, "hover_gradient_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_GRADIENT_ID_HOVER: {
         int id = gradient_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(background_gradient_over), id);
         background_force_update();
-    } else if (strcmp(key, "gradient_id_pressed") == 0 || strcmp(key, "pressed_gradient_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_GRADIENT_ID_PRESSED: {
         int id = gradient_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(background_gradient_press), id);
         background_force_update();
-    } else if (strcmp(key, "border_content_tint_weight") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BORDER_CONTENT_TINT_WEIGHT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(background_border_content_tint_weight), atoi(value));
         background_force_update();
-    } else if (strcmp(key, "background_content_tint_weight") == 0) {
+        break;
+    case CONFIG_KEY_BACKGROUND_CONTENT_TINT_WEIGHT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(background_fill_content_tint_weight), atoi(value));
         background_force_update();
+        break;
 
-    } else if (strcmp(key, "panel_size") == 0) {
     /* Panel */
+    case CONFIG_KEY_PANEL_SIZE: {
         extract_values(value, &value1, &value2, &value3);
         char *b;
         if ((b = strchr(value1, '%'))) {
@@ -1303,14 +1597,18 @@ void add_entry(char *key, char *value)
         } else
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_height_type), 1);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_height), atoi(value2));
-    } else if (strcmp(key, "panel_items") == 0) {
+        break;
+    }
+    case CONFIG_KEY_PANEL_ITEMS:
         config_has_panel_items = 1;
         set_panel_items(value);
-    } else if (strcmp(key, "panel_margin") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_MARGIN:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_margin_x), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_margin_y), atoi(value2));
-    } else if (strcmp(key, "panel_padding") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_padding_x), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_spacing), atoi(value1));
@@ -1318,7 +1616,8 @@ void add_entry(char *key, char *value)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_padding_y), atoi(value2));
         if (value3)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_spacing), atoi(value3));
-    } else if (strcmp(key, "panel_position") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_POSITION: {
         extract_values(value, &value1, &value2, &value3);
 
         char vpos, hpos, orientation;
@@ -1379,41 +1678,55 @@ void add_entry(char *key, char *value)
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(screen_position[POS_CRV]), 1);
         if (vpos == 'B' && hpos == 'R' && orientation == 'V')
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(screen_position[POS_BRV]), 1);
-    } else if (strcmp(key, "panel_background_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_PANEL_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(panel_background), id);
-    } else if (strcmp(key, "panel_window_name") == 0) {
+        break;
+    }
+    case CONFIG_KEY_PANEL_WINDOW_NAME:
         gtk_entry_set_text(GTK_ENTRY(panel_window_name), value);
-    } else if (strcmp(key, "disable_transparency") == 0) {
+        break;
+    case CONFIG_KEY_DISABLE_TRANSPARENCY:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(disable_transparency), atoi(value));
-    } else if (strcmp(key, "mouse_effects") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_EFFECTS:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_mouse_effects), atoi(value));
-    } else if (strcmp(key, "mouse_hover_icon_asb") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_HOVER_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_hover_icon_opacity), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_hover_icon_saturation), atoi(value2));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_hover_icon_brightness), atoi(value3));
-    } else if (strcmp(key, "mouse_pressed_icon_asb") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_PRESSED_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_pressed_icon_opacity), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_pressed_icon_saturation), atoi(value2));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(mouse_pressed_icon_brightness), atoi(value3));
-    } else if (strcmp(key, "font_shadow") == 0) {
+        break;
+    case CONFIG_KEY_FONT_SHADOW:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(font_shadow), atoi(value));
-    } else if (strcmp(key, "wm_menu") == 0) {
+        break;
+    case CONFIG_KEY_WM_MENU:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_wm_menu), atoi(value));
-    } else if (strcmp(key, "panel_dock") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_DOCK:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_dock), atoi(value));
-    } else if (strcmp(key, "panel_pivot_struts") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_PIVOT_STRUTS:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_pivot_struts), atoi(value));
-    } else if (strcmp(key, "panel_layer") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_LAYER:
         if (strcmp(value, "bottom") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_layer), 2);
         else if (strcmp(value, "top") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_layer), 0);
         else
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_layer), 1);
-    } else if (strcmp(key, "panel_monitor") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_MONITOR:
         if (strcmp(value, "all") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_monitor), 0);
         else if (strcmp(value, "primary") == 0)
@@ -1430,66 +1743,86 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_monitor), 6);
         else if (strcmp(value, "6") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_monitor), 7);
-    } else if (strcmp(key, "panel_shrink") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_SHRINK:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_shrink), atoi(value));
+        break;
 
-    } else if (strcmp(key, "autohide") == 0) {
-        /* autohide options */
+    /* autohide options */
+    case CONFIG_KEY_AUTOHIDE:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(panel_autohide), atoi(value));
-    } else if (strcmp(key, "autohide_show_timeout") == 0) {
+        break;
+    case CONFIG_KEY_AUTOHIDE_SHOW_TIMEOUT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_autohide_show_time), atof(value));
-    } else if (strcmp(key, "autohide_hide_timeout") == 0) {
+        break;
+    case CONFIG_KEY_AUTOHIDE_HIDE_TIMEOUT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_autohide_hide_time), atof(value));
-    } else if (strcmp(key, "strut_policy") == 0) {
+        break;
+    case CONFIG_KEY_STRUT_POLICY:
         if (strcmp(value, "follow_size") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_strut_policy), 0);
         else if (strcmp(value, "none") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_strut_policy), 2);
         else
             gtk_combo_box_set_active(GTK_COMBO_BOX(panel_combo_strut_policy), 1);
-    } else if (strcmp(key, "autohide_height") == 0) {
+        break;
+    case CONFIG_KEY_AUTOHIDE_HEIGHT:
         if (atoi(value) <= 0) {
             // autohide need height > 0
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_autohide_size), 1);
         } else {
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(panel_autohide_size), atoi(value));
         }
-    } else if (strcmp(key, "panel_lclick_command") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_LCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(panel_left_command), value);
-    } else if (strcmp(key, "panel_rclick_command") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_RCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(panel_right_command), value);
-    } else if (strcmp(key, "panel_mclick_command") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_MCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(panel_mclick_command), value);
-    } else if (strcmp(key, "panel_uwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_UWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(panel_uwheel_command), value);
-    } else if (strcmp(key, "panel_dwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_PANEL_DWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(panel_dwheel_command), value);
+        break;
 
-
-    } else if (strcmp(key, "battery") == 0) {
-        /* Battery */
+    /* Battery */
+    case CONFIG_KEY_BATTERY:
         // Obsolete option
         config_has_battery = 1;
         config_battery_enabled = atoi(value);
-    } else if (strcmp(key, "battery_tooltip") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_TOOLTIP:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(battery_tooltip), atoi(value));
-    } else if (strcmp(key, "battery_low_status") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_LOW_STATUS:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(battery_alert_if_lower), atof(value));
-    } else if (strcmp(key, "battery_low_cmd") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_LOW_CMD:
         gtk_entry_set_text(GTK_ENTRY(battery_alert_cmd), value);
-    } else if (strcmp(key, "battery_full_cmd") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_FULL_CMD:
         gtk_entry_set_text(GTK_ENTRY(battery_alert_full_cmd), value);
-    } else if (strcmp(key, "bat1_font") == 0) {
+        break;
+    case CONFIG_KEY_BAT1_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(battery_font_line1), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(battery_font_line1_set), TRUE);
-    } else if (strcmp(key, "bat2_font") == 0) {
+        break;
+    case CONFIG_KEY_BAT2_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(battery_font_line2), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(battery_font_line2_set), TRUE);
-    } else if (strcmp(key, "bat1_format") == 0) {
+        break;
+    case CONFIG_KEY_BAT1_FORMAT:
         gtk_entry_set_text(GTK_ENTRY(battery_format1), value);
-    } else if (strcmp(key, "bat2_format") == 0) {
+        break;
+    case CONFIG_KEY_BAT2_FORMAT:
         gtk_entry_set_text(GTK_ENTRY(battery_format2), value);
-    } else if (strcmp(key, "battery_font_color") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1498,52 +1831,72 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(battery_font_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "battery_padding") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BATTERY_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(battery_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(battery_padding_y), atoi(value2));
-    } else if (strcmp(key, "battery_background_id") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(battery_background), id);
-    } else if (strcmp(key, "battery_hide") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BATTERY_HIDE: {
         int percentage_hide = atoi(value);
         if (percentage_hide == 0)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(battery_hide_if_higher), 101.0);
         else
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(battery_hide_if_higher), atoi(value));
-    } else if (strcmp(key, "battery_lclick_command") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BATTERY_LCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(battery_left_command), value);
-    } else if (strcmp(key, "battery_rclick_command") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_RCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(battery_right_command), value);
-    } else if (strcmp(key, "battery_mclick_command") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_MCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(battery_mclick_command), value);
-    } else if (strcmp(key, "battery_uwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_UWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(battery_uwheel_command), value);
-    } else if (strcmp(key, "battery_dwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_BATTERY_DWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(battery_dwheel_command), value);
-    } else if (strcmp(key, "ac_connected_cmd") == 0) {
+        break;
+    case CONFIG_KEY_AC_CONNECTED_CMD:
         gtk_entry_set_text(GTK_ENTRY(ac_connected_cmd), value);
-    } else if (strcmp(key, "ac_disconnected_cmd") == 0) {
+        break;
+    case CONFIG_KEY_AC_DISCONNECTED_CMD:
         gtk_entry_set_text(GTK_ENTRY(ac_disconnected_cmd), value);
+        break;
 
-    } else if (strcmp(key, "time1_format") == 0) {
     /* Clock */
+    case CONFIG_KEY_TIME1_FORMAT:
         gtk_entry_set_text(GTK_ENTRY(clock_format_line1), value);
         no_items_clock_enabled = strlen(value) > 0;
-    } else if (strcmp(key, "time2_format") == 0) {
+        break;
+    case CONFIG_KEY_TIME2_FORMAT:
         gtk_entry_set_text(GTK_ENTRY(clock_format_line2), value);
-    } else if (strcmp(key, "time1_font") == 0) {
+        break;
+    case CONFIG_KEY_TIME1_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(clock_font_line1), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(clock_font_line1_set), TRUE);
-    } else if (strcmp(key, "time1_timezone") == 0) {
+        break;
+    case CONFIG_KEY_TIME1_TIMEZONE:
         gtk_entry_set_text(GTK_ENTRY(clock_tmz_line1), value);
-    } else if (strcmp(key, "time2_timezone") == 0) {
+        break;
+    case CONFIG_KEY_TIME2_TIMEZONE:
         gtk_entry_set_text(GTK_ENTRY(clock_tmz_line2), value);
-    } else if (strcmp(key, "time2_font") == 0) {
+        break;
+    case CONFIG_KEY_TIME2_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(clock_font_line2), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(clock_font_line2_set), TRUE);
-    } else if (strcmp(key, "clock_font_color") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1552,40 +1905,55 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(clock_font_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "clock_padding") == 0) {
+        break;
+    }
+    case CONFIG_KEY_CLOCK_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(clock_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(clock_padding_y), atoi(value2));
-    } else if (strcmp(key, "clock_background_id") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(clock_background), id);
-    } else if (strcmp(key, "clock_tooltip") == 0) {
+        break;
+    }
+    case CONFIG_KEY_CLOCK_TOOLTIP:
         gtk_entry_set_text(GTK_ENTRY(clock_format_tooltip), value);
-    } else if (strcmp(key, "clock_tooltip_timezone") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_TOOLTIP_TIMEZONE:
         gtk_entry_set_text(GTK_ENTRY(clock_tmz_tooltip), value);
-    } else if (strcmp(key, "clock_lclick_command") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_LCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(clock_left_command), value);
-    } else if (strcmp(key, "clock_rclick_command") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_RCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(clock_right_command), value);
-    } else if (strcmp(key, "clock_mclick_command") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_MCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(clock_mclick_command), value);
-    } else if (strcmp(key, "clock_uwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_UWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(clock_uwheel_command), value);
-    } else if (strcmp(key, "clock_dwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_CLOCK_DWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(clock_dwheel_command), value);
+        break;
 
-    } else if (strcmp(key, "taskbar_mode") == 0) {
     /* Taskbar */
+    case CONFIG_KEY_TASKBAR_MODE:
         if (strcmp(value, "multi_desktop") == 0)
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_show_desktop), 1);
         else
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_show_desktop), 0);
-    } else if (strcmp(key, "taskbar_hide_if_empty") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_IF_EMPTY:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_hide_empty), atoi(value));
-    } else if (strcmp(key, "taskbar_distribute_size") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_DISTRIBUTE_SIZE:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_distribute_size), atoi(value));
-    } else if (strcmp(key, "taskbar_sort_order") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_SORT_ORDER:
         if (strcmp(value, "none") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_sort_order), 0);
         else if (strcmp(value, "title") == 0)
@@ -1600,7 +1968,8 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_sort_order), 5);
         else
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_sort_order), 0);
-    } else if (strcmp(key, "task_align") == 0) {
+        break;
+    case CONFIG_KEY_TASK_ALIGN:
         if (strcmp(value, "left") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_alignment), 0);
         else if (strcmp(value, "center") == 0)
@@ -1609,7 +1978,8 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_alignment), 2);
         else
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_alignment), 0);
-    } else if (strcmp(key, "taskbar_padding") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_padding_x), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_spacing), atoi(value1));
@@ -1617,41 +1987,57 @@ void add_entry(char *key, char *value)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_padding_y), atoi(value2));
         if (value3)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_spacing), atoi(value3));
-    } else if (strcmp(key, "taskbar_background_id") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_inactive_background), id);
         if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_active_background)) < 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_active_background), id);
-    } else if (strcmp(key, "taskbar_active_background_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASKBAR_ACTIVE_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_active_background), id);
-    } else if (strcmp(key, "taskbar_name") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASKBAR_NAME:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_show_name), atoi(value));
-    } else if (strcmp(key, "taskbar_hide_inactive_tasks") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_INACTIVE_TASKS:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_hide_inactive_tasks), atoi(value));
-    } else if (strcmp(key, "taskbar_hide_different_monitor") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_DIFFERENT_MONITOR:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_hide_diff_monitor), atoi(value));
-    } else if (strcmp(key, "taskbar_hide_different_desktop") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_HIDE_DIFFERENT_DESKTOP:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_hide_diff_desktop), atoi(value));
-    } else if (strcmp(key, "taskbar_always_show_all_desktop_tasks") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_ALWAYS_SHOW_ALL_DESKTOP_TASKS:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_always_show_all_desktop_tasks), atoi(value));
-    } else if (strcmp(key, "taskbar_name_padding") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_name_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(taskbar_name_padding_y), atoi(value2));
-    } else if (strcmp(key, "taskbar_name_background_id") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_name_inactive_background), id);
         if (gtk_combo_box_get_active(GTK_COMBO_BOX(taskbar_name_active_background)) < 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_name_active_background), id);
-    } else if (strcmp(key, "taskbar_name_active_background_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASKBAR_NAME_ACTIVE_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(taskbar_name_active_background), id);
-    } else if (strcmp(key, "taskbar_name_font") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASKBAR_NAME_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(taskbar_name_font), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(taskbar_name_font_set), TRUE);
-    } else if (strcmp(key, "taskbar_name_font_color") == 0) {
+        break;
+    case CONFIG_KEY_TASKBAR_NAME_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1660,7 +2046,9 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(taskbar_name_inactive_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "taskbar_name_active_font_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASKBAR_NAME_ACTIVE_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1669,27 +2057,35 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(taskbar_name_active_color), (alpha * 65535) / 100);
         }
+        break;
+    }
 
-    } else if (strcmp(key, "task_text") == 0) {
-        /* Task */
+    /* Task */
+    case CONFIG_KEY_TASK_TEXT:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_show_text), atoi(value));
-    } else if (strcmp(key, "task_icon") == 0) {
+        break;
+    case CONFIG_KEY_TASK_ICON:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_show_icon), atoi(value));
-    } else if (strcmp(key, "task_centered") == 0) {
+        break;
+    case CONFIG_KEY_TASK_CENTERED:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_align_center), atoi(value));
-    } else if (strcmp(key, "urgent_nb_of_blink") == 0) {
+        break;
+    case CONFIG_KEY_URGENT_NB_OF_BLINK:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_urgent_blinks), atoi(value));
-    } else if (strcmp(key, "task_width") == 0) {
+        break;
+    case CONFIG_KEY_TASK_WIDTH:
         // old parameter : just for backward compatibility
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_maximum_width), atoi(value));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_maximum_height), 30.0);
-    } else if (strcmp(key, "task_maximum_size") == 0) {
+        break;
+    case CONFIG_KEY_TASK_MAXIMUM_SIZE:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_maximum_width), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_maximum_height), 30.0);
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_maximum_height), atoi(value2));
-    } else if (strcmp(key, "task_padding") == 0) {
+        break;
+    case CONFIG_KEY_TASK_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_padding_x), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_spacing), atoi(value1));
@@ -1697,29 +2093,34 @@ void add_entry(char *key, char *value)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_padding_y), atoi(value2));
         if (value3)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(task_spacing), atoi(value3));
-    } else if (strcmp(key, "task_font") == 0) {
+        break;
+    case CONFIG_KEY_TASK_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(task_font), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_font_set), TRUE);
-    } else if (g_regex_match_simple("task.*_font_color", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
+        break;
+    case CONFIG_KEY_TASK_FONT_COLOR:
+    case CONFIG_KEY_TASK_NORMAL_FONT_COLOR:
+    case CONFIG_KEY_TASK_ACTIVE_FONT_COLOR:
+    case CONFIG_KEY_TASK_ICONIFIED_FONT_COLOR:
+    case CONFIG_KEY_TASK_URGENT_FONT_COLOR: {
+        ConfigKeyState state = config_key_state(key_id);
         GtkWidget *widget = NULL;
-        if (strcmp(split[1], "normal") == 0) {
+        if (state == CONFIG_STATE_NORMAL) {
             widget = task_normal_color;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_normal_color_set), 1);
-        } else if (strcmp(split[1], "active") == 0) {
+        } else if (state == CONFIG_STATE_ACTIVE) {
             widget = task_active_color;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_active_color_set), 1);
-        } else if (strcmp(split[1], "urgent") == 0) {
+        } else if (state == CONFIG_STATE_URGENT) {
             widget = task_urgent_color;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_urgent_color_set), 1);
-        } else if (strcmp(split[1], "iconified") == 0) {
+        } else if (state == CONFIG_STATE_ICONIFIED) {
             widget = task_iconified_color;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_iconified_color_set), 1);
-        } else if (strcmp(split[1], "font") == 0) {
+        } else {
             widget = task_default_color;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_default_color_set), 1);
         }
-        g_strfreev(split);
         if (widget) {
             extract_values(value, &value1, &value2, &value3);
             GdkColor col;
@@ -1730,84 +2131,101 @@ void add_entry(char *key, char *value)
                 gtk_color_button_set_alpha(GTK_COLOR_BUTTON(widget), (alpha * 65535) / 100);
             }
         }
-    } else if (g_regex_match_simple("task.*_icon_asb", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
+        break;
+    }
+    case CONFIG_KEY_TASK_ICON_ASB:
+    case CONFIG_KEY_TASK_NORMAL_ICON_ASB:
+    case CONFIG_KEY_TASK_ACTIVE_ICON_ASB:
+    case CONFIG_KEY_TASK_ICONIFIED_ICON_ASB:
+    case CONFIG_KEY_TASK_URGENT_ICON_ASB: {
+        ConfigKeyState state = config_key_state(key_id);
         GtkWidget *widget_opacity = NULL;
         GtkWidget *widget_saturation = NULL;
         GtkWidget *widget_brightness = NULL;
-        if (strcmp(split[1], "normal") == 0) {
+        if (state == CONFIG_STATE_NORMAL) {
             widget_opacity = task_normal_icon_opacity;
             widget_saturation = task_normal_icon_saturation;
             widget_brightness = task_normal_icon_brightness;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_normal_icon_osb_set), 1);
-        } else if (strcmp(split[1], "active") == 0) {
+        } else if (state == CONFIG_STATE_ACTIVE) {
             widget_opacity = task_active_icon_opacity;
             widget_saturation = task_active_icon_saturation;
             widget_brightness = task_active_icon_brightness;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_active_icon_osb_set), 1);
-        } else if (strcmp(split[1], "urgent") == 0) {
+        } else if (state == CONFIG_STATE_URGENT) {
             widget_opacity = task_urgent_icon_opacity;
             widget_saturation = task_urgent_icon_saturation;
             widget_brightness = task_urgent_icon_brightness;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_urgent_icon_osb_set), 1);
-        } else if (strcmp(split[1], "iconified") == 0) {
+        } else if (state == CONFIG_STATE_ICONIFIED) {
             widget_opacity = task_iconified_icon_opacity;
             widget_saturation = task_iconified_icon_saturation;
             widget_brightness = task_iconified_icon_brightness;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_iconified_icon_osb_set), 1);
-        } else if (strcmp(split[1], "icon") == 0) {
+        } else {
             widget_opacity = task_default_icon_opacity;
             widget_saturation = task_default_icon_saturation;
             widget_brightness = task_default_icon_brightness;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_default_icon_osb_set), 1);
         }
-        g_strfreev(split);
         if (widget_opacity && widget_saturation && widget_brightness) {
             extract_values(value, &value1, &value2, &value3);
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(widget_opacity), atoi(value1));
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(widget_saturation), atoi(value2));
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(widget_brightness), atoi(value3));
         }
-    } else if (g_regex_match_simple("task.*_background_id", key, 0, 0)) {
-        gchar **split = g_regex_split_simple("_", key, 0, 0);
+        break;
+    }
+    case CONFIG_KEY_TASK_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_NORMAL_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_ACTIVE_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_ICONIFIED_BACKGROUND_ID:
+    case CONFIG_KEY_TASK_URGENT_BACKGROUND_ID: {
+        ConfigKeyState state = config_key_state(key_id);
         GtkWidget *widget = NULL;
-        if (strcmp(split[1], "normal") == 0) {
+        if (state == CONFIG_STATE_NORMAL) {
             widget = task_normal_background;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_normal_background_set), 1);
-        } else if (strcmp(split[1], "active") == 0) {
+        } else if (state == CONFIG_STATE_ACTIVE) {
             widget = task_active_background;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_active_background_set), 1);
-        } else if (strcmp(split[1], "urgent") == 0) {
+        } else if (state == CONFIG_STATE_URGENT) {
             widget = task_urgent_background;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_urgent_background_set), 1);
-        } else if (strcmp(split[1], "iconified") == 0) {
+        } else if (state == CONFIG_STATE_ICONIFIED) {
             widget = task_iconified_background;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_iconified_background_set), 1);
-        } else if (strcmp(split[1], "background") == 0) {
+        } else {
             widget = task_default_background;
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(task_default_background_set), 1);
         }
-        g_strfreev(split);
         if (widget) {
             int id = background_index_safe(atoi(value));
             gtk_combo_box_set_active(GTK_COMBO_BOX(widget), id);
         }
-    } else if (strcmp(key, "task_tooltip") == 0 || strcmp(key, "tooltip") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TASK_TOOLTIP:
         // "tooltip" is deprecated but here for backwards compatibility
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(tooltip_task_show), atoi(value));
-
-    } else if (strcmp(key, "task_thumbnail") == 0) {
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(tooltip_task_thumbnail), atoi(value));
-
-    } else if (strcmp(key, "task_thumbnail_size") == 0) {
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL_SIZE:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_task_thumbnail_size), MAX(8, atoi(value)));
+        break;
+    case CONFIG_KEY_TASK_THUMBNAIL_CACHE_SIZE:
+        gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_task_thumbnail_cache_size), MAX(1, atoi(value)));
+        break;
 
-    } else if (strcmp(key, "systray") == 0) {
     /* Systray */
+    case CONFIG_KEY_SYSTRAY:
         // Obsolete option
         config_has_systray = 1;
         config_systray_enabled = atoi(value);
-    } else if (strcmp(key, "systray_padding") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_PADDING:
         no_items_systray_enabled = 1;
 
         extract_values(value, &value1, &value2, &value3);
@@ -1817,10 +2235,13 @@ void add_entry(char *key, char *value)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_padding_y), atoi(value2));
         if (value3)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_spacing), atoi(value3));
-    } else if (strcmp(key, "systray_background_id") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(systray_background), id);
-    } else if (strcmp(key, "systray_sort") == 0) {
+        break;
+    }
+    case CONFIG_KEY_SYSTRAY_SORT:
         if (strcmp(value, "descending") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_icon_order), 1);
         else if (strcmp(value, "ascending") == 0)
@@ -1829,9 +2250,11 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_icon_order), 3);
         else // default to left2right
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_icon_order), 2);
-    } else if (strcmp(key, "systray_icon_size") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_ICON_SIZE:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_icon_size), atoi(value));
-    } else if (strcmp(key, "systray_monitor") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_MONITOR:
         if (strcmp(value, "primary") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_monitor), 0);
         else if (strcmp(value, "1") == 0)
@@ -1846,16 +2269,19 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_monitor), 5);
         else if (strcmp(value, "6") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(systray_monitor), 6);
-    } else if (strcmp(key, "systray_icon_asb") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_icon_opacity), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_icon_saturation), atoi(value2));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(systray_icon_brightness), atoi(value3));
-    } else if (strcmp(key, "systray_name_filter") == 0) {
+        break;
+    case CONFIG_KEY_SYSTRAY_NAME_FILTER:
         gtk_entry_set_text(GTK_ENTRY(systray_name_filter), value);
+        break;
 
-    } else if (strcmp(key, "launcher_padding") == 0) {
-        /* Launcher */
+    /* Launcher */
+    case CONFIG_KEY_LAUNCHER_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_padding_x), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_spacing), atoi(value1));
@@ -1863,20 +2289,28 @@ void add_entry(char *key, char *value)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_padding_y), atoi(value2));
         if (value3)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_spacing), atoi(value3));
-    } else if (strcmp(key, "launcher_background_id") == 0) {
+        break;
+    case CONFIG_KEY_LAUNCHER_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(launcher_background), id);
-    } else if (strcmp(key, "launcher_icon_background_id") == 0) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_ICON_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(launcher_icon_background), id);
-    } else if (strcmp(key, "launcher_icon_size") == 0) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_ICON_SIZE:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_icon_size), atoi(value));
-    } else if (strcmp(key, "launcher_item_app") == 0) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ITEM_APP: {
         char *path = expand_tilde(value);
         load_desktop_file(path, TRUE);
         load_desktop_file(path, FALSE);
         free(path);
-    } else if (strcmp(key, "launcher_apps_dir") == 0) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_APPS_DIR: {
         char *path = expand_tilde(value);
 
         int position = gtk_entry_get_text_length(GTK_ENTRY(launcher_apps_dirs));
@@ -1887,34 +2321,46 @@ void add_entry(char *key, char *value)
         gtk_editable_insert_text(GTK_EDITABLE(launcher_apps_dirs), path, strlen(path), &position);
 
         free(path);
-    } else if (strcmp(key, "launcher_icon_theme") == 0) {
+        break;
+    }
+    case CONFIG_KEY_LAUNCHER_ICON_THEME:
         set_current_icon_theme(value);
-    } else if (strcmp(key, "launcher_icon_theme_override") == 0) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ICON_THEME_OVERRIDE:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(launcher_icon_theme_override), atoi(value));
-    } else if (strcmp(key, "launcher_tooltip") == 0) {
+        break;
+    case CONFIG_KEY_LAUNCHER_TOOLTIP:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(launcher_tooltip), atoi(value));
-    } else if (strcmp(key, "startup_notifications") == 0) {
+        break;
+    case CONFIG_KEY_STARTUP_NOTIFICATIONS:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(startup_notifications), atoi(value));
-    } else if (strcmp(key, "launcher_icon_asb") == 0) {
+        break;
+    case CONFIG_KEY_LAUNCHER_ICON_ASB:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_icon_opacity), atoi(value1));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_icon_saturation), atoi(value2));
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(launcher_icon_brightness), atoi(value3));
+        break;
 
-    } else if (strcmp(key, "tooltip_show_timeout") == 0) {
-        /* Tooltip */
+    /* Tooltip */
+    case CONFIG_KEY_TOOLTIP_SHOW_TIMEOUT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_show_after), atof(value));
-    } else if (strcmp(key, "tooltip_hide_timeout") == 0) {
+        break;
+    case CONFIG_KEY_TOOLTIP_HIDE_TIMEOUT:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_hide_after), atof(value));
-    } else if (strcmp(key, "tooltip_padding") == 0) {
+        break;
+    case CONFIG_KEY_TOOLTIP_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(tooltip_padding_y), atoi(value2));
-    } else if (strcmp(key, "tooltip_background_id") == 0) {
+        break;
+    case CONFIG_KEY_TOOLTIP_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(tooltip_background), id);
-    } else if (strcmp(key, "tooltip_font_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TOOLTIP_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1923,29 +2369,40 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(tooltip_font_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "tooltip_font") == 0) {
+        break;
+    }
+    case CONFIG_KEY_TOOLTIP_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(tooltip_font), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(tooltip_font_set), TRUE);
+        break;
 
-    } else if (strcmp(key, "mouse_left") == 0) {
-        /* Mouse actions */
+    /* Mouse actions */
+    case CONFIG_KEY_MOUSE_LEFT:
         set_action(value, task_mouse_left);
-    } else if (strcmp(key, "mouse_middle") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_MIDDLE:
         set_action(value, task_mouse_middle);
-    } else if (strcmp(key, "mouse_right") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_RIGHT:
         set_action(value, task_mouse_right);
-    } else if (strcmp(key, "mouse_scroll_up") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_SCROLL_UP:
         set_action(value, task_mouse_scroll_up);
-    } else if (strcmp(key, "mouse_scroll_down") == 0) {
+        break;
+    case CONFIG_KEY_MOUSE_SCROLL_DOWN:
         set_action(value, task_mouse_scroll_down);
+        break;
 
-    } else if (strcmp(key, "separator") == 0) {
-        /* Separator */
+    /* Separator */
+    case CONFIG_KEY_SEPARATOR:
         separator_create_new();
-    } else if (strcmp(key, "separator_background_id") == 0) {
+        break;
+    case CONFIG_KEY_SEPARATOR_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(separator_get_last()->separator_background), id);
-    } else if (strcmp(key, "separator_color") == 0) {
+        break;
+    }
+    case CONFIG_KEY_SEPARATOR_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -1954,41 +2411,58 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(separator_get_last()->separator_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "separator_style") == 0) {
+        break;
+    }
+    case CONFIG_KEY_SEPARATOR_STYLE:
         if (g_str_equal(value, "empty"))
             gtk_combo_box_set_active(GTK_COMBO_BOX(separator_get_last()->separator_style), 0);
         else if (g_str_equal(value, "line"))
             gtk_combo_box_set_active(GTK_COMBO_BOX(separator_get_last()->separator_style), 1);
         else if (g_str_equal(value, "dots"))
             gtk_combo_box_set_active(GTK_COMBO_BOX(separator_get_last()->separator_style), 2);
-    } else if (strcmp(key, "separator_size") == 0) {
+        break;
+    case CONFIG_KEY_SEPARATOR_SIZE:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(separator_get_last()->separator_size), atoi(value));
-    } else if (strcmp(key, "separator_padding") == 0) {
+        break;
+    case CONFIG_KEY_SEPARATOR_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(separator_get_last()->separator_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(separator_get_last()->separator_padding_y), atoi(value2));
+        break;
 
-    } else if (strcmp(key, "execp") == 0) {
-        /* Executor */
+    /* Executor */
+    case CONFIG_KEY_EXECP:
         execp_create_new();
-    } else if (strcmp(key, "execp_name") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_NAME:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_name), value);
-    } else if (strcmp(key, "execp_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_command), value);
-    } else if (strcmp(key, "execp_interval") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_INTERVAL:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_interval), atoi(value));
-    } else if (strcmp(key, "execp_has_icon") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_HAS_ICON:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_has_icon), atoi(value));
-    } else if (strcmp(key, "execp_isolate") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_ISOLATE:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_isolate), atoi(value));
-    } else if (strcmp(key, "execp_cache_icon") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_CACHE_ICON:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_cache_icon), atoi(value));
-    } else if (strcmp(key, "execp_continuous") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_CONTINUOUS:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_continuous), atoi(value));
-    } else if (strcmp(key, "execp_markup") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_MAX_BUFFER_SIZE:
+        gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_max_buffer_size), atoi(value));
+        break;
+    case CONFIG_KEY_EXECP_MARKUP:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_markup), atoi(value));
-    } else if (strcmp(key, "execp_monitor") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_MONITOR:
         if (strcmp(value, "all") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(execp_get_last()->execp_monitor), 0);
         else if (strcmp(value, "primary") == 0)
@@ -2005,27 +2479,35 @@ void add_entry(char *key, char *value)
             gtk_combo_box_set_active(GTK_COMBO_BOX(execp_get_last()->execp_monitor), 6);
         else if (strcmp(value, "6") == 0)
             gtk_combo_box_set_active(GTK_COMBO_BOX(execp_get_last()->execp_monitor), 7);
-    } else if (strcmp(key, "execp_tooltip") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_TOOLTIP:
         if (strlen(value) > 0) {
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_show_tooltip), 1);
         } else {
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_show_tooltip), 0);
         }
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_tooltip), value);
-    } else if (strcmp(key, "execp_lclick_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_LCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_left_command), value);
-    } else if (strcmp(key, "execp_rclick_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_RCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_right_command), value);
-    } else if (strcmp(key, "execp_mclick_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_MCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_mclick_command), value);
-    } else if (strcmp(key, "execp_uwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_UWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_uwheel_command), value);
-    } else if (strcmp(key, "execp_dwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_DWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(execp_get_last()->execp_dwheel_command), value);
-    } else if (strcmp(key, "execp_font") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(execp_get_last()->execp_font), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_font_set), TRUE);
-    } else if (strcmp(key, "execp_font_color") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -2034,44 +2516,62 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(execp_get_last()->execp_font_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "execp_padding") == 0) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_padding_y), atoi(value2));
-    } else if (strcmp(key, "execp_background_id") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(execp_get_last()->execp_background), id);
-    } else if (strcmp(key, "execp_icon_w") == 0) {
+        break;
+    }
+    case CONFIG_KEY_EXECP_ICON_W:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_icon_w), atoi(value));
-    } else if (strcmp(key, "execp_icon_h") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_ICON_H:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(execp_get_last()->execp_icon_h), atoi(value));
-    } else if (strcmp(key, "execp_centered") == 0) {
+        break;
+    case CONFIG_KEY_EXECP_CENTERED:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(execp_get_last()->execp_centered), atoi(value));
+        break;
 
-    } else if (strcmp(key, "button") == 0) {
-        /* Button */
+    /* Button */
+    case CONFIG_KEY_BUTTON:
         button_create_new();
-    } else if (strcmp(key, "button_icon") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_ICON:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_icon), value);
-    } else if (strcmp(key, "button_text") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_TEXT:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_text), value);
-    } else if (strcmp(key, "button_tooltip") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_TOOLTIP:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_tooltip), value);
-    } else if (strcmp(key, "button_lclick_command") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_LCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_left_command), value);
-    } else if (strcmp(key, "button_rclick_command") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_RCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_right_command), value);
-    } else if (strcmp(key, "button_mclick_command") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_MCLICK_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_mclick_command), value);
-    } else if (strcmp(key, "button_uwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_UWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_uwheel_command), value);
-    } else if (strcmp(key, "button_dwheel_command") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_DWHEEL_COMMAND:
         gtk_entry_set_text(GTK_ENTRY(button_get_last()->button_dwheel_command), value);
-    } else if (strcmp(key, "button_font") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_FONT:
         gtk_font_button_set_font_name(GTK_FONT_BUTTON(button_get_last()->button_font), value);
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(button_get_last()->button_font_set), TRUE);
-    } else if (strcmp(key, "button_font_color") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_FONT_COLOR: {
         extract_values(value, &value1, &value2, &value3);
         GdkColor col;
         hex2gdk(value1, &col);
@@ -2080,18 +2580,27 @@ void add_entry(char *key, char *value)
             int alpha = atoi(value2);
             gtk_color_button_set_alpha(GTK_COLOR_BUTTON(button_get_last()->button_font_color), (alpha * 65535) / 100);
         }
-    } else if (strcmp(key, "button_padding") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BUTTON_PADDING:
         extract_values(value, &value1, &value2, &value3);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(button_get_last()->button_padding_x), atoi(value1));
         if (value2)
             gtk_spin_button_set_value(GTK_SPIN_BUTTON(button_get_last()->button_padding_y), atoi(value2));
-    } else if (strcmp(key, "button_background_id") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_BACKGROUND_ID: {
         int id = background_index_safe(atoi(value));
         gtk_combo_box_set_active(GTK_COMBO_BOX(button_get_last()->button_background), id);
-    } else if (strcmp(key, "button_centered") == 0) {
+        break;
+    }
+    case CONFIG_KEY_BUTTON_CENTERED:
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(button_get_last()->button_centered), atoi(value));
-    } else if (strcmp(key, "button_max_icon_size") == 0) {
+        break;
+    case CONFIG_KEY_BUTTON_MAX_ICON_SIZE:
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(button_get_last()->button_max_icon_size), atoi(value));
+        break;
+    default:
+        break;
     }
 
     if (value1)
@@ -363,6 +363,13 @@ void schedule_redraw(Area *a)
     schedule_panel_redraw();
 }
 
+void schedule_resize_tree(Area *a)
+{
+    a->resize_needed = TRUE;
+    for (GList *l = a->children; l; l = l->next)
+        schedule_resize_tree((Area *)l->data);
+}
+
 void draw_tree(Area *a)
 {
     if (!a->on_screen)
@@ -319,6 +319,9 @@ int top_bottom_bg_border_width(Background *bg);
 // Sets the redraw_needed flag on the area and its descendants
 void schedule_redraw(Area *a);
 
+// Sets the resize_needed flag on the area and its descendants
+void schedule_resize_tree(Area *a);
+
 // Recreates the Area pixmap and draws the background and the foreground
 void draw(Area *a);
 
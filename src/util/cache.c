@@ -24,17 +24,388 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "common.h"
+#include "hash.h"
+#include "test.h"
+
+// File layout (native byte order, the file is never shared between machines):
+//   CacheHeader
+//   guint32 buckets[n_buckets]: offsets of the records of the compacted entries, 0 for empty slots
+//   CacheRecord records, each followed by "key\0value\0" and padded to 8 bytes (values may contain null bytes):
+//     first the compacted entries, up to log_offset, then the appended entries until the end of the file.
+// Appended entries take precedence over compacted ones; later appended entries over earlier ones.
+
+#define CACHE_MAGIC "T2CACHE"
+#define CACHE_VERSION 1
+// The file is compacted when the appended entries take more space than this and than the compacted ones
+#define CACHE_MIN_LOG_SIZE (16 * 1024)
+// Size limit of the compacted entries when Cache.max_size is not set, well below the range of the guint32 offsets
+#define CACHE_DEFAULT_MAX_SIZE (G_MAXUINT32 / 4)
+
+typedef struct CacheHeader {
+    char magic[8];
+    guint32 version;
+    // Number of slots of the hash table, a power of two. Collisions are resolved by linear probing.
+    guint32 n_buckets;
+    // Offset of the first appended record
+    guint32 log_offset;
+    guint32 n_entries;
+} CacheHeader;
+
+typedef struct CacheRecord {
+    guint64 stamp;
+    guint32 hash;
+    guint32 key_len;
+    guint32 value_len;
+    // Time (in seconds since the epoch) at which the entry was last found or added, as of the last compaction
+    guint32 last_used;
+} CacheRecord;
+
+typedef struct CacheEntry {
+    // Followed by a null byte that is not counted in size
+    gchar *value;
+    size_t size;
+    guint64 stamp;
+    guint32 last_used;
+} CacheEntry;
+
+static guint32 cache_key_hash(const char *key)
+{
+    return (guint32)hash64(key, strlen(key), 0);
+}
+
+static size_t record_size(size_t key_len, size_t value_len)
+{
+    return (sizeof(CacheRecord) + key_len + value_len + 2 + 7) & ~(size_t)7;
+}
+
+static const char *record_key(const CacheRecord *record)
+{
+    return (const char *)(record + 1);
+}
+
+static const char *record_value(const CacheRecord *record)
+{
+    return record_key(record) + record->key_len + 1;
+}
+
+// Returns the record at offset if it lies within the first size bytes of data, NULL otherwise
+static const CacheRecord *record_at(const unsigned char *data, size_t size, size_t offset)
+{
+    if (offset % 8 != 0 || offset + sizeof(CacheRecord) > size)
+        return NULL;
+    const CacheRecord *record = (const CacheRecord *)(data + offset);
+    if ((size_t)record->key_len + (size_t)record->value_len + 2 > size - offset - sizeof(CacheRecord))
+        return NULL;
+    if (record_key(record)[record->key_len] != '\0' || record_value(record)[record->value_len] != '\0')
+        return NULL;
+    return record;
+}
+
+// Returns the header if data holds a valid cache file, NULL otherwise
+static const CacheHeader *cache_header(const unsigned char *data, size_t size)
+{
+    if (!data || size < sizeof(CacheHeader))
+        return NULL;
+    const CacheHeader *header = (const CacheHeader *)data;
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0 || header->version != CACHE_VERSION)
+        return NULL;
+    if (header->n_buckets == 0 || (header->n_buckets & (header->n_buckets - 1)) != 0)
+        return NULL;
+    if (header->log_offset > size || sizeof(CacheHeader) + 4 * (size_t)header->n_buckets > header->log_offset)
+        return NULL;
+    return header;
+}
+
+static const CacheRecord *find_compacted_record(const unsigned char *data, size_t size, const char *key)
+{
+    const CacheHeader *header = cache_header(data, size);
+    if (!header)
+        return NULL;
+    const guint32 *buckets = (const guint32 *)(header + 1);
+    guint32 hash = cache_key_hash(key);
+    guint32 mask = header->n_buckets - 1;
+    for (guint32 i = 0; i < header->n_buckets; i++) {
+        guint32 offset = buckets[(hash + i) & mask];
+        if (!offset)
+            return NULL;
+        const CacheRecord *record = record_at(data, header->log_offset, offset);
+        if (!record)
+            return NULL;
+        if (record->hash == hash && strcmp(record_key(record), key) == 0)
+            return record;
+    }
+    return NULL;
+}
+
+typedef void (*CacheRecordFunc)(const CacheRecord *record, gpointer user_data);
+
+// Calls func for each appended record, in file order.
+// Returns the offset where the valid records end, which is the file size unless the file is damaged.
+static size_t scan_appended_records(const unsigned char *data, size_t size, CacheRecordFunc func, gpointer user_data)
+{
+    const CacheHeader *header = cache_header(data, size);
+    if (!header)
+        return 0;
+    size_t offset = header->log_offset;
+    const CacheRecord *record;
+    while ((record = record_at(data, size, offset))) {
+        if (func)
+            func(record, user_data);
+        offset += record_size(record->key_len, record->value_len);
+    }
+    return offset;
+}
+
+static void free_cache_entry(gpointer data)
+{
+    CacheEntry *entry = (CacheEntry *)data;
+    g_free(entry->value);
+    g_free(entry);
+}
+
+static void put_entry(GHashTable *table,
+                      const char *key,
+                      const void *value,
+                      size_t size,
+                      guint64 stamp,
+                      guint32 last_used)
+{
+    CacheEntry *entry = g_new(CacheEntry, 1);
+    entry->value = g_malloc(size + 1);
+    memcpy(entry->value, value, size);
+    entry->value[size] = '\0';
+    entry->size = size;
+    entry->stamp = stamp;
+    entry->last_used = last_used;
+    g_hash_table_insert(table, g_strdup(key), entry);
+}
+
+static void put_record(const CacheRecord *record, gpointer user_data)
+{
+    put_entry((GHashTable *)user_data,
+              record_key(record),
+              record_value(record),
+              record->value_len,
+              record->stamp,
+              record->last_used);
+}
+
+static void append_record(GByteArray *buffer,
+                          const char *key,
+                          const void *value,
+                          size_t value_len,
+                          guint64 stamp,
+                          guint32 last_used)
+{
+    CacheRecord record;
+    memset(&record, 0, sizeof(record));
+    record.stamp = stamp;
+    record.last_used = last_used;
+    record.hash = cache_key_hash(key);
+    record.key_len = (guint32)strlen(key);
+    record.value_len = (guint32)value_len;
+    size_t size = record_size(record.key_len, record.value_len);
+    guint start = buffer->len;
+    g_byte_array_set_size(buffer, start + (guint)size);
+    memset(buffer->data + start, 0, size);
+    memcpy(buffer->data + start, &record, sizeof(record));
+    memcpy(buffer->data + start + sizeof(record), key, record.key_len);
+    memcpy(buffer->data + start + sizeof(record) + record.key_len + 1, value, record.value_len);
+}
+
+static gboolean write_all(int fd, const void *data, size_t size)
+{
+    const char *p = (const char *)data;
+    while (size > 0) {
+        ssize_t count = write(fd, p, size);
+        if (count < 0)
+            return FALSE;
+        p += count;
+        size -= (size_t)count;
+    }
+    return TRUE;
+}
+
+typedef struct CompactionState {
+    GByteArray *buffer;
+    guint32 *buckets;
+    guint32 mask;
+} CompactionState;
+
+static void add_compacted_record(gpointer key, gpointer value, gpointer user_data)
+{
+    CompactionState *state = (CompactionState *)user_data;
+    CacheEntry *entry = (CacheEntry *)value;
+    guint32 offset = state->buffer->len;
+    append_record(state->buffer, (const char *)key, entry->value, entry->size, entry->stamp, entry->last_used);
+    guint32 i = cache_key_hash((const char *)key) & state->mask;
+    while (state->buckets[i])
+        i = (i + 1) & state->mask;
+    state->buckets[i] = offset;
+}
+
+static guint32 current_time()
+{
+    return (guint32)time(NULL);
+}
+
+static gint compare_last_used(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    GHashTable *entries = (GHashTable *)user_data;
+    guint32 time_a = ((CacheEntry *)g_hash_table_lookup(entries, a))->last_used;
+    guint32 time_b = ((CacheEntry *)g_hash_table_lookup(entries, b))->last_used;
+    return time_a < time_b ? -1 : time_a > time_b ? 1 : 0;
+}
+
+// Drops the entries that are not worth keeping: those that have not been used since loading and that
+// cache->keep_unused rejects, then the least recently used ones until the records fit in 3/4 of the size
+// limit (so that the next few saves can append instead of compacting again).
+static void evict_cache_entries(Cache *cache, GHashTable *entries)
+{
+    GHashTableIter iter;
+    gpointer key, value;
+    size_t total_size = 0;
+    g_hash_table_iter_init(&iter, entries);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        CacheEntry *entry = (CacheEntry *)value;
+        if (cache->keep_unused && !g_hash_table_contains(cache->_used, key) &&
+            !cache->keep_unused((const char *)key, entry->stamp)) {
+            g_hash_table_iter_remove(&iter);
+            continue;
+        }
+        total_size += record_size(strlen((const char *)key), entry->size);
+    }
+
+    size_t max_size = cache->max_size ? MIN(cache->max_size, CACHE_DEFAULT_MAX_SIZE) : CACHE_DEFAULT_MAX_SIZE;
+    if (total_size <= max_size)
+        return;
+    GList *keys = g_list_sort_with_data(g_hash_table_get_keys(entries), compare_last_used, entries);
+    for (GList *l = keys; l && total_size > max_size / 4 * 3; l = g_list_next(l)) {
+        CacheEntry *entry = (CacheEntry *)g_hash_table_lookup(entries, l->data);
+        total_size -= record_size(strlen((const char *)l->data), entry->size);
+        g_hash_table_remove(entries, l->data);
+    }
+    g_list_free(keys);
+}
+
+// Rewrites the file with the entries of the current file (data) and the entries added to the cache since
+// the last save, dropping the superseded entries and evicting entries as needed (see evict_cache_entries).
+// The new file replaces the old one atomically.
+static gboolean compact_cache_file(Cache *cache, const gchar *cache_path, const unsigned char *data, size_t size)
+{
+    GHashTable *entries = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_cache_entry);
+    const CacheHeader *header = cache_header(data, size);
+    if (header) {
+        const guint32 *buckets = (const guint32 *)(header + 1);
+        for (guint32 i = 0; i < header->n_buckets; i++) {
+            const CacheRecord *record = buckets[i] ? record_at(data, header->log_offset, buckets[i]) : NULL;
+            if (record)
+                put_record(record, entries);
+        }
+        scan_appended_records(data, size, put_record, entries);
+    }
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, cache->_pending);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        CacheEntry *entry = (CacheEntry *)g_hash_table_lookup(cache->_table, key);
+        put_entry(entries, (const char *)key, entry->value, entry->size, entry->stamp, entry->last_used);
+    }
+    // The use times of the entries found since loading are only updated here
+    guint32 now = current_time();
+    g_hash_table_iter_init(&iter, cache->_used);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        CacheEntry *entry = (CacheEntry *)g_hash_table_lookup(entries, key);
+        if (entry)
+            entry->last_used = now;
+    }
+    evict_cache_entries(cache, entries);
+
+    guint32 n_entries = g_hash_table_size(entries);
+    guint32 n_buckets = 16;
+    while (n_buckets < 2 * n_entries)
+        n_buckets *= 2;
+    CacheHeader new_header;
+    memset(&new_header, 0, sizeof(new_header));
+    memcpy(new_header.magic, CACHE_MAGIC, sizeof(new_header.magic));
+    new_header.version = CACHE_VERSION;
+    new_header.n_buckets = n_buckets;
+    new_header.n_entries = n_entries;
+
+    CompactionState state;
+    state.buffer = g_byte_array_new();
+    state.buckets = g_new0(guint32, n_buckets);
+    state.mask = n_buckets - 1;
+    // The records are placed after the header and the hash table
+    g_byte_array_set_size(state.buffer, (guint)(sizeof(CacheHeader) + 4 * (size_t)n_buckets));
+    g_hash_table_foreach(entries, add_compacted_record, &state);
+    new_header.log_offset = state.buffer->len;
+    memcpy(state.buffer->data, &new_header, sizeof(new_header));
+    memcpy(state.buffer->data + sizeof(CacheHeader), state.buckets, 4 * (size_t)n_buckets);
+
+    gboolean ok = FALSE;
+    gchar *tmp_path = g_strdup_printf("%s.%d.tmp", cache_path, (int)getpid());
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd != -1) {
+        ok = write_all(fd, state.buffer->data, state.buffer->len);
+        ok = close(fd) == 0 && ok;
+        ok = ok && rename(tmp_path, cache_path) == 0;
+        if (!ok)
+            unlink(tmp_path);
+    }
+    g_free(tmp_path);
+    g_free(state.buckets);
+    g_byte_array_free(state.buffer, TRUE);
+    g_hash_table_destroy(entries);
+    return ok;
+}
+
+// Opens and locks the cache file. Retries if the file is replaced by another process (by compaction)
+// while waiting for the lock, so that nothing is appended to a file that is no longer in use.
+static int open_locked_cache_file(const gchar *cache_path, int flags, int operation)
+{
+    for (int attempt = 0; attempt < 10; attempt++) {
+        int fd = open(cache_path, flags, 0600);
+        if (fd == -1)
+            return -1;
+        flock(fd, operation);
+        struct stat fd_st, path_st;
+        if (fstat(fd, &fd_st) == 0 && stat(cache_path, &path_st) == 0 && fd_st.st_ino == path_st.st_ino &&
+            fd_st.st_dev == path_st.st_dev)
+            return fd;
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+    return -1;
+}
+
+// Maps the file open as fd in memory. Returns NULL if it is empty or cannot be mapped.
+static const unsigned char *map_cache_file(int fd, size_t *size)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        return NULL;
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return NULL;
+    *size = (size_t)st.st_size;
+    return (const unsigned char *)data;
+}
 
 void init_cache(Cache *cache)
 {
-    if (cache->_table)
+    if (cache->_table || cache->_data)
         free_cache(cache);
-    cache->_table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    cache->_table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_cache_entry);
+    cache->_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    cache->_used = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
     cache->dirty = FALSE;
     cache->loaded = FALSE;
 }
@@ -44,6 +415,16 @@ void free_cache(Cache *cache)
     if (cache->_table)
         g_hash_table_destroy(cache->_table);
     cache->_table = NULL;
+    if (cache->_pending)
+        g_hash_table_destroy(cache->_pending);
+    cache->_pending = NULL;
+    if (cache->_used)
+        g_hash_table_destroy(cache->_used);
+    cache->_used = NULL;
+    if (cache->_data)
+        munmap((void *)cache->_data, cache->_size);
+    cache->_data = NULL;
+    cache->_size = 0;
     cache->dirty = FALSE;
     cache->loaded = FALSE;
 }
@@ -54,107 +435,255 @@ void load_cache(Cache *cache, const gchar *cache_path)
 
     cache->loaded = TRUE;
 
-    int fd = open(cache_path, O_RDONLY);
+    int fd = open_locked_cache_file(cache_path, O_RDONLY, LOCK_SH);
     if (fd == -1)
         return;
-    flock(fd, LOCK_SH);
-
-    FILE *f = fopen(cache_path, "rt");
-    if (!f)
-        goto unlock;
-
-    char *line = NULL;
-    size_t line_size;
-
-    while (getline(&line, &line_size, f) >= 0) {
-        char *key, *value;
-
-        size_t line_len = strlen(line);
-        gboolean has_newline = FALSE;
-        if (line_len >= 1) {
-            if (line[line_len - 1] == '\n') {
-                line[line_len - 1] = '\0';
-                line_len--;
-                has_newline = TRUE;
-            }
-        }
-        if (!has_newline)
-            break;
 
-        if (line_len == 0)
-            continue;
-
-        if (parse_line(line, &key, &value)) {
-            g_hash_table_insert(cache->_table, g_strdup(key), g_strdup(value));
-            free(key);
-            free(value);
-        }
-    }
-    free(line);
-    fclose(f);
+    // The file is never modified in place except by appending, so the mapping stays valid after unlocking
+    cache->_data = map_cache_file(fd, &cache->_size);
+    scan_appended_records(cache->_data, cache->_size, put_record, cache->_table);
 
-unlock:
     flock(fd, LOCK_UN);
     close(fd);
 }
 
-void write_cache_line(gpointer key, gpointer value, gpointer user_data)
-{
-    gchar *k = key;
-    gchar *v = value;
-    FILE *f = user_data;
-
-    fprintf(f, "%s=%s\n", k, v);
-}
-
 void save_cache(Cache *cache, const gchar *cache_path)
 {
-    int fd = open(cache_path, O_RDONLY | O_CREAT, 0600);
+    int fd = open_locked_cache_file(cache_path, O_RDWR | O_CREAT, LOCK_EX);
     if (fd == -1) {
         gchar *dir_path = g_path_get_dirname(cache_path);
         g_mkdir_with_parents(dir_path, 0700);
         g_free(dir_path);
-        fd = open(cache_path, O_RDONLY | O_CREAT, 0600);
+        fd = open_locked_cache_file(cache_path, O_RDWR | O_CREAT, LOCK_EX);
     }
     if (fd == -1) {
-        fprintf(stderr, RED "tint2: Could not save icon theme cache!" RESET "\n");
+        fprintf(stderr, RED "tint2: Could not save cache %s!" RESET "\n", cache_path);
         return;
     }
-    flock(fd, LOCK_EX);
 
-    FILE *f = fopen(cache_path, "w");
-    if (!f) {
-        fprintf(stderr, RED "tint2: Could not save icon theme cache!" RESET "\n");
-        goto unlock;
+    // Other processes may have appended to or compacted the file since it was loaded
+    size_t size = 0;
+    const unsigned char *data = map_cache_file(fd, &size);
+    const CacheHeader *header = cache_header(data, size);
+
+    GByteArray *buffer = g_byte_array_new();
+    if (cache->_pending) {
+        GHashTableIter iter;
+        gpointer key;
+        g_hash_table_iter_init(&iter, cache->_pending);
+        while (g_hash_table_iter_next(&iter, &key, NULL)) {
+            CacheEntry *entry = (CacheEntry *)g_hash_table_lookup(cache->_table, key);
+            append_record(buffer, (const char *)key, entry->value, entry->size, entry->stamp, entry->last_used);
+        }
     }
-    g_hash_table_foreach(cache->_table, write_cache_line, f);
-    fclose(f);
+
+    gboolean ok;
+    if (header && scan_appended_records(data, size, NULL, NULL) == size &&
+        size - header->log_offset + buffer->len <= MAX(CACHE_MIN_LOG_SIZE, header->log_offset) &&
+        (!cache->max_size || size + buffer->len <= cache->max_size)) {
+        ok = lseek(fd, 0, SEEK_END) != (off_t)-1 && write_all(fd, buffer->data, buffer->len);
+    } else {
+        ok = cache->_pending && compact_cache_file(cache, cache_path, data, size);
+    }
+    if (!ok)
+        fprintf(stderr, RED "tint2: Could not save cache %s!" RESET "\n", cache_path);
+    g_byte_array_free(buffer, TRUE);
+    if (data)
+        munmap((void *)data, size);
+    if (cache->_pending)
+        g_hash_table_remove_all(cache->_pending);
     cache->dirty = FALSE;
 
-unlock:
     flock(fd, LOCK_UN);
     close(fd);
 }
 
-const gchar *get_from_cache(Cache *cache, const gchar *key)
+static void mark_used(Cache *cache, const gchar *key)
+{
+    if (!g_hash_table_contains(cache->_used, key))
+        g_hash_table_add(cache->_used, g_strdup(key));
+}
+
+// Returns the value of the entry whatever its stamp, which is stored in stamp, or NULL if not found
+static const void *find_blob(Cache *cache, const gchar *key, guint64 *stamp, size_t *size)
 {
     if (!cache->_table)
         return NULL;
-    return g_hash_table_lookup(cache->_table, key);
+    CacheEntry *entry = (CacheEntry *)g_hash_table_lookup(cache->_table, key);
+    if (entry) {
+        *stamp = entry->stamp;
+        *size = entry->size;
+        return entry->value;
+    }
+    const CacheRecord *record = find_compacted_record(cache->_data, cache->_size, key);
+    if (!record)
+        return NULL;
+    *stamp = record->stamp;
+    *size = record->value_len;
+    return record_value(record);
 }
 
-void add_to_cache(Cache *cache, const gchar *key, const gchar *value)
+const void *get_blob_from_cache(Cache *cache, const gchar *key, guint64 stamp, size_t *size)
+{
+    guint64 entry_stamp;
+    size_t entry_size;
+    const void *value = find_blob(cache, key, &entry_stamp, &entry_size);
+    if (!value || entry_stamp != stamp)
+        return NULL;
+    mark_used(cache, key);
+    *size = entry_size;
+    return value;
+}
+
+const gchar *get_from_cache_with_stamp(Cache *cache, const gchar *key, guint64 *stamp)
+{
+    size_t size;
+    const gchar *value = (const gchar *)find_blob(cache, key, stamp, &size);
+    if (value)
+        mark_used(cache, key);
+    return value;
+}
+
+const gchar *get_from_cache(Cache *cache, const gchar *key, guint64 stamp)
+{
+    size_t size;
+    return (const gchar *)get_blob_from_cache(cache, key, stamp, &size);
+}
+
+void add_blob_to_cache(Cache *cache, const gchar *key, const void *value, size_t size, guint64 stamp)
 {
     if (!cache->_table)
         init_cache(cache);
 
-    if (!key || !value)
+    if (!key || !value || size > G_MAXUINT32)
         return;
 
-    gchar *old_value = g_hash_table_lookup(cache->_table, key);
-    if (old_value && g_str_equal(old_value, value))
+    size_t old_size;
+    const void *old_value = get_blob_from_cache(cache, key, stamp, &old_size);
+    if (old_value && old_size == size && memcmp(old_value, value, size) == 0)
         return;
 
-    g_hash_table_insert(cache->_table, g_strdup(key), g_strdup(value));
+    put_entry(cache->_table, key, value, size, stamp, current_time());
+    g_hash_table_add(cache->_pending, g_strdup(key));
+    mark_used(cache, key);
     cache->dirty = TRUE;
 }
+
+void add_to_cache(Cache *cache, const gchar *key, const gchar *value, guint64 stamp)
+{
+    if (value)
+        add_blob_to_cache(cache, key, value, strlen(value), stamp);
+}
+
+guint64 get_file_stamp(const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return 0;
+    gint64 values[3] = {(gint64)st.st_mtim.tv_sec, (gint64)st.st_mtim.tv_nsec, (gint64)st.st_size};
+    guint64 stamp = hash64(values, sizeof(values), 0);
+    return stamp ? stamp : 1;
+}
+
+TEST(cache_append_and_compact)
+{
+    gchar *path = g_strdup_printf("%s/tint2-test-cache-%d", g_get_tmp_dir(), (int)getpid());
+    unlink(path);
+
+    Cache cache;
+    memset(&cache, 0, sizeof(cache));
+    load_cache(&cache, path);
+    add_to_cache(&cache, "found", "/usr/share/icons/a.png", 1);
+    add_to_cache(&cache, "missing", "", 1);
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    // The first save compacts, so these entries come from the hash table
+    load_cache(&cache, path);
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "found", 1), "/usr/share/icons/a.png");
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "missing", 1), "");
+    ASSERT(get_from_cache(&cache, "found", 2) == NULL);
+    ASSERT(get_from_cache(&cache, "other", 1) == NULL);
+    guint64 stamp = 0;
+    ASSERT_STR_EQUAL(get_from_cache_with_stamp(&cache, "found", &stamp), "/usr/share/icons/a.png");
+    ASSERT(stamp == 1);
+    add_to_cache(&cache, "found", "/usr/share/icons/b.png", 2);
+    add_to_cache(&cache, "other", "/usr/share/pixmaps/c.xpm", 1);
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    // These are appended
+    load_cache(&cache, path);
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "found", 2), "/usr/share/icons/b.png");
+    ASSERT(get_from_cache(&cache, "found", 1) == NULL);
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "other", 1), "/usr/share/pixmaps/c.xpm");
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "missing", 1), "");
+    const char blob[] = {1, 0, 2, 0};
+    add_blob_to_cache(&cache, "blob", blob, sizeof(blob), 3);
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    load_cache(&cache, path);
+    size_t size = 0;
+    const char *value = get_blob_from_cache(&cache, "blob", 3, &size);
+    ASSERT(value && size == sizeof(blob) && memcmp(value, blob, sizeof(blob)) == 0);
+    free_cache(&cache);
+
+    unlink(path);
+    g_free(path);
+}
+
+static gboolean test_keep_unused(const gchar *key, guint64 stamp)
+{
+    return !g_str_has_prefix(key, "stale");
+}
+
+TEST(cache_eviction)
+{
+    gchar *path = g_strdup_printf("%s/tint2-test-cache-eviction-%d", g_get_tmp_dir(), (int)getpid());
+    unlink(path);
+    char value[1024];
+    memset(value, 'x', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+
+    Cache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.keep_unused = test_keep_unused;
+    load_cache(&cache, path);
+    add_to_cache(&cache, "stale", "a", 1);
+    add_to_cache(&cache, "fresh", "b", 1);
+    add_to_cache(&cache, "stale-used", "c", 1);
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    // Enough is appended to compact, which drops the unused entries rejected by keep_unused
+    load_cache(&cache, path);
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "stale-used", 1), "c");
+    for (int i = 0; i < 20; i++) {
+        gchar *key = g_strdup_printf("big%d", i);
+        add_to_cache(&cache, key, value, 1);
+        g_free(key);
+    }
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    load_cache(&cache, path);
+    ASSERT(get_from_cache(&cache, "stale", 1) == NULL);
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "fresh", 1), "b");
+    ASSERT_STR_EQUAL(get_from_cache(&cache, "stale-used", 1), "c");
+    free_cache(&cache);
+
+    // Exceeding the size limit compacts and evicts entries
+    cache.max_size = 8 * sizeof(value);
+    load_cache(&cache, path);
+    add_to_cache(&cache, "new", value, 1);
+    save_cache(&cache, path);
+    free_cache(&cache);
+
+    load_cache(&cache, path);
+    ASSERT(cache._size <= cache.max_size);
+    free_cache(&cache);
+
+    unlink(path);
+    g_free(path);
+}
@@ -3,12 +3,32 @@
 
 #include <glib.h>
 
-// A cache with string keys and values, backed by a file.
-// The strings must not be NULL and are stripped of any whitespace at start and end.
+// A cache with string keys and values, backed by a binary file.
+// The file holds a hash table that is mapped in memory and searched in place. Entries added later are
+// appended to the end of the file, and the file is rewritten (compacted) once enough of them accumulate.
+// Every entry carries a stamp chosen by the caller (e.g. derived from directory modification times);
+// lookups with a different stamp treat the entry as missing.
+// An empty value is a valid entry, e.g. to remember that a lookup found nothing.
 typedef struct Cache {
     gboolean dirty;
     gboolean loaded;
+    // Optional limits, applied when the file is compacted. Set them before loading; they are not reset.
+    // max_size: the total size in bytes of the entries; the least recently used entries are evicted first.
+    // 0 means no limit other than the range of the file offsets.
+    size_t max_size;
+    // keep_unused: called for the entries that have not been found or added since loading; those for which it
+    // returns FALSE are evicted. NULL keeps them.
+    gboolean (*keep_unused)(const gchar *key, guint64 stamp);
+    // The contents of the file at load time, mapped in memory
+    const unsigned char *_data;
+    size_t _size;
+    // Entries appended to the file after its last compaction, plus entries added since loading.
+    // Maps keys to CacheEntry*. Takes precedence over _data.
     GHashTable *_table;
+    // Keys added since the last save
+    GHashTable *_pending;
+    // Keys found or added since loading
+    GHashTable *_used;
 } Cache;
 
 // Initializes the cache. You can also call load_cache directly if you set the memory contents to zero first.
@@ -18,22 +38,36 @@ void init_cache(Cache *cache);
 // You can use init_cache or load_cache afterwards.
 void free_cache(Cache *cache);
 
-// Clears the cache contents and loads new contents from a file.
+// Clears the cache contents and maps the contents of a file.
 // Sets the loaded flag to TRUE.
 void load_cache(Cache *cache, const gchar *cache_path);
 
-// Saves the cache contents to a file.
+// Appends the entries added since the last save to the file, compacting it if needed.
 // Clears the dirty flag.
 void save_cache(Cache *cache, const gchar *cache_path);
 
-// Returns a pointer to the value in the cache, or NULL if not found.
-// Do not free the returned value!
-const gchar *get_from_cache(Cache *cache, const gchar *key);
+// Returns a pointer to the value in the cache, or NULL if not found or if the entry has a different stamp.
+// Do not free the returned value! It remains valid until the cache is freed or reloaded.
+const gchar *get_from_cache(Cache *cache, const gchar *key, guint64 stamp);
+
+// Like get_from_cache, but returns the value whatever the stamp of the entry, and stores that stamp in stamp.
+// For callers that derive the expected stamp from the value.
+const gchar *get_from_cache_with_stamp(Cache *cache, const gchar *key, guint64 *stamp);
 
 // Adds a key-value pair to the cache. NULL keys or values are not allowed.
-// If the key already exists, the old value is and replaced with the new value.
+// If the key already exists, the old value is replaced with the new value.
 // Does not take ownership of the pointers (neither key, nor value); instead it makes copies.
 // Sets the dirty flag to TRUE.
-void add_to_cache(Cache *cache, const gchar *key, const gchar *value);
+void add_to_cache(Cache *cache, const gchar *key, const gchar *value, guint64 stamp);
+
+// Like get_from_cache, for values that may contain null bytes. Stores the length of the value in size.
+const void *get_blob_from_cache(Cache *cache, const gchar *key, guint64 stamp, size_t *size);
+
+// Like add_to_cache, for values that may contain null bytes.
+void add_blob_to_cache(Cache *cache, const gchar *key, const void *value, size_t size, guint64 stamp);
+
+// Returns a stamp that changes when the file at path is modified (derived from its modification time and size),
+// or 0 if the file cannot be accessed.
+guint64 get_file_stamp(const char *path);
 
 #endif
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <glib.h>
 #include <glib/gstdio.h>
@@ -46,6 +47,12 @@
 
 #ifdef HAVE_RSVG
 #include <librsvg/rsvg.h>
+#ifndef LIBRSVG_CHECK_VERSION
+#define LIBRSVG_CHECK_VERSION(major, minor, micro) 0
+#endif
+#if !LIBRSVG_CHECK_VERSION(2, 36, 0)
+#include <librsvg/rsvg-cairo.h>
+#endif
 #endif
 
 #include "../panel.h"
@@ -788,50 +795,151 @@ void draw_text(PangoLayout *layout, cairo_t *c, int posx, int posy, Color *color
     pango_cairo_show_layout(c, layout);
 }
 
-Imlib_Image load_image(const char *path, int cached)
+DATA32 *argb_from_cairo_surface(cairo_surface_t *surface)
+{
+    cairo_surface_flush(surface);
+    int w = cairo_image_surface_get_width(surface);
+    int h = cairo_image_surface_get_height(surface);
+    gboolean has_alpha = cairo_image_surface_get_format(surface) == CAIRO_FORMAT_ARGB32;
+    const unsigned char *src = cairo_image_surface_get_data(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+    DATA32 *data = calloc((size_t)w * (size_t)h, sizeof(DATA32));
+    if (!data || !src)
+        return data;
+    // Cairo uses premultiplied alpha, Imlib2 does not
+    for (int y = 0; y < h; y++) {
+        const uint32_t *row = (const uint32_t *)(src + (size_t)y * stride);
+        DATA32 *out = data + (size_t)y * w;
+        for (int x = 0; x < w; x++) {
+            uint32_t pixel = row[x];
+            uint32_t a = has_alpha ? pixel >> 24 : 0xff;
+            if (a == 0) {
+                out[x] = 0;
+            } else if (a == 0xff) {
+                out[x] = pixel | 0xff000000;
+            } else {
+                uint32_t r = (((pixel >> 16) & 0xff) * 255 + a / 2) / a;
+                uint32_t g = (((pixel >> 8) & 0xff) * 255 + a / 2) / a;
+                uint32_t b = ((pixel & 0xff) * 255 + a / 2) / a;
+                out[x] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+    }
+    return data;
+}
+
+#ifdef HAVE_RSVG
+// Largest SVG rendering when the size comes from the file itself
+#define MAX_SVG_SIZE 1024
+
+DATA32 *render_svg(const char *path, int size, int *width, int *height)
+{
+    GError *err = NULL;
+    RsvgHandle *svg = rsvg_handle_new_from_file(path, &err);
+    if (!svg) {
+        fprintf(stderr, "tint2: Could not load svg image %s: %s\n", path, err ? err->message : "unknown error");
+        if (err)
+            g_error_free(err);
+        return NULL;
+    }
+
+    double svg_w = 0, svg_h = 0;
+#if LIBRSVG_CHECK_VERSION(2, 52, 0)
+    if (!rsvg_handle_get_intrinsic_size_in_pixels(svg, &svg_w, &svg_h)) {
+        gboolean has_viewbox;
+        RsvgRectangle viewbox;
+        rsvg_handle_get_intrinsic_dimensions(svg, NULL, NULL, NULL, NULL, &has_viewbox, &viewbox);
+        if (has_viewbox) {
+            svg_w = viewbox.width;
+            svg_h = viewbox.height;
+        }
+    }
+#else
+    RsvgDimensionData dimensions;
+    rsvg_handle_get_dimensions(svg, &dimensions);
+    svg_w = dimensions.width;
+    svg_h = dimensions.height;
+#endif
+    if (svg_w <= 0 || svg_h <= 0) {
+        fprintf(stderr, "tint2: Could not determine the size of svg image %s\n", path);
+        g_object_unref(svg);
+        return NULL;
+    }
+    int w = size, h = size;
+    if (size <= 0) {
+        // Large images are rendered scaled down, keeping the aspect ratio
+        double scale = MIN(1.0, MAX_SVG_SIZE / MAX(svg_w, svg_h));
+        w = MAX(1, (int)ceil(svg_w * scale));
+        h = MAX(1, (int)ceil(svg_h * scale));
+    }
+
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h);
+    cairo_t *c = cairo_create(surface);
+    gboolean ok;
+#if LIBRSVG_CHECK_VERSION(2, 52, 0)
+    RsvgRectangle viewport = {0, 0, w, h};
+    ok = rsvg_handle_render_document(svg, c, &viewport, &err);
+    if (err) {
+        fprintf(stderr, "tint2: Could not render svg image %s: %s\n", path, err->message);
+        g_error_free(err);
+    }
+#else
+    // Scale uniformly and center, like rsvg_handle_render_document does
+    double scale = MIN(w / svg_w, h / svg_h);
+    cairo_translate(c, (w - svg_w * scale) / 2, (h - svg_h * scale) / 2);
+    cairo_scale(c, scale, scale);
+    ok = rsvg_handle_render_cairo(svg, c);
+#endif
+    cairo_destroy(c);
+    g_object_unref(svg);
+
+    DATA32 *data = NULL;
+    if (ok && cairo_surface_status(surface) == CAIRO_STATUS_SUCCESS)
+        data = argb_from_cairo_surface(surface);
+    cairo_surface_destroy(surface);
+    if (!data)
+        return NULL;
+    *width = w;
+    *height = h;
+    return data;
+}
+#endif
+
+Imlib_Image load_image_at_size(const char *path, int cached, int size)
 {
     Imlib_Image image;
-    static unsigned long counter = 0;
     if (debug_icons)
         fprintf(stderr, "tint2: loading icon %s\n", path);
-    image = imlib_load_image(path);
 #ifdef HAVE_RSVG
-    if (!image && g_str_has_suffix(path, ".svg")) {
-        char tmp_filename[128];
-        snprintf(tmp_filename, sizeof(tmp_filename), "/tmp/tint2-%d-%lu.png", (int)getpid(), counter);
-        counter++;
-        int fd = open(tmp_filename, O_CREAT | O_EXCL, 0600);
-        if (fd >= 0) {
-            // We fork here because librsvg allocates memory like crazy
-            pid_t pid = fork();
-            if (pid == 0) {
-                // Child
-                GError *err = NULL;
-                RsvgHandle *svg = rsvg_handle_new_from_file(path, &err);
-
-                if (err != NULL) {
-                    fprintf(stderr, "tint2: Could not load svg image!: %s", err->message);
-                    g_error_free(err);
-                } else {
-                    GdkPixbuf *pixbuf = rsvg_handle_get_pixbuf(svg);
-                    gdk_pixbuf_save(pixbuf, tmp_filename, "png", NULL, NULL);
-                }
-                _exit(0);
-            } else {
-                // Parent
-                close(fd);
-                waitpid(pid, 0, 0);
-                image = imlib_load_image_immediately(tmp_filename);
-                unlink(tmp_filename);
+    // Render SVG files directly at the size they will be displayed, instead of rasterizing them at their
+    // nominal size and scaling the result
+    if (g_str_has_suffix(path, ".svg")) {
+        int w, h;
+        DATA32 *data = render_svg(path, size, &w, &h);
+        if (data) {
+            image = imlib_create_image_using_copied_data(w, h, data);
+            free(data);
+            if (image) {
+                imlib_context_set_image(image);
+                imlib_image_set_has_alpha(1);
+                return image;
             }
         }
     }
 #endif
-    imlib_context_set_image(image);
-    imlib_image_set_changes_on_disk();
+    image = imlib_load_image(path);
+    if (image) {
+        imlib_context_set_image(image);
+        imlib_image_set_changes_on_disk();
+    }
     return image;
 }
 
+Imlib_Image load_image(const char *path, int cached)
+{
+    return load_image_at_size(path, cached, 0);
+}
+
 Imlib_Image adjust_icon(Imlib_Image original, int alpha, int saturation, int brightness)
 {
     if (!original)
@@ -853,6 +961,35 @@ Imlib_Image adjust_icon(Imlib_Image original, int alpha, int saturation, int bri
     return copy;
 }
 
+Imlib_Image scale_and_adjust_icon(Imlib_Image original, int size, int alpha, int saturation, int brightness)
+{
+    if (!original)
+        return NULL;
+
+    imlib_context_set_image(original);
+    int w = imlib_image_get_width();
+    int h = imlib_image_get_height();
+    Imlib_Image icon;
+    if (size > 0)
+        icon = imlib_create_cropped_scaled_image(0, 0, w, h, size, size);
+    else
+        icon = imlib_clone_image();
+    if (!icon)
+        return NULL;
+
+    imlib_context_set_image(icon);
+    imlib_image_set_has_alpha(1);
+    DATA32 *data = imlib_image_get_data();
+    adjust_asb(data,
+               imlib_image_get_width(),
+               imlib_image_get_height(),
+               alpha / 100.0,
+               saturation / 100.0,
+               brightness / 100.0);
+    imlib_image_put_back_data(data);
+    return icon;
+}
+
 void draw_rect(cairo_t *c, double x, double y, double w, double h, double r)
 {
     draw_rect_on_sides(c, x, y, w, h, r, BORDER_ALL);
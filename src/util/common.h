@@ -90,6 +90,20 @@ void get_color(char *hex, double *rgb);
 
 Imlib_Image load_image(const char *path, int cached);
 
+// Like load_image, but renders SVG files at size x size pixels (or at their own size if size is 0).
+// Other formats are loaded at their original size.
+Imlib_Image load_image_at_size(const char *path, int cached, int size);
+
+// Returns the pixels of an image surface as non-premultiplied ARGB data, as used by Imlib2.
+// Does not use Imlib2, so it can be called from any thread. Free the result with free().
+DATA32 *argb_from_cairo_surface(cairo_surface_t *surface);
+
+#ifdef HAVE_RSVG
+// Renders an SVG file into size x size pixels (or at its own size if size is 0), as returned by
+// argb_from_cairo_surface. Can be called from any thread. Returns NULL on error.
+DATA32 *render_svg(const char *path, int size, int *width, int *height);
+#endif
+
 // Adjusts the alpha/saturation/brightness on an ARGB image.
 // Parameters:
 // * alpha_adjust: multiplicative:
@@ -106,6 +120,10 @@ Imlib_Image load_image(const char *path, int cached);
 //   *  1 = white
 void adjust_asb(DATA32 *data, int w, int h, float alpha_adjust, float satur_adjust, float bright_adjust);
 Imlib_Image adjust_icon(Imlib_Image original, int alpha, int saturation, int brightness);
+
+// Returns a copy of original scaled to size x size pixels (or at its original size if size is 0),
+// with the same adjustments as adjust_icon.
+Imlib_Image scale_and_adjust_icon(Imlib_Image original, int size, int alpha, int saturation, int brightness);
 void adjust_color(Color *color, int alpha, int saturation, int brightness);
 
 void create_heuristic_mask(DATA32 *data, int w, int h);
@@ -0,0 +1,348 @@
+/**************************************************************************
+*
+* Tint2 : area-average image downscaling
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "downscale.h"
+#include "test.h"
+#include "timer.h"
+
+// Filter weights are fixed-point numbers with this many fractional bits; the weights of a tap sum to 1.
+#define WEIGHT_BITS 16
+#define WEIGHT_ONE (1 << WEIGHT_BITS)
+// Number of bytes per row processed at a time in the vertical pass
+#define DOWNSCALE_BLOCK 512
+
+// Returns the byte offset within a pixel of the 8-bit channel selected by mask, or -1.
+static int channel_offset(unsigned long mask, int bytes_per_pixel, gboolean msb_first)
+{
+    for (int shift = 0; shift < 8 * bytes_per_pixel; shift += 8) {
+        if (mask == (0xffUL << shift))
+            return msb_first ? bytes_per_pixel - 1 - shift / 8 : shift / 8;
+    }
+    return -1;
+}
+
+gboolean downscale_source_set_format(DownscaleSource *src,
+                                     int bits_per_pixel,
+                                     gboolean msb_first,
+                                     unsigned long red_mask,
+                                     unsigned long green_mask,
+                                     unsigned long blue_mask)
+{
+    if (bits_per_pixel != 24 && bits_per_pixel != 32)
+        return FALSE;
+    src->bytes_per_pixel = bits_per_pixel / 8;
+    src->red_offset = channel_offset(red_mask, src->bytes_per_pixel, msb_first);
+    src->green_offset = channel_offset(green_mask, src->bytes_per_pixel, msb_first);
+    src->blue_offset = channel_offset(blue_mask, src->bytes_per_pixel, msb_first);
+    return src->red_offset >= 0 && src->green_offset >= 0 && src->blue_offset >= 0;
+}
+
+// The source pixels [first, first + count) contribute to a destination pixel with the given weights.
+typedef struct FilterTaps {
+    int *first;
+    int *count;
+    uint32_t *weights;
+    int max_taps;
+} FilterTaps;
+
+// Destination pixel i covers the source interval [i * src_size / dst_size, (i + 1) * src_size / dst_size).
+// Each source pixel is weighted by how much of it lies inside that interval.
+static void filter_taps_init(FilterTaps *taps, int src_size, int dst_size)
+{
+    taps->max_taps = src_size / dst_size + 2;
+    taps->first = calloc((size_t)dst_size, sizeof(int));
+    taps->count = calloc((size_t)dst_size, sizeof(int));
+    taps->weights = calloc((size_t)dst_size * (size_t)taps->max_taps, sizeof(uint32_t));
+    for (int i = 0; i < dst_size; i++) {
+        // Work in units of 1 / dst_size source pixels to keep everything integral
+        int64_t begin = (int64_t)i * src_size;
+        int64_t end = begin + src_size;
+        int first = (int)(begin / dst_size);
+        int last = (int)MIN((end - 1) / dst_size, src_size - 1);
+        uint32_t *weights = &taps->weights[i * taps->max_taps];
+        uint32_t total = 0;
+        for (int k = first; k <= last; k++) {
+            int64_t overlap = MIN(end, (int64_t)(k + 1) * dst_size) - MAX(begin, (int64_t)k * dst_size);
+            weights[k - first] = (uint32_t)(overlap * WEIGHT_ONE / src_size);
+            total += weights[k - first];
+        }
+        // Add the rounding error to the larger of the two edge weights, so that the weights sum to exactly 1
+        // and all the inner source pixels (which are fully covered) keep the same weight
+        int edge = weights[last - first] > weights[0] ? last - first : 0;
+        weights[edge] += WEIGHT_ONE - total;
+        taps->first[i] = first;
+        taps->count[i] = last - first + 1;
+    }
+}
+
+static void filter_taps_free(FilterTaps *taps)
+{
+    free(taps->first);
+    free(taps->count);
+    free(taps->weights);
+}
+
+void downscale_area_average(const DownscaleSource *src, uint32_t *dst, int dst_stride, int dst_width, int dst_height)
+{
+    if (src->width <= 0 || src->height <= 0 || dst_width <= 0 || dst_height <= 0)
+        return;
+    FilterTaps xtaps, ytaps;
+    filter_taps_init(&xtaps, src->width, dst_width);
+    filter_taps_init(&ytaps, src->height, dst_height);
+
+    const int bpp = src->bytes_per_pixel;
+    const size_t row_bytes = (size_t)src->width * (size_t)bpp;
+    // Weighted sum of source rows, one element per byte (channels stay interleaved)
+    uint32_t *row_sum = calloc(row_bytes, sizeof(uint32_t));
+
+    for (int yt = 0; yt < dst_height; yt++) {
+        // Vertical pass. The inner rows all have the same weight, so they are summed first with plain additions
+        // over contiguous bytes, which the compiler can vectorize; the two edge rows are weighted separately.
+        // The rows are processed in blocks, so that the partial sums stay in the L1 cache.
+        const uint32_t *wy = &ytaps.weights[yt * ytaps.max_taps];
+        const int count = ytaps.count[yt];
+        const uint32_t w_first = wy[0];
+        const uint32_t w_last = count > 1 ? wy[count - 1] : 0;
+        const uint32_t w_inner = count > 2 ? wy[1] : 0;
+        const unsigned char *first_row = src->data + (size_t)ytaps.first[yt] * (size_t)src->bytes_per_line;
+        const unsigned char *last_row = first_row + (size_t)(count - 1) * (size_t)src->bytes_per_line;
+        for (size_t block = 0; block < row_bytes; block += DOWNSCALE_BLOCK) {
+            const size_t n = MIN(DOWNSCALE_BLOCK, row_bytes - block);
+            uint32_t inner[DOWNSCALE_BLOCK] = {0};
+            for (int k = 1; k < count - 1; k++) {
+                const unsigned char *row = first_row + (size_t)k * (size_t)src->bytes_per_line + block;
+                for (size_t i = 0; i < n; i++)
+                    inner[i] += row[i];
+            }
+            uint32_t sum[DOWNSCALE_BLOCK];
+            for (size_t i = 0; i < n; i++)
+                sum[i] = w_first * first_row[block + i] + w_last * last_row[block + i] + w_inner * inner[i];
+            // Drop 8 fractional bits so that the horizontal pass fits in 32 bits
+            for (size_t i = 0; i < n; i++)
+                row_sum[block + i] = sum[i] >> 8;
+        }
+
+        // Horizontal pass, picking the channels out of the interleaved sums
+        const uint32_t *r_sum = row_sum + src->red_offset;
+        const uint32_t *g_sum = row_sum + src->green_offset;
+        const uint32_t *b_sum = row_sum + src->blue_offset;
+        uint32_t *out = dst + (size_t)yt * (size_t)dst_stride;
+        for (int xt = 0; xt < dst_width; xt++) {
+            const uint32_t *wx = &xtaps.weights[xt * xtaps.max_taps];
+            size_t j = (size_t)xtaps.first[xt] * (size_t)bpp;
+            uint32_t r = 1 << (2 * WEIGHT_BITS - 8 - 1);
+            uint32_t g = r;
+            uint32_t b = r;
+            for (int k = 0; k < xtaps.count[xt]; k++, j += (size_t)bpp) {
+                r += wx[k] * r_sum[j];
+                g += wx[k] * g_sum[j];
+                b += wx[k] * b_sum[j];
+            }
+            r >>= 2 * WEIGHT_BITS - 8;
+            g >>= 2 * WEIGHT_BITS - 8;
+            b >>= 2 * WEIGHT_BITS - 8;
+            out[xt] = 0xff000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    free(row_sum);
+    filter_taps_free(&xtaps);
+    filter_taps_free(&ytaps);
+}
+
+// Deterministic test pattern: smooth gradients, sharp edges, fine text-like detail and noise
+static unsigned char *make_test_image(int w, int h)
+{
+    unsigned char *data = calloc((size_t)w * (size_t)h, 4);
+    uint32_t seed = 12345;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            unsigned char *p = &data[((size_t)y * w + x) * 4];
+            seed = seed * 1103515245 + 12345;
+            int noise = (int)((seed >> 16) & 0x1f) - 16;
+            int text = ((x / 2 + y / 3) % 7 == 0 && (y / 16) % 2 == 0) ? -120 : 0;
+            int edge = (x * 4 / w + y * 3 / h) % 2 ? 60 : 0;
+            p[0] = (unsigned char)CLAMP(x * 255 / w + noise + text, 0, 255);
+            p[1] = (unsigned char)CLAMP(y * 255 / h + edge + text, 0, 255);
+            p[2] = (unsigned char)CLAMP(((x ^ y) & 0xff) / 2 + edge + noise, 0, 255);
+            p[3] = 0;
+        }
+    }
+    return data;
+}
+
+// Exact box filter in floating point, used as the reference
+static double *reference_downscale(const unsigned char *data, int w, int h, int tw, int th)
+{
+    double *result = calloc((size_t)tw * (size_t)th * 3, sizeof(double));
+    for (int yt = 0; yt < th; yt++) {
+        double y0 = (double)yt * h / th, y1 = (double)(yt + 1) * h / th;
+        for (int xt = 0; xt < tw; xt++) {
+            double x0 = (double)xt * w / tw, x1 = (double)(xt + 1) * w / tw;
+            double sum[3] = {0, 0, 0};
+            for (int y = (int)y0; y < h && y < y1; y++) {
+                double wy = MIN(y1, y + 1) - MAX(y0, y);
+                for (int x = (int)x0; x < w && x < x1; x++) {
+                    double wx = MIN(x1, x + 1) - MAX(x0, x);
+                    const unsigned char *p = &data[((size_t)y * w + x) * 4];
+                    for (int c = 0; c < 3; c++)
+                        sum[c] += wx * wy * p[c];
+                }
+            }
+            for (int c = 0; c < 3; c++)
+                result[((size_t)yt * tw + xt) * 3 + c] = sum[c] / ((x1 - x0) * (y1 - y0));
+        }
+    }
+    return result;
+}
+
+// The 7-point sampler plus smoothing pass that was used for thumbnails before, for comparison
+static void legacy_downscale(const unsigned char *data, int w, int h, uint32_t *out, int tw, int th)
+{
+    const size_t prec = 1 << 16;
+    const size_t xstep = (size_t)w * prec / (size_t)tw;
+    const size_t ystep = (size_t)h * prec / (size_t)th;
+    const size_t ox[7] = {3, 6, 2, 4, 7, 1, 6};
+    const size_t oy[7] = {0, 1, 4, 4, 4, 6, 7};
+    const uint32_t *pixels = (const uint32_t *)data;
+    for (size_t yt = 0, y = 0; yt < (size_t)th; yt++, y += ystep) {
+        for (size_t xt = 0, x = 0; xt < (size_t)tw; xt++, x += xstep) {
+            uint32_t sum[3] = {0, 0, 0};
+            for (int k = 0; k < 7; k++) {
+                uint32_t c = pixels[(y + oy[k] * ystep / 8) / prec * (size_t)w + (x + ox[k] * xstep / 8) / prec];
+                for (int ch = 0; ch < 3; ch++)
+                    sum[ch] += ((c >> (8 * ch)) & 0xff) * (k == 4 ? 2 : 1);
+            }
+            out[yt * (size_t)tw + xt] = (sum[2] / 8) << 16 | (sum[1] / 8) << 8 | sum[0] / 8;
+        }
+    }
+    for (size_t i = 0; i < (size_t)tw * (th - 1) - 1; i++) {
+        uint32_t sum[3] = {0, 0, 0};
+        uint32_t c[4] = {out[i], out[i + 1], out[i + tw], out[i + tw + 1]};
+        for (int k = 0; k < 4; k++)
+            for (int ch = 0; ch < 3; ch++)
+                sum[ch] += ((c[k] >> (8 * ch)) & 0xff) * (k == 0 ? 5 : 1);
+        out[i] = (sum[2] / 8) << 16 | (sum[1] / 8) << 8 | sum[0] / 8;
+    }
+}
+
+// PSNR of the RGB channels of an ARGB32 image against the reference, in dB
+static double psnr(const double *reference, const uint32_t *image, int tw, int th)
+{
+    double error = 0;
+    for (size_t i = 0; i < (size_t)tw * (size_t)th; i++) {
+        for (int c = 0; c < 3; c++) {
+            double d = reference[i * 3 + c] - ((image[i] >> (8 * c)) & 0xff);
+            error += d * d;
+        }
+    }
+    error /= (double)tw * th * 3;
+    return error > 0 ? 10 * log10(255.0 * 255.0 / error) : 100;
+}
+
+TEST(downscale_flat_image)
+{
+    // BGR24 layout, 3 bytes per pixel
+    const int w = 101, h = 37;
+    unsigned char *data = calloc((size_t)w * h, 3);
+    for (int i = 0; i < w * h; i++) {
+        data[i * 3 + 0] = 0x56;
+        data[i * 3 + 1] = 0x34;
+        data[i * 3 + 2] = 0x12;
+    }
+    DownscaleSource src = {.data = data, .width = w, .height = h, .bytes_per_line = w * 3};
+    ASSERT_TRUE(downscale_source_set_format(&src, 24, FALSE, 0xff, 0xff00, 0xff0000));
+    uint32_t out[13 * 5];
+    downscale_area_average(&src, out, 13, 13, 5);
+    for (int i = 0; i < 13 * 5; i++) {
+        ASSERT_EQUAL(out[i], 0xff563412);
+    }
+    free(data);
+}
+
+TEST(downscale_pixel_formats)
+{
+    DownscaleSource src;
+    // RGB24 in a 32-bit pixel, as sent by most X servers
+    ASSERT_TRUE(downscale_source_set_format(&src, 32, FALSE, 0xff0000, 0xff00, 0xff));
+    ASSERT_EQUAL(src.red_offset, 2);
+    ASSERT_EQUAL(src.blue_offset, 0);
+    ASSERT_TRUE(downscale_source_set_format(&src, 32, TRUE, 0xff0000, 0xff00, 0xff));
+    ASSERT_EQUAL(src.red_offset, 1);
+    ASSERT_EQUAL(src.blue_offset, 3);
+    // BGRA32
+    ASSERT_TRUE(downscale_source_set_format(&src, 32, FALSE, 0xff00, 0xff0000, 0xff000000));
+    ASSERT_EQUAL(src.red_offset, 1);
+    ASSERT_EQUAL(src.blue_offset, 3);
+    // RGB565 is not supported
+    ASSERT_FALSE(downscale_source_set_format(&src, 16, FALSE, 0xf800, 0x7e0, 0x1f));
+}
+
+// Compares the quality of the downscaling against the exact box filter and the previous sampler
+static void downscale_compare(int w, int h, int tw, int iterations, double *area_psnr, double *legacy_psnr)
+{
+    const int th = h * tw / w;
+    unsigned char *data = make_test_image(w, h);
+    double *reference = reference_downscale(data, w, h, tw, th);
+    uint32_t *out = calloc((size_t)tw * th, sizeof(uint32_t));
+    uint32_t *legacy = calloc((size_t)tw * th, sizeof(uint32_t));
+
+    DownscaleSource src = {.data = data, .width = w, .height = h, .bytes_per_line = w * 4};
+    downscale_source_set_format(&src, 32, FALSE, 0xff0000, 0xff00, 0xff);
+    double start = get_time();
+    for (int i = 0; i < iterations; i++)
+        downscale_area_average(&src, out, tw, tw, th);
+    double area_ms = 1000 * (get_time() - start) / iterations;
+    start = get_time();
+    for (int i = 0; i < iterations; i++)
+        legacy_downscale(data, w, h, legacy, tw, th);
+    double legacy_ms = 1000 * (get_time() - start) / iterations;
+
+    *area_psnr = psnr(reference, out, tw, th);
+    *legacy_psnr = psnr(reference, legacy, tw, th);
+    printf("%4d x %4d -> %d x %d: area average %.2f ms, %.1f dB; 7-point sampler %.2f ms, %.1f dB\n",
+           w, h, tw, th, area_ms, *area_psnr, legacy_ms, *legacy_psnr);
+
+    free(data);
+    free(reference);
+    free(out);
+    free(legacy);
+}
+
+TEST(downscale_quality)
+{
+    double area_psnr, legacy_psnr;
+    downscale_compare(320, 180, 64, 1, &area_psnr, &legacy_psnr);
+    ASSERT(area_psnr > 45);
+    ASSERT(area_psnr > legacy_psnr);
+}
+
+BENCHMARK(downscale)
+{
+    const int sizes[][2] = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double area_psnr, legacy_psnr;
+        downscale_compare(sizes[s][0], sizes[s][1], 210, 10, &area_psnr, &legacy_psnr);
+        ASSERT(area_psnr > 45);
+        ASSERT(area_psnr > legacy_psnr);
+    }
+}
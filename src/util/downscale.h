@@ -0,0 +1,35 @@
+#ifndef DOWNSCALE_H
+#define DOWNSCALE_H
+
+#include <glib.h>
+#include <stdint.h>
+
+// A packed 24 or 32 bits per pixel image with 8-bit color channels, e.g. the contents of an XImage.
+typedef struct DownscaleSource {
+    const unsigned char *data;
+    int width;
+    int height;
+    int bytes_per_line;
+    int bytes_per_pixel;
+    // Byte offsets of the channels within a pixel
+    int red_offset;
+    int green_offset;
+    int blue_offset;
+} DownscaleSource;
+
+// Computes the channel offsets of src from the pixel format of an XImage.
+// Handles RGB24, BGR24 and BGRA32 style layouts in either byte order.
+// Returns FALSE if the channels are not byte-aligned 8-bit values.
+gboolean downscale_source_set_format(DownscaleSource *src,
+                                     int bits_per_pixel,
+                                     gboolean msb_first,
+                                     unsigned long red_mask,
+                                     unsigned long green_mask,
+                                     unsigned long blue_mask);
+
+// Resizes src to dst_width x dst_height by averaging the source area covered by each destination pixel
+// (box filter with fractional coverage). The filter is applied separably: rows first, then columns.
+// Writes opaque ARGB32 pixels; dst_stride is in pixels.
+void downscale_area_average(const DownscaleSource *src, uint32_t *dst, int dst_stride, int dst_width, int dst_height);
+
+#endif
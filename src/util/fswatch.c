@@ -0,0 +1,305 @@
+/**************************************************************************
+*
+* Tint2 : file change notifications (inotify)
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#ifdef ENABLE_INOTIFY
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "fswatch.h"
+#include "timer.h"
+
+// The callbacks are called once no event has been received for this long...
+#define FSWATCH_QUIET_MS 300
+// ...but no later than this after the first event, even if the events keep coming.
+#define FSWATCH_MAX_DELAY_MS 3000
+
+#define FSWATCH_MASK                                                                                        \
+    (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB | IN_DELETE_SELF | \
+     IN_MOVE_SELF | IN_ONLYDIR)
+
+typedef struct FsWatchSubscriber {
+    FsWatchCallback *callback;
+    void *userdata;
+    // Distinguishes a subscriber from one removed and added again with the same callback and userdata
+    guint serial;
+} FsWatchSubscriber;
+
+typedef struct FsWatchDir {
+    char *path;
+    // -1 if the directory is not watched anymore (e.g. it was deleted)
+    int wd;
+    // FsWatchSubscriber*
+    GList *subscribers;
+    // Names of the entries that changed since the last notification (gchar* keys), or NULL
+    GHashTable *changed;
+    // Events were lost, anything may have changed
+    gboolean overflow;
+} FsWatchDir;
+
+static int inotify_fd = -1;
+// FsWatchDir*
+static GList *watched_dirs;
+static guint last_serial;
+static Timer fswatch_timer;
+// Time of the first event that has not been notified yet, or 0
+static double first_pending_event;
+
+static void fswatch_flush(void *arg);
+
+static FsWatchDir *find_dir_by_path(const char *path)
+{
+    for (GList *l = watched_dirs; l; l = l->next) {
+        FsWatchDir *dir = (FsWatchDir *)l->data;
+        if (g_str_equal(dir->path, path))
+            return dir;
+    }
+    return NULL;
+}
+
+static FsWatchDir *find_dir_by_wd(int wd)
+{
+    for (GList *l = watched_dirs; l; l = l->next) {
+        FsWatchDir *dir = (FsWatchDir *)l->data;
+        if (dir->wd == wd)
+            return dir;
+    }
+    return NULL;
+}
+
+static FsWatchSubscriber *find_subscriber(FsWatchDir *dir, FsWatchCallback *callback, void *userdata)
+{
+    for (GList *l = dir->subscribers; l; l = l->next) {
+        FsWatchSubscriber *subscriber = (FsWatchSubscriber *)l->data;
+        if (subscriber->callback == callback && subscriber->userdata == userdata)
+            return subscriber;
+    }
+    return NULL;
+}
+
+static void free_dir(FsWatchDir *dir)
+{
+    if (dir->wd >= 0 && inotify_fd >= 0)
+        inotify_rm_watch(inotify_fd, dir->wd);
+    g_list_free_full(dir->subscribers, free);
+    if (dir->changed)
+        g_hash_table_destroy(dir->changed);
+    free(dir->path);
+    free(dir);
+}
+
+static gboolean fswatch_init()
+{
+    if (inotify_fd >= 0)
+        return TRUE;
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        fprintf(stderr, "tint2: inotify_init1 failed: %s\n", strerror(errno));
+        return FALSE;
+    }
+    INIT_TIMER(fswatch_timer);
+    first_pending_event = 0;
+    return TRUE;
+}
+
+gboolean fswatch_add(const char *path, FsWatchCallback *callback, void *userdata)
+{
+    if (!path || !callback || !fswatch_init())
+        return FALSE;
+
+    FsWatchDir *dir = find_dir_by_path(path);
+    if (!dir || dir->wd < 0) {
+        int wd = inotify_add_watch(inotify_fd, path, FSWATCH_MASK);
+        if (wd < 0)
+            return FALSE;
+        if (!dir) {
+            // Another path to the same directory (e.g. through a symlink) gets the same watch
+            dir = find_dir_by_wd(wd);
+        }
+        if (!dir) {
+            dir = (FsWatchDir *)calloc(1, sizeof(FsWatchDir));
+            dir->path = strdup(path);
+            watched_dirs = g_list_append(watched_dirs, dir);
+        }
+        dir->wd = wd;
+    }
+
+    if (!find_subscriber(dir, callback, userdata)) {
+        FsWatchSubscriber *subscriber = (FsWatchSubscriber *)calloc(1, sizeof(FsWatchSubscriber));
+        subscriber->callback = callback;
+        subscriber->userdata = userdata;
+        subscriber->serial = ++last_serial;
+        dir->subscribers = g_list_append(dir->subscribers, subscriber);
+    }
+    return TRUE;
+}
+
+void fswatch_remove(FsWatchCallback *callback, void *userdata)
+{
+    for (GList *l = watched_dirs; l;) {
+        FsWatchDir *dir = (FsWatchDir *)l->data;
+        GList *next = l->next;
+        FsWatchSubscriber *subscriber = find_subscriber(dir, callback, userdata);
+        if (subscriber) {
+            dir->subscribers = g_list_remove(dir->subscribers, subscriber);
+            free(subscriber);
+            if (!dir->subscribers) {
+                watched_dirs = g_list_delete_link(watched_dirs, l);
+                free_dir(dir);
+            }
+        }
+        l = next;
+    }
+}
+
+int fswatch_fd()
+{
+    return inotify_fd;
+}
+
+static void mark_changed(FsWatchDir *dir, const char *name, gboolean overflow)
+{
+    if (overflow || !name || !*name) {
+        dir->overflow = TRUE;
+    } else if (!dir->overflow) {
+        if (!dir->changed)
+            dir->changed = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        if (!g_hash_table_contains(dir->changed, name))
+            g_hash_table_add(dir->changed, g_strdup(name));
+    }
+}
+
+static void schedule_flush()
+{
+    double now = get_time();
+    if (!first_pending_event)
+        first_pending_event = now;
+    int remaining_ms = FSWATCH_MAX_DELAY_MS - (int)((now - first_pending_event) * 1000);
+    int delay_ms = MAX(0, MIN(FSWATCH_QUIET_MS, remaining_ms));
+    change_timer(&fswatch_timer, true, delay_ms, 0, fswatch_flush, NULL);
+}
+
+void handle_fswatch_events()
+{
+    if (inotify_fd < 0)
+        return;
+    gboolean changed = FALSE;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (1) {
+        ssize_t len = read(inotify_fd, buffer, sizeof(buffer));
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0)
+            break;
+        for (char *p = buffer; p < buffer + len;) {
+            struct inotify_event *event = (struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (GList *l = watched_dirs; l; l = l->next)
+                    mark_changed((FsWatchDir *)l->data, NULL, TRUE);
+                changed = TRUE;
+                continue;
+            }
+            FsWatchDir *dir = find_dir_by_wd(event->wd);
+            if (!dir)
+                continue;
+            if (event->mask & IN_IGNORED) {
+                // The kernel dropped the watch (the directory was deleted or unmounted)
+                dir->wd = -1;
+                mark_changed(dir, NULL, TRUE);
+            } else {
+                mark_changed(dir,
+                             event->len > 0 ? event->name : NULL,
+                             (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0);
+            }
+            changed = TRUE;
+        }
+    }
+    if (changed)
+        schedule_flush();
+}
+
+typedef struct FsWatchDelivery {
+    char *path;
+    GHashTable *changed;
+    gboolean overflow;
+    // Copies of the subscribers at the time of the flush
+    GList *subscribers;
+} FsWatchDelivery;
+
+static void fswatch_flush(void *arg)
+{
+    first_pending_event = 0;
+
+    // The callbacks may add or remove watches, so take everything out of watched_dirs first
+    GList *deliveries = NULL;
+    for (GList *l = watched_dirs; l; l = l->next) {
+        FsWatchDir *dir = (FsWatchDir *)l->data;
+        if (!dir->changed && !dir->overflow)
+            continue;
+        FsWatchDelivery *delivery = (FsWatchDelivery *)calloc(1, sizeof(FsWatchDelivery));
+        delivery->path = strdup(dir->path);
+        delivery->changed = dir->changed;
+        delivery->overflow = dir->overflow;
+        for (GList *s = dir->subscribers; s; s = s->next) {
+            FsWatchSubscriber *copy = (FsWatchSubscriber *)calloc(1, sizeof(FsWatchSubscriber));
+            *copy = *(FsWatchSubscriber *)s->data;
+            delivery->subscribers = g_list_append(delivery->subscribers, copy);
+        }
+        deliveries = g_list_append(deliveries, delivery);
+        dir->changed = NULL;
+        dir->overflow = FALSE;
+    }
+
+    for (GList *l = deliveries; l; l = l->next) {
+        FsWatchDelivery *delivery = (FsWatchDelivery *)l->data;
+        for (GList *s = delivery->subscribers; s; s = s->next) {
+            FsWatchSubscriber *subscriber = (FsWatchSubscriber *)s->data;
+            // Skip the subscribers removed by an earlier callback (even if they were added again, since the
+            // callback that did that has already handled the changes)
+            FsWatchDir *dir = find_dir_by_path(delivery->path);
+            FsWatchSubscriber *current = dir ? find_subscriber(dir, subscriber->callback, subscriber->userdata) : NULL;
+            if (!current || current->serial != subscriber->serial)
+                continue;
+            subscriber->callback(delivery->path, delivery->overflow ? NULL : delivery->changed, subscriber->userdata);
+        }
+        g_list_free_full(delivery->subscribers, free);
+        if (delivery->changed)
+            g_hash_table_destroy(delivery->changed);
+        free(delivery->path);
+        free(delivery);
+    }
+    g_list_free(deliveries);
+}
+
+void fswatch_cleanup()
+{
+    if (inotify_fd < 0)
+        return;
+    g_list_free_full(watched_dirs, (GDestroyNotify)free_dir);
+    watched_dirs = NULL;
+    destroy_timer(&fswatch_timer);
+    close(inotify_fd);
+    inotify_fd = -1;
+}
+
+#endif
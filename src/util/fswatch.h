@@ -0,0 +1,71 @@
+/**************************************************************************
+*
+* Tint2 : file change notifications (inotify)
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#ifndef FSWATCH_H
+#define FSWATCH_H
+
+#include <glib.h>
+
+// Called from the main loop after the contents of a watched directory changed.
+// names is the set of the entries of dir that changed (keys are gchar*), or NULL if the events were lost
+// and anything in dir may have changed. Bursts of events are coalesced into a single call.
+typedef void FsWatchCallback(const char *dir, GHashTable *names, void *userdata);
+
+#ifdef ENABLE_INOTIFY
+
+// Watches the directory dir (not recursively). Returns FALSE if it cannot be watched.
+// Adding the same (dir, callback, userdata) again has no effect.
+gboolean fswatch_add(const char *dir, FsWatchCallback *callback, void *userdata);
+
+// Removes all the watches of (callback, userdata). Must be called before userdata is freed.
+void fswatch_remove(FsWatchCallback *callback, void *userdata);
+
+// File descriptor that becomes readable when there are events, or -1.
+int fswatch_fd();
+
+// Reads the pending events. The callbacks are called later, once the directories are quiet.
+void handle_fswatch_events();
+
+void fswatch_cleanup();
+
+#else
+
+static inline gboolean fswatch_add(const char *dir, FsWatchCallback *callback, void *userdata)
+{
+    return FALSE;
+}
+
+static inline void fswatch_remove(FsWatchCallback *callback, void *userdata)
+{
+}
+
+static inline int fswatch_fd()
+{
+    return -1;
+}
+
+static inline void handle_fswatch_events()
+{
+}
+
+static inline void fswatch_cleanup()
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fast non-cryptographic 64-bit hash of a buffer (XXH64).
+// Suitable for detecting content changes, not for security purposes.
+uint64_t hash64(const void *data, size_t len, uint64_t seed);
+
+#endif
@@ -23,6 +23,7 @@
 #include <X11/extensions/Xrender.h>
 
 #include <fcntl.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,90 +42,109 @@ int server_catch_error(Display *d, XErrorEvent *ev)
     return 0;
 }
 
+typedef struct AtomName {
+    const char *name;
+    size_t offset;
+} AtomName;
+
+#define ATOM(field) {#field, offsetof(Global_atom, field)}
+
+// The atoms of server.atom, except the ones whose names depend on the screen
+static const AtomName atom_names[] = {
+    ATOM(_XROOTPMAP_ID),
+    ATOM(_XROOTMAP_ID),
+    ATOM(_NET_CURRENT_DESKTOP),
+    ATOM(_NET_NUMBER_OF_DESKTOPS),
+    ATOM(_NET_DESKTOP_NAMES),
+    ATOM(_NET_DESKTOP_GEOMETRY),
+    ATOM(_NET_DESKTOP_VIEWPORT),
+    ATOM(_NET_WORKAREA),
+    ATOM(_NET_ACTIVE_WINDOW),
+    ATOM(_NET_WM_WINDOW_TYPE),
+    ATOM(_NET_WM_STATE_SKIP_PAGER),
+    ATOM(_NET_WM_STATE_SKIP_TASKBAR),
+    ATOM(_NET_WM_STATE_STICKY),
+    ATOM(_NET_WM_STATE_DEMANDS_ATTENTION),
+    ATOM(_NET_WM_WINDOW_TYPE_DOCK),
+    ATOM(_NET_WM_WINDOW_TYPE_DESKTOP),
+    ATOM(_NET_WM_WINDOW_TYPE_TOOLBAR),
+    ATOM(_NET_WM_WINDOW_TYPE_MENU),
+    ATOM(_NET_WM_WINDOW_TYPE_SPLASH),
+    ATOM(_NET_WM_WINDOW_TYPE_DIALOG),
+    ATOM(_NET_WM_WINDOW_TYPE_NORMAL),
+    ATOM(_NET_WM_DESKTOP),
+    ATOM(WM_STATE),
+    ATOM(_NET_WM_STATE),
+    ATOM(_NET_WM_STATE_MAXIMIZED_VERT),
+    ATOM(_NET_WM_STATE_MAXIMIZED_HORZ),
+    ATOM(_NET_WM_STATE_SHADED),
+    ATOM(_NET_WM_STATE_HIDDEN),
+    ATOM(_NET_WM_STATE_BELOW),
+    ATOM(_NET_WM_STATE_ABOVE),
+    ATOM(_NET_WM_STATE_MODAL),
+    ATOM(_NET_CLIENT_LIST),
+    ATOM(_NET_WM_VISIBLE_NAME),
+    ATOM(_NET_WM_NAME),
+    ATOM(_NET_WM_STRUT),
+    ATOM(_NET_WM_ICON),
+    ATOM(_NET_WM_ICON_GEOMETRY),
+    ATOM(_NET_WM_ICON_NAME),
+    ATOM(_NET_CLOSE_WINDOW),
+    ATOM(UTF8_STRING),
+    ATOM(_NET_SUPPORTING_WM_CHECK),
+    ATOM(_NET_WM_CM_S0),
+    ATOM(_NET_WM_STRUT_PARTIAL),
+    ATOM(WM_NAME),
+    ATOM(__SWM_VROOT),
+    ATOM(_MOTIF_WM_HINTS),
+    ATOM(WM_HINTS),
+    ATOM(_XSETTINGS_SETTINGS),
+    ATOM(_NET_SYSTEM_TRAY_OPCODE),
+    ATOM(MANAGER),
+    ATOM(_NET_SYSTEM_TRAY_MESSAGE_DATA),
+    ATOM(_NET_SYSTEM_TRAY_ORIENTATION),
+    ATOM(_NET_SYSTEM_TRAY_ICON_SIZE),
+    ATOM(_NET_SYSTEM_TRAY_PADDING),
+    ATOM(_NET_SYSTEM_TRAY_VISUAL),
+    ATOM(_XEMBED),
+    ATOM(_XEMBED_INFO),
+    ATOM(_NET_WM_PID),
+    ATOM(XdndAware),
+    ATOM(XdndEnter),
+    ATOM(XdndPosition),
+    ATOM(XdndStatus),
+    ATOM(XdndDrop),
+    ATOM(XdndLeave),
+    ATOM(XdndSelection),
+    ATOM(XdndTypeList),
+    ATOM(XdndActionCopy),
+    ATOM(XdndFinished),
+    ATOM(TARGETS),
+    {"_TINT2_REFRESH_EXECP", offsetof(Global_atom, TINT2_REFRESH_EXECP)}
+};
+
+#undef ATOM
+
 void server_init_atoms()
 {
-    server.atom._XROOTPMAP_ID = XInternAtom(server.display, "_XROOTPMAP_ID", False);
-    server.atom._XROOTMAP_ID = XInternAtom(server.display, "_XROOTMAP_ID", False);
-    server.atom._NET_CURRENT_DESKTOP = XInternAtom(server.display, "_NET_CURRENT_DESKTOP", False);
-    server.atom._NET_NUMBER_OF_DESKTOPS = XInternAtom(server.display, "_NET_NUMBER_OF_DESKTOPS", False);
-    server.atom._NET_DESKTOP_NAMES = XInternAtom(server.display, "_NET_DESKTOP_NAMES", False);
-    server.atom._NET_DESKTOP_GEOMETRY = XInternAtom(server.display, "_NET_DESKTOP_GEOMETRY", False);
-    server.atom._NET_DESKTOP_VIEWPORT = XInternAtom(server.display, "_NET_DESKTOP_VIEWPORT", False);
-    server.atom._NET_WORKAREA = XInternAtom(server.display, "_NET_WORKAREA", False);
-    server.atom._NET_ACTIVE_WINDOW = XInternAtom(server.display, "_NET_ACTIVE_WINDOW", False);
-    server.atom._NET_WM_WINDOW_TYPE = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE", False);
-    server.atom._NET_WM_STATE_SKIP_PAGER = XInternAtom(server.display, "_NET_WM_STATE_SKIP_PAGER", False);
-    server.atom._NET_WM_STATE_SKIP_TASKBAR = XInternAtom(server.display, "_NET_WM_STATE_SKIP_TASKBAR", False);
-    server.atom._NET_WM_STATE_STICKY = XInternAtom(server.display, "_NET_WM_STATE_STICKY", False);
-    server.atom._NET_WM_STATE_DEMANDS_ATTENTION = XInternAtom(server.display, "_NET_WM_STATE_DEMANDS_ATTENTION", False);
-    server.atom._NET_WM_WINDOW_TYPE_DOCK = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_DOCK", False);
-    server.atom._NET_WM_WINDOW_TYPE_DESKTOP = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_DESKTOP", False);
-    server.atom._NET_WM_WINDOW_TYPE_TOOLBAR = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_TOOLBAR", False);
-    server.atom._NET_WM_WINDOW_TYPE_MENU = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_MENU", False);
-    server.atom._NET_WM_WINDOW_TYPE_SPLASH = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_SPLASH", False);
-    server.atom._NET_WM_WINDOW_TYPE_DIALOG = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_DIALOG", False);
-    server.atom._NET_WM_WINDOW_TYPE_NORMAL = XInternAtom(server.display, "_NET_WM_WINDOW_TYPE_NORMAL", False);
-    server.atom._NET_WM_DESKTOP = XInternAtom(server.display, "_NET_WM_DESKTOP", False);
-    server.atom.WM_STATE = XInternAtom(server.display, "WM_STATE", False);
-    server.atom._NET_WM_STATE = XInternAtom(server.display, "_NET_WM_STATE", False);
-    server.atom._NET_WM_STATE_MAXIMIZED_VERT = XInternAtom(server.display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
-    server.atom._NET_WM_STATE_MAXIMIZED_HORZ = XInternAtom(server.display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
-    server.atom._NET_WM_STATE_SHADED = XInternAtom(server.display, "_NET_WM_STATE_SHADED", False);
-    server.atom._NET_WM_STATE_HIDDEN = XInternAtom(server.display, "_NET_WM_STATE_HIDDEN", False);
-    server.atom._NET_WM_STATE_BELOW = XInternAtom(server.display, "_NET_WM_STATE_BELOW", False);
-    server.atom._NET_WM_STATE_ABOVE = XInternAtom(server.display, "_NET_WM_STATE_ABOVE", False);
-    server.atom._NET_WM_STATE_MODAL = XInternAtom(server.display, "_NET_WM_STATE_MODAL", False);
-    server.atom._NET_CLIENT_LIST = XInternAtom(server.display, "_NET_CLIENT_LIST", False);
-    server.atom._NET_WM_VISIBLE_NAME = XInternAtom(server.display, "_NET_WM_VISIBLE_NAME", False);
-    server.atom._NET_WM_NAME = XInternAtom(server.display, "_NET_WM_NAME", False);
-    server.atom._NET_WM_STRUT = XInternAtom(server.display, "_NET_WM_STRUT", False);
-    server.atom._NET_WM_ICON = XInternAtom(server.display, "_NET_WM_ICON", False);
-    server.atom._NET_WM_ICON_GEOMETRY = XInternAtom(server.display, "_NET_WM_ICON_GEOMETRY", False);
-    server.atom._NET_WM_ICON_NAME = XInternAtom(server.display, "_NET_WM_ICON_NAME", False);
-    server.atom._NET_CLOSE_WINDOW = XInternAtom(server.display, "_NET_CLOSE_WINDOW", False);
-    server.atom.UTF8_STRING = XInternAtom(server.display, "UTF8_STRING", False);
-    server.atom._NET_SUPPORTING_WM_CHECK = XInternAtom(server.display, "_NET_SUPPORTING_WM_CHECK", False);
-    server.atom._NET_WM_CM_S0 = XInternAtom(server.display, "_NET_WM_CM_S0", False);
-    server.atom._NET_SUPPORTING_WM_CHECK = XInternAtom(server.display, "_NET_WM_NAME", False);
-    server.atom._NET_WM_STRUT_PARTIAL = XInternAtom(server.display, "_NET_WM_STRUT_PARTIAL", False);
-    server.atom.WM_NAME = XInternAtom(server.display, "WM_NAME", False);
-    server.atom.__SWM_VROOT = XInternAtom(server.display, "__SWM_VROOT", False);
-    server.atom._MOTIF_WM_HINTS = XInternAtom(server.display, "_MOTIF_WM_HINTS", False);
-    server.atom.WM_HINTS = XInternAtom(server.display, "WM_HINTS", False);
-    gchar *name = g_strdup_printf("_XSETTINGS_S%d", DefaultScreen(server.display));
-    server.atom._XSETTINGS_SCREEN = XInternAtom(server.display, name, False);
-    g_free(name);
-    server.atom._XSETTINGS_SETTINGS = XInternAtom(server.display, "_XSETTINGS_SETTINGS", False);
-
-    // systray protocol
-    name = g_strdup_printf("_NET_SYSTEM_TRAY_S%d", DefaultScreen(server.display));
-    server.atom._NET_SYSTEM_TRAY_SCREEN = XInternAtom(server.display, name, False);
-    g_free(name);
-    server.atom._NET_SYSTEM_TRAY_OPCODE = XInternAtom(server.display, "_NET_SYSTEM_TRAY_OPCODE", False);
-    server.atom.MANAGER = XInternAtom(server.display, "MANAGER", False);
-    server.atom._NET_SYSTEM_TRAY_MESSAGE_DATA = XInternAtom(server.display, "_NET_SYSTEM_TRAY_MESSAGE_DATA", False);
-    server.atom._NET_SYSTEM_TRAY_ORIENTATION = XInternAtom(server.display, "_NET_SYSTEM_TRAY_ORIENTATION", False);
-    server.atom._NET_SYSTEM_TRAY_ICON_SIZE = XInternAtom(server.display, "_NET_SYSTEM_TRAY_ICON_SIZE", False);
-    server.atom._NET_SYSTEM_TRAY_PADDING = XInternAtom(server.display, "_NET_SYSTEM_TRAY_PADDING", False);
-    server.atom._XEMBED = XInternAtom(server.display, "_XEMBED", False);
-    server.atom._XEMBED_INFO = XInternAtom(server.display, "_XEMBED_INFO", False);
-    server.atom._NET_WM_PID = XInternAtom(server.display, "_NET_WM_PID", True);
-
-    // drag 'n' drop
-    server.atom.XdndAware = XInternAtom(server.display, "XdndAware", False);
-    server.atom.XdndEnter = XInternAtom(server.display, "XdndEnter", False);
-    server.atom.XdndPosition = XInternAtom(server.display, "XdndPosition", False);
-    server.atom.XdndStatus = XInternAtom(server.display, "XdndStatus", False);
-    server.atom.XdndDrop = XInternAtom(server.display, "XdndDrop", False);
-    server.atom.XdndLeave = XInternAtom(server.display, "XdndLeave", False);
-    server.atom.XdndSelection = XInternAtom(server.display, "XdndSelection", False);
-    server.atom.XdndTypeList = XInternAtom(server.display, "XdndTypeList", False);
-    server.atom.XdndActionCopy = XInternAtom(server.display, "XdndActionCopy", False);
-    server.atom.XdndFinished = XInternAtom(server.display, "XdndFinished", False);
-    server.atom.TARGETS = XInternAtom(server.display, "TARGETS", False);
-
-    // tint2 atoms
-    server.atom.TINT2_REFRESH_EXECP = XInternAtom(server.display, "_TINT2_REFRESH_EXECP", False);
+    const int n_static = sizeof(atom_names) / sizeof(atom_names[0]);
+    const int n = n_static + 2;
+    char *names[n];
+    Atom atoms[n];
+    for (int i = 0; i < n_static; i++)
+        names[i] = (char *)atom_names[i].name;
+    names[n_static] = g_strdup_printf("_XSETTINGS_S%d", DefaultScreen(server.display));
+    names[n_static + 1] = g_strdup_printf("_NET_SYSTEM_TRAY_S%d", DefaultScreen(server.display));
+
+    // A single round-trip to the X server instead of one per atom
+    if (!XInternAtoms(server.display, names, n, False, atoms))
+        fprintf(stderr, "tint2: " RED "Could not intern the X atoms" RESET "\n");
+    for (int i = 0; i < n_static; i++)
+        *(Atom *)((char *)&server.atom + atom_names[i].offset) = atoms[i];
+    server.atom._XSETTINGS_SCREEN = atoms[n_static];
+    server.atom._NET_SYSTEM_TRAY_SCREEN = atoms[n_static + 1];
+    g_free(names[n_static]);
+    g_free(names[n_static + 1]);
 }
 
 const char *GetAtomName(Display *disp, Atom a)
@@ -249,6 +269,53 @@ void *server_get_property(Window win, Atom at, Atom type, int *num_results)
         return NULL;
 }
 
+void *server_get_property_range(Window win,
+                                Atom at,
+                                Atom type,
+                                long offset,
+                                long length,
+                                int *num_results,
+                                unsigned long *bytes_after)
+{
+    Atom type_ret;
+    int format_ret = 0;
+    unsigned long nitems_ret = 0;
+    unsigned long bafter_ret = 0;
+    unsigned char *prop_value = NULL;
+
+    if (num_results)
+        *num_results = 0;
+    if (bytes_after)
+        *bytes_after = 0;
+    if (!win)
+        return NULL;
+
+    int result = XGetWindowProperty(server.display,
+                                    win,
+                                    at,
+                                    offset,
+                                    length,
+                                    False,
+                                    type,
+                                    &type_ret,
+                                    &format_ret,
+                                    &nitems_ret,
+                                    &bafter_ret,
+                                    &prop_value);
+
+    if (result != Success || !prop_value)
+        return NULL;
+    if (type_ret != type) {
+        XFree(prop_value);
+        return NULL;
+    }
+    if (num_results)
+        *num_results = (int)nitems_ret;
+    if (bytes_after)
+        *bytes_after = bafter_ret;
+    return prop_value;
+}
+
 void get_root_pixmap()
 {
     Pixmap ret = None;
@@ -643,9 +710,30 @@ void server_init_visual()
     }
 }
 
+gboolean server_update_composite_manager()
+{
+    Window owner = XGetSelectionOwner(server.display, server.atom._NET_WM_CM_S0);
+    gboolean real_transparency =
+        !server.disable_transparency && server.visual32 && owner != None && !snapshot_path;
+    if (real_transparency != server.real_transparency) {
+        server_init_visual();
+        return TRUE;
+    }
+    if (owner != server.composite_manager) {
+        server.composite_manager = owner;
+        if (real_transparency) {
+            XSetWindowAttributes attrs;
+            attrs.event_mask = StructureNotifyMask;
+            XChangeWindowAttributes(server.display, server.composite_manager, CWEventMask, &attrs);
+        }
+    }
+    return FALSE;
+}
+
 void server_init_xdamage()
 {
-    XDamageQueryExtension(server.display, &server.xdamage_event_type, &server.xdamage_event_error_type);
+    server.has_xdamage =
+        XDamageQueryExtension(server.display, &server.xdamage_event_type, &server.xdamage_event_error_type);
     server.xdamage_event_type += XDamageNotify;
     server.xdamage_event_error_type += XDamageNotify;
 }
@@ -75,6 +75,7 @@ typedef struct Global_atom {
     Atom _NET_SYSTEM_TRAY_ORIENTATION;
     Atom _NET_SYSTEM_TRAY_ICON_SIZE;
     Atom _NET_SYSTEM_TRAY_PADDING;
+    Atom _NET_SYSTEM_TRAY_VISUAL;
     Atom _XEMBED;
     Atom _XEMBED_INFO;
     Atom _NET_WM_PID;
@@ -147,6 +148,7 @@ typedef struct Server {
     Colormap colormap;
     Colormap colormap32;
     Global_atom atom;
+    gboolean has_xdamage;
     int xdamage_event_type;
     int xdamage_event_error_type;
     gboolean has_shm;
@@ -164,10 +166,22 @@ void cleanup_server();
 void send_event32(Window win, Atom at, long data1, long data2, long data3);
 int get_property32(Window win, Atom at, Atom type);
 void *server_get_property(Window win, Atom at, Atom type, int *num_results);
+// Like server_get_property, but fetches only 'length' 32-bit units starting at 'offset' (also in 32-bit units).
+// bytes_after is set to the number of bytes remaining in the property after the returned slice.
+void *server_get_property_range(Window win,
+                                Atom at,
+                                Atom type,
+                                long offset,
+                                long length,
+                                int *num_results,
+                                unsigned long *bytes_after);
 Atom server_get_atom(char *atom_name);
 int server_catch_error(Display *d, XErrorEvent *ev);
 void server_init_atoms();
 void server_init_visual();
+// Tracks the owner of the compositor selection after it changed. Returns TRUE if the transparency mode
+// (real or fake) changed: the visual, colormap and depth are updated, and the panel windows must be created again.
+gboolean server_update_composite_manager();
 void server_init_xdamage();
 
 int x11_io_error(Display *display);
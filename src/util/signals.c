@@ -19,6 +19,8 @@
 #include "signals.h"
 
 static sig_atomic_t signal_pending;
+// Set when tint2 itself requests a restart, as opposed to a config reload requested with SIGUSR1
+static gboolean restart_forced;
 
 void signal_handler(int sig)
 {
@@ -41,6 +43,7 @@ void init_signals()
 {
     // Set signal handlers
     signal_pending = 0;
+    restart_forced = FALSE;
 
     reset_signals();
 
@@ -159,11 +162,55 @@ void emit_self_restart(const char *reason)
             __FILE__,
             __LINE__,
             reason);
+    restart_forced = TRUE;
     signal_pending = SIGUSR1;
 }
 
+void emit_config_reload(const char *reason)
+{
+    fprintf(stderr, YELLOW "%s %d: triggering config reload, reason: %s" RESET "\n", __FILE__, __LINE__, reason);
+    if (!signal_pending)
+        signal_pending = SIGUSR1;
+}
+
 int get_signal_pending()
 {
     return signal_pending;
 }
+
+// Blocks the signals handled by signal_handler, so that none arriving in between is overwritten
+static void block_signals(sigset_t *old_set)
+{
+    sigset_t signal_set;
+    sigemptyset(&signal_set);
+    sigaddset(&signal_set, SIGUSR1);
+    sigaddset(&signal_set, SIGUSR2);
+    sigaddset(&signal_set, SIGINT);
+    sigaddset(&signal_set, SIGTERM);
+    sigaddset(&signal_set, SIGHUP);
+    sigprocmask(SIG_BLOCK, &signal_set, old_set);
+}
+
+gboolean take_config_reload()
+{
+    sigset_t old_set;
+    block_signals(&old_set);
+    gboolean taken = signal_pending == SIGUSR1 && !restart_forced;
+    if (taken)
+        signal_pending = 0;
+    sigprocmask(SIG_SETMASK, &old_set, NULL);
+    return taken;
+}
+
+void emit_restart_after_failed_reload()
+{
+    sigset_t old_set;
+    block_signals(&old_set);
+    // Another signal received during the reload takes precedence
+    if (!signal_pending || signal_pending == SIGUSR1) {
+        restart_forced = TRUE;
+        signal_pending = SIGUSR1;
+    }
+    sigprocmask(SIG_SETMASK, &old_set, NULL);
+}
 #endif
@@ -1,10 +1,18 @@
 #ifndef SIGNALS_H
 #define SIGNALS_H
 
+#include <glib.h>
+
 void init_signals();
 void init_signals_postconfig();
 void emit_self_restart(const char *reason);
+// Same as receiving SIGUSR1: the configuration is reloaded, in place if possible
+void emit_config_reload(const char *reason);
 int get_signal_pending();
+// If the pending signal is a config reload that may be done in place, clears it and returns TRUE
+gboolean take_config_reload();
+// Requests a restart, unless another signal (e.g. SIGTERM) is pending
+void emit_restart_after_failed_reload();
 void reset_signals();
 
 void handle_sigchld_events();
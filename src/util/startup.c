@@ -0,0 +1,201 @@
+/**************************************************************************
+*
+* Tint2 : startup timeline
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "colors.h"
+#include "startup.h"
+#include "timer.h"
+
+gboolean debug_startup = FALSE;
+
+typedef struct StartupPhase {
+    const char *name;
+    double duration;
+    double cpu_time;
+} StartupPhase;
+
+#define MAX_STARTUP_PHASES 16
+
+static StartupPhase startup_phases[MAX_STARTUP_PHASES];
+static int num_startup_phases;
+static double startup_start_time;
+static double startup_last_mark;
+static double startup_last_cpu_time;
+static gboolean startup_active;
+
+typedef struct StartupTask {
+    const char *name;
+    StartupTaskFunc func;
+    StartupTaskFunc done;
+    void *arg;
+    GThread *thread;
+    gboolean on_worker;
+    // Measured on the thread that ran func
+    double duration;
+    double cpu_time;
+} StartupTask;
+
+// Tasks in reverse order of submission. Kept until the timeline is printed.
+static GSList *startup_tasks;
+static gboolean startup_tasks_accepted;
+
+// CPU time used by the calling thread, in seconds
+static double get_thread_cpu_time()
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+static void free_startup_tasks()
+{
+    g_slist_free_full(startup_tasks, free);
+    startup_tasks = NULL;
+}
+
+void startup_begin()
+{
+    free_startup_tasks();
+    startup_tasks_accepted = getenv("TINT2_NO_PARALLEL_INIT") == NULL;
+    if (!debug_startup)
+        return;
+    num_startup_phases = 0;
+    startup_start_time = startup_last_mark = get_time();
+    startup_last_cpu_time = get_thread_cpu_time();
+    startup_active = TRUE;
+}
+
+void startup_mark(const char *phase)
+{
+    if (!startup_active)
+        return;
+    double now = get_time();
+    double cpu_time = get_thread_cpu_time();
+    double duration = now - startup_last_mark;
+    double cpu_duration = cpu_time - startup_last_cpu_time;
+    startup_last_mark = now;
+    startup_last_cpu_time = cpu_time;
+    for (int i = 0; i < num_startup_phases; i++) {
+        if (strcmp(startup_phases[i].name, phase) == 0) {
+            startup_phases[i].duration += duration;
+            startup_phases[i].cpu_time += cpu_duration;
+            return;
+        }
+    }
+    if (num_startup_phases == MAX_STARTUP_PHASES)
+        return;
+    startup_phases[num_startup_phases].name = phase;
+    startup_phases[num_startup_phases].duration = duration;
+    startup_phases[num_startup_phases].cpu_time = cpu_duration;
+    num_startup_phases++;
+}
+
+void startup_timeline_finish()
+{
+    if (!startup_active)
+        return;
+    startup_mark("first render");
+    startup_active = FALSE;
+    double total = startup_last_mark - startup_start_time;
+    fprintf(stderr, BLUE "tint2: startup: first frame after %.1f ms" RESET "\n", total * 1e3);
+    for (int i = 0; i < num_startup_phases; i++) {
+        fprintf(stderr,
+                BLUE "tint2: startup:   %-14s %7.1f ms (%3.0f%%), cpu %7.1f ms" RESET "\n",
+                startup_phases[i].name,
+                startup_phases[i].duration * 1e3,
+                total > 0 ? 100 * startup_phases[i].duration / total : 0.0,
+                startup_phases[i].cpu_time * 1e3);
+    }
+    startup_tasks = g_slist_reverse(startup_tasks);
+    for (GSList *l = startup_tasks; l; l = l->next) {
+        StartupTask *task = (StartupTask *)l->data;
+        fprintf(stderr,
+                BLUE "tint2: startup:   task %-9s %7.1f ms,        cpu %7.1f ms%s" RESET "\n",
+                task->name,
+                task->duration * 1e3,
+                task->cpu_time * 1e3,
+                task->on_worker ? "" : " (main thread)");
+    }
+    free_startup_tasks();
+}
+
+static void run_startup_task(StartupTask *task)
+{
+    double start = get_time();
+    double cpu_start = get_thread_cpu_time();
+    task->func(task->arg);
+    task->duration = get_time() - start;
+    task->cpu_time = get_thread_cpu_time() - cpu_start;
+}
+
+static gpointer startup_task_thread(gpointer data)
+{
+    run_startup_task((StartupTask *)data);
+    return NULL;
+}
+
+void startup_task_run(const char *name, StartupTaskFunc func, StartupTaskFunc done, void *arg)
+{
+    if (!startup_tasks_accepted) {
+        func(arg);
+        if (done)
+            done(arg);
+        return;
+    }
+    StartupTask *task = calloc(1, sizeof(StartupTask));
+    task->name = name;
+    task->func = func;
+    task->done = done;
+    task->arg = arg;
+    task->thread = g_thread_try_new(name, startup_task_thread, task, NULL);
+    task->on_worker = task->thread != NULL;
+    if (!task->thread) {
+        fprintf(stderr, YELLOW "tint2: could not start a thread for %s, loading it now" RESET "\n", name);
+        run_startup_task(task);
+    }
+    startup_tasks = g_slist_prepend(startup_tasks, task);
+}
+
+void startup_tasks_join()
+{
+    if (!startup_tasks_accepted)
+        return;
+    // Tasks started by the done callbacks run immediately
+    startup_tasks_accepted = FALSE;
+    for (GSList *l = startup_tasks; l; l = l->next) {
+        StartupTask *task = (StartupTask *)l->data;
+        if (task->thread)
+            g_thread_join(task->thread);
+        task->thread = NULL;
+    }
+    startup_mark("startup tasks");
+    // In the order of submission
+    startup_tasks = g_slist_reverse(startup_tasks);
+    for (GSList *l = startup_tasks; l; l = l->next) {
+        StartupTask *task = (StartupTask *)l->data;
+        if (task->done)
+            task->done(task->arg);
+    }
+    startup_tasks = g_slist_reverse(startup_tasks);
+    if (!startup_active)
+        free_startup_tasks();
+}
@@ -0,0 +1,51 @@
+/**************************************************************************
+*
+* Tint2 : startup timeline
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <glib.h>
+
+// When DEBUG_STARTUP is set, tint2 prints how long each phase of the startup took, up to the first frame,
+// in wall time and in CPU time of the main thread, as well as the time spent in the startup tasks.
+extern gboolean debug_startup;
+
+// Starts the timeline and accepts startup tasks. Called at the beginning of each (re)start.
+void startup_begin();
+
+// Ends the current phase of the startup: the time since the previous mark is attributed to phase.
+// A phase may be marked several times, the durations are added up. Does nothing once the timeline is finished.
+// phase must be a string literal.
+void startup_mark(const char *phase);
+
+// Ends the timeline after the first frame has been rendered and prints it.
+void startup_timeline_finish();
+
+typedef void (*StartupTaskFunc)(void *arg);
+
+// Runs func(arg) on a worker thread while tint2 is starting, then done(arg) (if not NULL) on the main thread
+// when the startup tasks are joined. Once they have been joined, or if TINT2_NO_PARALLEL_INIT is set, runs
+// func(arg) then done(arg) immediately.
+// func must not use X, Pango objects created by the main thread or the panels; the main thread must not use
+// the state written by func before done is called.
+// name must be a string literal.
+void startup_task_run(const char *name, StartupTaskFunc func, StartupTaskFunc done, void *arg);
+
+// Waits for the startup tasks and runs their done callbacks. Called before the first frame.
+void startup_tasks_join();
+
+#endif
@@ -20,6 +20,7 @@ typedef struct TestListItem {
 } TestListItem;
 
 static GList *all_tests = NULL;
+static GList *all_benchmarks = NULL;
 
 void register_test_(Test *test, const char *name)
 {
@@ -29,6 +30,14 @@ void register_test_(Test *test, const char *name)
     all_tests = g_list_append(all_tests, item);
 }
 
+void register_benchmark_(Test *benchmark, const char *name)
+{
+    TestListItem *item = (TestListItem *)calloc(sizeof(TestListItem), 1);
+    item->test = benchmark;
+    item->name = name;
+    all_benchmarks = g_list_append(all_benchmarks, item);
+}
+
 static char *test_log_name_from_test_name(const char *test_name)
 {
     char *output_name = g_strdup_printf("test_%s.log", test_name);
@@ -168,6 +177,26 @@ void run_all_tests(bool verbose)
         fprintf(stdout, BLUE "tint2: " RED "%lu" BLUE " out of %lu tests " RED "failed." RESET "\n", failed, count);
 }
 
+// Runs the benchmarks one after the other in this process, with their output on stdout
+void run_all_benchmarks()
+{
+    fprintf(stdout, BLUE "tint2: Running %d benchmarks..." RESET "\n", g_list_length(all_benchmarks));
+    size_t failed = 0;
+    for (GList *l = all_benchmarks; l; l = l->next) {
+        TestListItem *item = (TestListItem *)l->data;
+        fprintf(stdout, BLUE "tint2: Benchmark " YELLOW "%s" RESET "\n", item->name);
+        fflush(stdout);
+        Status status = SUCCESS;
+        item->test(&status);
+        if (status != SUCCESS) {
+            fprintf(stdout, BLUE "tint2: Benchmark " YELLOW "%s" BLUE ": " RED "failed" RESET "\n", item->name);
+            failed++;
+        }
+    }
+    if (failed)
+        fprintf(stdout, BLUE "tint2: " RED "%lu" BLUE " benchmarks " RED "failed." RESET "\n", failed);
+}
+
 #if 0
 TEST(dummy) {
     int x = 2;
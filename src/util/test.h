@@ -18,6 +18,20 @@ void register_test_(Test *test, const char *name);
 
 void run_all_tests(bool verbose);
 
+// Benchmarks are defined like tests, but are only run by run_all_benchmarks (tint2 --benchmark), not with the tests.
+// They print their results, and can use the ASSERT macros.
+void register_benchmark_(Test *benchmark, const char *name);
+
+#define BENCHMARK(name)                                           \
+    void benchmark_##name(Status *test_result_);                  \
+    __attribute__((constructor)) void benchmark_register_##name() \
+    {                                                             \
+        register_benchmark_(benchmark_##name, #name);             \
+    }                                                             \
+    void benchmark_##name(Status *test_result_)
+
+void run_all_benchmarks();
+
 #define FAIL_TEST_           \
     *test_result_ = FAILURE; \
     return;
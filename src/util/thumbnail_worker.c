@@ -0,0 +1,188 @@
+/**************************************************************************
+*
+* Tint2 : background capture of window thumbnails
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 2
+* as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**************************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "panel.h"
+#include "server.h"
+#include "thumbnail_worker.h"
+#include "timer.h"
+#include "window.h"
+
+typedef struct ThumbnailJob {
+    Window win;
+    int size;
+    gboolean quit;
+} ThumbnailJob;
+
+typedef struct ThumbnailResult {
+    Window win;
+    cairo_surface_t *thumbnail;
+    double duration;
+} ThumbnailResult;
+
+// How long the worker waits for a job before releasing idle resources, in microseconds
+#define THUMBNAIL_WORKER_IDLE_USEC (10 * G_USEC_PER_SEC)
+
+static GThread *worker_thread;
+static Display *worker_display;
+static GAsyncQueue *job_queue;
+static GAsyncQueue *result_queue;
+static int wakeup_pipe[2] = {-1, -1};
+// Windows with a capture in progress. Only accessed from the main thread.
+static GHashTable *pending_windows;
+static ThumbnailReadyCallback ready_callback;
+
+static gpointer thumbnail_worker_main(gpointer data)
+{
+    ThumbnailContext *ctx = thumbnail_context_new(worker_display);
+    while (TRUE) {
+        ThumbnailJob *job = g_async_queue_timeout_pop(job_queue, THUMBNAIL_WORKER_IDLE_USEC);
+        if (!job) {
+            thumbnail_context_expire(ctx);
+            continue;
+        }
+        if (job->quit) {
+            free(job);
+            break;
+        }
+        ThumbnailResult *result = calloc(1, sizeof(ThumbnailResult));
+        double start = get_time();
+        result->win = job->win;
+        result->thumbnail = get_window_thumbnail_with(ctx, job->win, job->size);
+        result->duration = get_time() - start;
+        free(job);
+        g_async_queue_push(result_queue, result);
+        ssize_t unused = write(wakeup_pipe[1], "x", 1);
+        (void)unused;
+    }
+    thumbnail_context_free(ctx);
+    return NULL;
+}
+
+gboolean thumbnail_worker_start(ThumbnailReadyCallback callback)
+{
+    if (worker_thread)
+        return TRUE;
+    if (getenv("TINT2_THUMBNAIL_NO_THREAD"))
+        return FALSE;
+    worker_display = XOpenDisplay(DisplayString(server.display));
+    if (!worker_display) {
+        fprintf(stderr, YELLOW "tint2: could not open a display for the thumbnail worker" RESET "\n");
+        return FALSE;
+    }
+    if (pipe(wakeup_pipe) != 0) {
+        fprintf(stderr, YELLOW "tint2: could not create a pipe for the thumbnail worker" RESET "\n");
+        XCloseDisplay(worker_display);
+        worker_display = NULL;
+        return FALSE;
+    }
+    fcntl(wakeup_pipe[0], F_SETFL, O_NONBLOCK | fcntl(wakeup_pipe[0], F_GETFL));
+    fcntl(wakeup_pipe[1], F_SETFL, O_NONBLOCK | fcntl(wakeup_pipe[1], F_GETFL));
+    job_queue = g_async_queue_new();
+    result_queue = g_async_queue_new();
+    pending_windows = g_hash_table_new(g_direct_hash, g_direct_equal);
+    ready_callback = callback;
+    worker_thread = g_thread_new("thumbnails", thumbnail_worker_main, NULL);
+    if (debug_thumbnails)
+        fprintf(stderr, "tint2: started thumbnail worker\n");
+    return TRUE;
+}
+
+void thumbnail_worker_stop()
+{
+    if (!worker_thread)
+        return;
+    ThumbnailJob *job = calloc(1, sizeof(ThumbnailJob));
+    job->quit = TRUE;
+    // Skip the captures that were not started yet
+    g_async_queue_lock(job_queue);
+    ThumbnailJob *pending;
+    while ((pending = g_async_queue_try_pop_unlocked(job_queue)))
+        free(pending);
+    g_async_queue_push_unlocked(job_queue, job);
+    g_async_queue_unlock(job_queue);
+    g_thread_join(worker_thread);
+    worker_thread = NULL;
+
+    ThumbnailResult *result;
+    while ((result = g_async_queue_try_pop(result_queue))) {
+        if (result->thumbnail)
+            cairo_surface_destroy(result->thumbnail);
+        free(result);
+    }
+    g_async_queue_unref(job_queue);
+    job_queue = NULL;
+    g_async_queue_unref(result_queue);
+    result_queue = NULL;
+    g_hash_table_destroy(pending_windows);
+    pending_windows = NULL;
+    close(wakeup_pipe[0]);
+    close(wakeup_pipe[1]);
+    wakeup_pipe[0] = wakeup_pipe[1] = -1;
+    XCloseDisplay(worker_display);
+    worker_display = NULL;
+    ready_callback = NULL;
+}
+
+gboolean thumbnail_worker_enabled()
+{
+    return worker_thread != NULL;
+}
+
+void thumbnail_worker_request(Window win, int size)
+{
+    if (!worker_thread)
+        return;
+    if (g_hash_table_contains(pending_windows, GINT_TO_POINTER(win)))
+        return;
+    g_hash_table_add(pending_windows, GINT_TO_POINTER(win));
+    ThumbnailJob *job = calloc(1, sizeof(ThumbnailJob));
+    job->win = win;
+    job->size = size;
+    g_async_queue_push(job_queue, job);
+}
+
+int thumbnail_worker_fd()
+{
+    return wakeup_pipe[0];
+}
+
+void handle_thumbnail_worker_events()
+{
+    if (!worker_thread)
+        return;
+    char buffer[64];
+    while (read(wakeup_pipe[0], buffer, sizeof(buffer)) > 0) {
+    }
+    ThumbnailResult *result;
+    while ((result = g_async_queue_try_pop(result_queue))) {
+        g_hash_table_remove(pending_windows, GINT_TO_POINTER(result->win));
+        if (debug_thumbnails)
+            fprintf(stderr,
+                    "tint2: thumbnail worker captured window %lu in %f ms%s\n",
+                    result->win,
+                    1000 * result->duration,
+                    result->thumbnail ? "" : " (failed)");
+        ready_callback(result->win, result->thumbnail);
+        free(result);
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef THUMBNAIL_WORKER_H
+#define THUMBNAIL_WORKER_H
+
+#include <glib.h>
+#include <X11/Xlib.h>
+#include <cairo.h>
+
+// Captures window thumbnails on a background thread, using a separate X connection,
+// so that the main loop never blocks on a capture.
+// Results are reported via a pipe that must be polled by the main loop.
+
+typedef void (*ThumbnailReadyCallback)(Window win, cairo_surface_t *thumbnail);
+
+// Starts the worker thread. Returns FALSE if that was not possible;
+// in that case thumbnails must be captured synchronously.
+gboolean thumbnail_worker_start(ThumbnailReadyCallback callback);
+void thumbnail_worker_stop();
+gboolean thumbnail_worker_enabled();
+
+// Queues a capture of the window. Requests for windows with a capture already pending are ignored.
+void thumbnail_worker_request(Window win, int size);
+
+// The read end of the wakeup pipe, or -1 if the worker is not running.
+int thumbnail_worker_fd();
+// Calls the callback for every completed capture. The callback receives a new reference to the
+// thumbnail (or NULL if the capture failed) and must release it.
+void handle_thumbnail_worker_events();
+
+#endif
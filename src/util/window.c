@@ -21,6 +21,7 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -32,14 +33,18 @@
 #include <cairo-xlib.h>
 
 #include <X11/extensions/XShm.h>
+#include <X11/extensions/Xcomposite.h>
+#include <X11/extensions/Xrender.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
 #include "common.h"
+#include "downscale.h"
 #include "window.h"
 #include "server.h"
 #include "panel.h"
 #include "taskbar.h"
+#include "timer.h"
 
 void activate_window(Window win)
 {
@@ -343,6 +348,121 @@ gulong *get_best_icon(gulong *data, int icon_count, int num, int *iw, int *ih, i
     return icon_data[icon_num];
 }
 
+// Limits the number of entries we are willing to walk in a _NET_WM_ICON property.
+#define MAX_ICON_ENTRIES 64
+// Icons larger than this are ignored (the property would be larger than what X allows anyway).
+#define MAX_ICON_SIDE 4096
+
+static gulong *get_window_icon_at(Window win, WindowIconLocation *location)
+{
+    long length = 2 + (long)location->width * location->height;
+    int num;
+    gulong *data = server_get_property_range(win,
+                                             server.atom._NET_WM_ICON,
+                                             XA_CARDINAL,
+                                             location->offset,
+                                             length,
+                                             &num,
+                                             NULL);
+    if (!data)
+        return NULL;
+    if (num != length || (int)data[0] != location->width || (int)data[1] != location->height) {
+        XFree(data);
+        return NULL;
+    }
+    return data;
+}
+
+static gboolean find_best_window_icon(Window win, int best_icon_size, WindowIconLocation *result)
+{
+    long offsets[MAX_ICON_ENTRIES];
+    int width[MAX_ICON_ENTRIES], height[MAX_ICON_ENTRIES];
+    int icon_count = 0;
+
+    long total = -1;
+    long pos = 0;
+    while (icon_count < MAX_ICON_ENTRIES && (total < 0 || pos + 2 <= total)) {
+        int num;
+        unsigned long bytes_after;
+        gulong *header =
+            server_get_property_range(win, server.atom._NET_WM_ICON, XA_CARDINAL, pos, 2, &num, &bytes_after);
+        if (!header)
+            break;
+        int w = num == 2 ? (int)header[0] : 0;
+        int h = num == 2 ? (int)header[1] : 0;
+        XFree(header);
+        if (total < 0)
+            total = pos + num + (long)(bytes_after / 4);
+        if (w <= 0 || h <= 0 || w > MAX_ICON_SIDE || h > MAX_ICON_SIDE)
+            break;
+        if (pos + 2 + (long)w * h > total)
+            break;
+        offsets[icon_count] = pos;
+        width[icon_count] = w;
+        height[icon_count] = h;
+        icon_count++;
+        pos += 2 + (long)w * h;
+    }
+
+    if (icon_count < 1)
+        return FALSE;
+
+    /* Try to find exact size */
+    int icon_num = -1;
+    for (int i = 0; i < icon_count; i++) {
+        if (width[i] == best_icon_size) {
+            icon_num = i;
+            break;
+        }
+    }
+
+    /* Take the biggest or whatever */
+    if (icon_num < 0) {
+        int highest = 0;
+        for (int i = 0; i < icon_count; i++) {
+            if (width[i] > highest) {
+                icon_num = i;
+                highest = width[i];
+            }
+        }
+    }
+
+    result->offset = offsets[icon_num];
+    result->width = width[icon_num];
+    result->height = height[icon_num];
+    result->requested_size = best_icon_size;
+    return TRUE;
+}
+
+gulong *get_window_icon(Window win, int best_icon_size, int *iw, int *ih, WindowIconLocation *location)
+{
+    WindowIconLocation found = {};
+    gulong *data = NULL;
+
+    if (location && location->width > 0 && location->requested_size == best_icon_size) {
+        found = *location;
+        data = get_window_icon_at(win, &found);
+    }
+    if (!data) {
+        if (!find_best_window_icon(win, best_icon_size, &found))
+            goto err;
+        data = get_window_icon_at(win, &found);
+        if (!data)
+            goto err;
+    }
+
+    if (location)
+        *location = found;
+    *iw = found.width;
+    *ih = found.height;
+    return data;
+
+err:
+    if (location)
+        memset(location, 0, sizeof(*location));
+    return NULL;
+}
+
 // Thanks zcodes!
 char *get_window_name(Window win)
 {
@@ -372,58 +492,261 @@ char *get_window_name(Window win)
     return result;
 }
 
-void smooth_thumbnail(cairo_surface_t *image_surface)
+// Pool of MIT-SHM segments attached to the X server, reused across thumbnail captures.
+// Segments are sized to the largest recently captured window, released when idle,
+// and the pool as a whole is capped to avoid pinning large amounts of shared memory.
+typedef struct ShmSegment {
+    XShmSegmentInfo info;
+    size_t size;
+    double last_used;
+} ShmSegment;
+
+#define SHM_POOL_SLOTS 2
+#define SHM_POOL_MAX_BYTES (64 * 1024 * 1024)
+#define SHM_POOL_IDLE_SECONDS 30
+#define SHM_POOL_ROUNDING (256 * 1024)
+
+// State of the thumbnail capture code for one X connection.
+// The main connection has one, and so does the thumbnail worker thread.
+struct ThumbnailContext {
+    Display *display;
+    Window root_win;
+    gboolean has_shm;
+    gboolean x_error;
+    ShmSegment shm_pool[SHM_POOL_SLOTS];
+    size_t shm_pool_recent_max_size;
+};
+
+static ThumbnailContext *main_context;
+static Timer shm_pool_timer;
+// The context used by the capture in progress on the current thread, for error reporting
+static __thread ThumbnailContext *current_context;
+
+ThumbnailContext *thumbnail_context_new(Display *display)
+{
+    ThumbnailContext *ctx = calloc(1, sizeof(ThumbnailContext));
+    ctx->display = display;
+    ctx->root_win = DefaultRootWindow(display);
+    ctx->has_shm = XShmQueryExtension(display);
+    return ctx;
+}
+
+static size_t shm_pool_total_size(ThumbnailContext *ctx)
+{
+    size_t total = 0;
+    for (int i = 0; i < SHM_POOL_SLOTS; i++)
+        total += ctx->shm_pool[i].size;
+    return total;
+}
+
+static void shm_segment_release(ThumbnailContext *ctx, ShmSegment *segment)
+{
+    if (!segment->size)
+        return;
+    if (debug_thumbnails)
+        fprintf(stderr, "tint2: releasing thumbnail shm segment of %zu bytes\n", segment->size);
+    XShmDetach(ctx->display, &segment->info);
+    XSync(ctx->display, False);
+    shmdt(segment->info.shmaddr);
+    memset(segment, 0, sizeof(*segment));
+}
+
+static gboolean shm_segment_create(ThumbnailContext *ctx, ShmSegment *segment, size_t size)
 {
-    u_int32_t *data = (u_int32_t *)cairo_image_surface_get_data(image_surface);
-    const size_t tw = cairo_image_surface_get_width(image_surface);
-    const size_t th = cairo_image_surface_get_height(image_surface);
-    const size_t rmask = 0xff0000;
-    const size_t gmask = 0xff00;
-    const size_t bmask = 0xff;
-    for (size_t i = 0; i < tw * (th - 1) - 1 && i < tw * th; i++) {
-        u_int32_t c1 = data[i];
-        u_int32_t c2 = data[i + 1];
-        u_int32_t c3 = data[i + tw];
-        u_int32_t c4 = data[i + tw + 1];
-        u_int32_t b = (5 * (c1 & bmask) + 1 * (c2 & bmask) + 1 * (c3 & bmask) + 1 * (c4 & bmask)) / 8;
-        u_int32_t g = (5 * (c1 & gmask) + 1 * (c2 & gmask) + 1 * (c3 & gmask) + 1 * (c4 & gmask)) / 8;
-        u_int32_t r = (5 * (c1 & rmask) + 1 * (c2 & rmask) + 1 * (c3 & rmask) + 1 * (c4 & rmask)) / 8;
-        data[i] = (r & rmask) | (g & gmask) | (b & bmask);
+    memset(segment, 0, sizeof(*segment));
+    segment->info.shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (segment->info.shmid < 0) {
+        fprintf(stderr, RED "tint2: !shmget" RESET "\n");
+        return FALSE;
     }
+    segment->info.shmaddr = (char *)shmat(segment->info.shmid, 0, 0);
+    if (segment->info.shmaddr == (void *)-1) {
+        fprintf(stderr, RED "tint2: !shmat" RESET "\n");
+        shmctl(segment->info.shmid, IPC_RMID, NULL);
+        return FALSE;
+    }
+    segment->info.readOnly = False;
+    if (!XShmAttach(ctx->display, &segment->info)) {
+        fprintf(stderr, RED "tint2: !xshmattach" RESET "\n");
+        shmdt(segment->info.shmaddr);
+        shmctl(segment->info.shmid, IPC_RMID, NULL);
+        return FALSE;
+    }
+    // Mark the segment for deletion now: it stays alive while attached, and cannot leak if we crash.
+    XSync(ctx->display, False);
+    shmctl(segment->info.shmid, IPC_RMID, NULL);
+    segment->size = size;
+    if (debug_thumbnails)
+        fprintf(stderr, "tint2: created thumbnail shm segment of %zu bytes\n", size);
+    return TRUE;
 }
 
-// This is measured to be slightly faster.
-#define GetPixel(ximg, x, y) ((u_int32_t *)&(ximg->data[y * ximg->bytes_per_line]))[x]
-//#define GetPixel XGetPixel
+gboolean thumbnail_context_expire(ThumbnailContext *ctx)
+{
+    double now = get_time();
+    for (int i = 0; i < SHM_POOL_SLOTS; i++) {
+        if (ctx->shm_pool[i].size && now - ctx->shm_pool[i].last_used > SHM_POOL_IDLE_SECONDS)
+            shm_segment_release(ctx, &ctx->shm_pool[i]);
+    }
+    if (!shm_pool_total_size(ctx)) {
+        ctx->shm_pool_recent_max_size = 0;
+        return FALSE;
+    }
+    return TRUE;
+}
 
-cairo_surface_t *get_window_thumbnail_ximage(Window win, size_t size, gboolean use_shm)
+void thumbnail_context_free(ThumbnailContext *ctx)
 {
-    cairo_surface_t *result = NULL;
-    XWindowAttributes wa = {};
-    if (!XGetWindowAttributes(server.display, win, &wa) || wa.width <= 0 || wa.height <= 0 ||
-            wa.map_state != IsViewable) {
+    if (!ctx)
+        return;
+    for (int i = 0; i < SHM_POOL_SLOTS; i++)
+        shm_segment_release(ctx, &ctx->shm_pool[i]);
+    free(ctx);
+}
+
+static void shm_pool_expire(void *arg)
+{
+    if (!main_context || !thumbnail_context_expire(main_context))
+        stop_timer(&shm_pool_timer);
+}
+
+// Returns an attached segment of at least the given size, or NULL.
+static ShmSegment *shm_pool_acquire(ThumbnailContext *ctx, size_t size)
+{
+    ShmSegment *shm_pool = ctx->shm_pool;
+    double now = get_time();
+    ctx->shm_pool_recent_max_size = MAX(ctx->shm_pool_recent_max_size, size);
+
+    ShmSegment *best = NULL;
+    for (int i = 0; i < SHM_POOL_SLOTS; i++) {
+        if (shm_pool[i].size >= size && (!best || shm_pool[i].size < best->size))
+            best = &shm_pool[i];
+    }
+    if (best) {
+        best->last_used = now;
+        return best;
+    }
+
+    // Pick a free slot, or evict the least recently used segment
+    ShmSegment *slot = NULL;
+    for (int i = 0; i < SHM_POOL_SLOTS; i++) {
+        if (!shm_pool[i].size) {
+            slot = &shm_pool[i];
+            break;
+        }
+        if (!slot || shm_pool[i].last_used < slot->last_used)
+            slot = &shm_pool[i];
+    }
+    shm_segment_release(ctx, slot);
+
+    size_t new_size = MAX(size, ctx->shm_pool_recent_max_size);
+    new_size = (new_size + SHM_POOL_ROUNDING - 1) / SHM_POOL_ROUNDING * SHM_POOL_ROUNDING;
+    // Under memory pressure, give up the other segments first
+    if (shm_pool_total_size(ctx) + new_size > SHM_POOL_MAX_BYTES) {
+        for (int i = 0; i < SHM_POOL_SLOTS; i++)
+            shm_segment_release(ctx, &shm_pool[i]);
+        if (new_size > SHM_POOL_MAX_BYTES)
+            return NULL;
+    }
+    if (!shm_segment_create(ctx, slot, new_size))
+        return NULL;
+    slot->last_used = now;
+
+    // Other contexts expire their segments on their own thread
+    if (ctx == main_context && !shm_pool_timer.enabled_)
+        change_timer(&shm_pool_timer, true, 10000, 10000, shm_pool_expire, NULL);
+    return slot;
+}
+
+void init_window_thumbnails()
+{
+    INIT_TIMER(shm_pool_timer);
+}
+
+void cleanup_window_thumbnails()
+{
+    thumbnail_context_free(main_context);
+    main_context = NULL;
+    stop_timer(&shm_pool_timer);
+    destroy_timer(&shm_pool_timer);
+}
+
+int thumbnail_x_error_handler(Display *d, XErrorEvent *e)
+{
+    if (current_context && current_context->display == d)
+        current_context->x_error = TRUE;
+    return 0;
+}
+
+static gboolean thumbnail_window_is_iconified(ThumbnailContext *ctx, Window win)
+{
+    Atom type_ret;
+    int format_ret = 0;
+    unsigned long nitems = 0;
+    unsigned long bytes_after = 0;
+    unsigned char *prop_value = NULL;
+    gboolean result = FALSE;
+    if (XGetWindowProperty(ctx->display,
+                           win,
+                           server.atom._NET_WM_STATE,
+                           0,
+                           0x7fffffff,
+                           False,
+                           XA_ATOM,
+                           &type_ret,
+                           &format_ret,
+                           &nitems,
+                           &bytes_after,
+                           &prop_value) != Success ||
+        !prop_value)
+        return FALSE;
+    Atom *at = (Atom *)prop_value;
+    for (unsigned long i = 0; i < nitems; i++) {
+        if (at[i] == server.atom._NET_WM_STATE_HIDDEN)
+            result = TRUE;
+    }
+    XFree(prop_value);
+    return result;
+}
+
+// Size of a window thumbnail: the window (w x h) is scaled to fw x th and centered
+// horizontally at offset ox inside a tw x th image.
+typedef struct ThumbnailGeometry {
+    size_t w, h;
+    size_t tw, th;
+    size_t fw, ox;
+} ThumbnailGeometry;
+
+static gboolean get_thumbnail_geometry(ThumbnailContext *ctx,
+                                       Window win,
+                                       size_t size,
+                                       XWindowAttributes *wa,
+                                       ThumbnailGeometry *geometry)
+{
+    if (!XGetWindowAttributes(ctx->display, win, wa) || wa->width <= 0 || wa->height <= 0 ||
+            wa->map_state != IsViewable) {
         if (debug_thumbnails) {
             fprintf(stderr, "tint2: could not get thumbnail, invalid geometry %d x %d\n",
-                    wa.width, wa.height);
+                    wa->width, wa->height);
         }
-        goto err0;
+        return FALSE;
     }
 
-    if (window_is_iconified(win)) {
+    if (thumbnail_window_is_iconified(ctx, win)) {
         if (debug_thumbnails) {
             fprintf(stderr, "tint2: could not get thumbnail, minimized window\n");
         }
-        goto err0;
+        return FALSE;
     }
 
     if (debug_thumbnails) {
         fprintf(stderr, "tint2: getting thumbnail for window with size %d x %d\n",
-                wa.width, wa.height);
+                wa->width, wa->height);
     }
 
     size_t w, h;
-    w = (size_t)wa.width;
-    h = (size_t)wa.height;
+    w = (size_t)wa->width;
+    h = (size_t)wa->height;
     size_t tw, th, fw;
     size_t ox, oy;
     tw = size;
@@ -449,13 +772,33 @@ cairo_surface_t *get_window_thumbnail_ximage(Window win, size_t size, gboolean u
                     "%zu x %zu => %zu x %zu, %zu\n",
                     w, h, tw, th, fw);
         }
-        goto err0;
+        return FALSE;
     }
 
+    geometry->w = w;
+    geometry->h = h;
+    geometry->tw = tw;
+    geometry->th = th;
+    geometry->fw = fw;
+    geometry->ox = ox;
+    return TRUE;
+}
+
+cairo_surface_t *get_window_thumbnail_ximage(ThumbnailContext *ctx, Window win, size_t size, gboolean use_shm)
+{
+    cairo_surface_t *result = NULL;
+    XWindowAttributes wa = {};
+    ThumbnailGeometry geometry;
+    if (!get_thumbnail_geometry(ctx, win, size, &wa, &geometry))
+        goto err0;
+    const size_t w = geometry.w, h = geometry.h;
+    const size_t tw = geometry.tw, th = geometry.th;
+    const size_t fw = geometry.fw, ox = geometry.ox;
+
     XShmSegmentInfo shminfo;
     XImage *ximg;
     if (use_shm)
-        ximg = XShmCreateImage(server.display,
+        ximg = XShmCreateImage(ctx->display,
                                wa.visual,
                                (unsigned)wa.depth,
                                ZPixmap,
@@ -464,43 +807,40 @@ cairo_surface_t *get_window_thumbnail_ximage(Window win, size_t size, gboolean u
                                (unsigned)w,
                                (unsigned)h);
     else
-        ximg = XGetImage(server.display, win, 0, 0, (unsigned)w, (unsigned)h, AllPlanes, ZPixmap);
+        ximg = XGetImage(ctx->display, win, 0, 0, (unsigned)w, (unsigned)h, AllPlanes, ZPixmap);
     if (!ximg) {
         fprintf(stderr, RED "tint2: !ximg" RESET "\n");
         goto err0;
     }
-    if (ximg->bits_per_pixel != 24 && ximg->bits_per_pixel != 32) {
-        fprintf(stderr, RED "tint2: unusual bits_per_pixel" RESET "\n");
+    DownscaleSource source = {.width = (int)w, .height = (int)h};
+    if (!downscale_source_set_format(&source,
+                                     ximg->bits_per_pixel,
+                                     ximg->byte_order == MSBFirst,
+                                     ximg->red_mask,
+                                     ximg->green_mask,
+                                     ximg->blue_mask)) {
+        fprintf(stderr, RED "tint2: unusual pixel format" RESET "\n");
         goto err1;
     }
     if (use_shm) {
-        shminfo.shmid = shmget(IPC_PRIVATE, (size_t)(ximg->bytes_per_line * ximg->height), IPC_CREAT | 0777);
-        if (shminfo.shmid < 0) {
-            fprintf(stderr, RED "tint2: !shmget" RESET "\n");
+        ShmSegment *segment = shm_pool_acquire(ctx, (size_t)(ximg->bytes_per_line * ximg->height));
+        if (!segment)
             goto err1;
-        }
-        shminfo.shmaddr = ximg->data = (char *)shmat(shminfo.shmid, 0, 0);
-        if (shminfo.shmaddr == (void*)-1) {
-            fprintf(stderr, RED "tint2: !shmat" RESET "\n");
-            goto err2;
-        }
-        shminfo.readOnly = False;
-        if (!XShmAttach(server.display, &shminfo)) {
-            fprintf(stderr, RED "tint2: !xshmattach" RESET "\n");
-            goto err3;
-        }
-        if (!XShmGetImage(server.display, win, ximg, 0, 0, AllPlanes)) {
+        // XShmCreateImage keeps a pointer to the segment info in obdata; point it to the pooled segment
+        ximg->obdata = (char *)&segment->info;
+        ximg->data = segment->info.shmaddr;
+        if (!XShmGetImage(ctx->display, win, ximg, 0, 0, AllPlanes)) {
             fprintf(stderr, RED "tint2: !xshmgetimage" RESET "\n");
-            goto err4;
+            goto err1;
         }
     }
 
-    XGetWindowAttributes(server.display, win, &wa);
+    XGetWindowAttributes(ctx->display, win, &wa);
     if (wa.map_state != IsViewable) {
         if (debug_thumbnails) {
             fprintf(stderr, "tint2: could not get thumbnail, window not viewable\n");
         }
-        goto err4;
+        goto err1;
     }
 
     if (debug_thumbnails) {
@@ -509,104 +849,20 @@ cairo_surface_t *get_window_thumbnail_ximage(Window win, size_t size, gboolean u
                 tw, th, tw * th);
     }
 
+    source.data = (const unsigned char *)ximg->data;
+    source.bytes_per_line = ximg->bytes_per_line;
     result = cairo_image_surface_create(CAIRO_FORMAT_RGB24, (int)tw, (int)th);
     u_int32_t *data = (u_int32_t *)cairo_image_surface_get_data(result);
-    memset(data, 0, tw * th);
-
-    // Fixed-point precision
-    const size_t prec = 1 << 16;
-    const size_t xstep = w * prec / fw;
-    const size_t ystep = h * prec / th;
-
-    const size_t offset_y1 = 0 * ystep / 8;
-    const size_t offset_x1 = 3 * xstep / 8;
-
-    const size_t offset_y2 = 1 * ystep / 8;
-    const size_t offset_x2 = 6 * xstep / 8;
-
-    const size_t offset_y3 = 4 * ystep / 8;
-    const size_t offset_x3 = 2 * xstep / 8;
-
-    const size_t offset_y4 = 4 * ystep / 8;
-    const size_t offset_x4 = 4 * xstep / 8;
-
-    const size_t offset_y5 = 4 * ystep / 8;
-    const size_t offset_x5 = 7 * xstep / 8;
-
-    const size_t offset_y6 = 6 * ystep / 8;
-    const size_t offset_x6 = 1 * xstep / 8;
-
-    const size_t offset_y7 = 7 * ystep / 8;
-    const size_t offset_x7 = 6 * xstep / 8;
-
-    const u_int32_t rmask = (u_int32_t)ximg->red_mask;
-    const u_int32_t gmask = (u_int32_t)ximg->green_mask;
-    const u_int32_t bmask = (u_int32_t)ximg->blue_mask;
-    for (size_t yt = 0, y = 0; yt < th; yt++, y += ystep) {
-        for (size_t xt = 0, x = 0; xt < fw; xt++, x += xstep) {
-            size_t j = yt * tw + ox + xt;
-            if (j < tw * th) {
-                u_int32_t c1 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x1) / prec), (int)((y + offset_y1) / prec));
-                u_int32_t c2 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x2) / prec), (int)((y + offset_y2) / prec));
-                u_int32_t c3 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x3) / prec), (int)((y + offset_y3) / prec));
-                u_int32_t c4 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x4) / prec), (int)((y + offset_y4) / prec));
-                u_int32_t c5 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x5) / prec), (int)((y + offset_y5) / prec));
-                u_int32_t c6 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x6) / prec), (int)((y + offset_y6) / prec));
-                u_int32_t c7 = (u_int32_t)GetPixel(ximg, (int)((x + offset_x7) / prec), (int)((y + offset_y7) / prec));
-                u_int32_t b = ((c1 & bmask) + (c2 & bmask) + (c3 & bmask) + (c4 & bmask) + (c5 & bmask) * 2 + (c6 & bmask) +
-                               (c7 & bmask)) /
-                              8;
-                u_int32_t g = ((c1 & gmask) + (c2 & gmask) + (c3 & gmask) + (c4 & gmask) + (c5 & gmask) * 2 + (c6 & gmask) +
-                               (c7 & gmask)) /
-                              8;
-                u_int32_t r = ((c1 & rmask) + (c2 & rmask) + (c3 & rmask) + (c4 & rmask) + (c5 & rmask) * 2 + (c6 & rmask) +
-                               (c7 & rmask)) /
-                              8;
-                data[j] = (r & rmask) | (g & gmask) | (b & bmask);
-            }
-        }
-    }
-    // Convert to argb32
-    if (rmask & 0xff0000) {
-        // argb32 or rgb24 => Nothing to do
-    } else if (rmask & 0xff) {
-        // bgr24
-        for (size_t i = 0; i < tw * th; i++) {
-            u_int32_t r = (data[i] & rmask) << 16;
-            u_int32_t g = (data[i] & gmask);
-            u_int32_t b = (data[i] & bmask) >> 16;
-            data[i] = (r & 0xff0000) | (g & 0x00ff00) | (b & 0x0000ff);
-        }
-    } else if (rmask & 0xff00) {
-        // bgra32
-        for (size_t i = 0; i < tw * th; i++) {
-            u_int32_t r = (data[i] & rmask) << 8;
-            u_int32_t g = (data[i] & gmask) >> 8;
-            u_int32_t b = (data[i] & bmask) >> 24;
-            data[i] = (r & 0xff0000) | (g & 0x00ff00) | (b & 0x0000ff);
-        }
-    }
-
-    // 2nd pass
-    smooth_thumbnail(result);
+    const int stride = cairo_image_surface_get_stride(result) / 4;
+    cairo_surface_flush(result);
+    // The area average is smooth enough by itself, no second pass needed
+    downscale_area_average(&source, data + ox, stride, (int)fw, (int)th);
     cairo_surface_mark_dirty(result);
 
-    if (ximg) {
-        XDestroyImage(ximg);
-        ximg = NULL;
-    }
-err4:
-    if (use_shm)
-        XShmDetach(server.display, &shminfo);
-err3:
-    if (use_shm)
-        shmdt(shminfo.shmaddr);
-err2:
-    if (use_shm)
-        shmctl(shminfo.shmid, IPC_RMID, NULL);
 err1:
-    if (ximg)
-        XDestroyImage(ximg);
+    if (use_shm)
+        ximg->data = NULL;
+    XDestroyImage(ximg);
 err0:
     return result;
 }
@@ -623,13 +879,161 @@ gboolean cairo_surface_is_blank(cairo_surface_t *image_surface)
     return empty;
 }
 
+// Largest box filter applied by the X server in one pass. Larger downscaling factors are done in two passes.
+#define XRENDER_MAX_KERNEL_SIZE 15
+
+// Scales src (of size sw x sh) into the rectangle (dx, 0, dw, dh) of dst on the X server. Each destination pixel is
+// the average of the source pixels it covers (a box filter sized to the scaling factor), which unlike the bilinear
+// filters does not alias on large downscaling factors.
+static void xrender_downscale(Display *display, Picture src, int sw, int sh, Picture dst, int dx, int dw, int dh)
+{
+    XTransform transform = {{{XDoubleToFixed((double)sw / dw), XDoubleToFixed(0), XDoubleToFixed(0)},
+                             {XDoubleToFixed(0), XDoubleToFixed((double)sh / dh), XDoubleToFixed(0)},
+                             {XDoubleToFixed(0), XDoubleToFixed(0), XDoubleToFixed(1)}}};
+    XRenderSetPictureTransform(display, src, &transform);
+    // Odd sizes keep the kernel centered on the sampled point
+    int kw = MIN(((sw + dw - 1) / dw) | 1, XRENDER_MAX_KERNEL_SIZE);
+    int kh = MIN(((sh + dh - 1) / dh) | 1, XRENDER_MAX_KERNEL_SIZE);
+    XFixed params[2 + XRENDER_MAX_KERNEL_SIZE * XRENDER_MAX_KERNEL_SIZE];
+    params[0] = XDoubleToFixed(kw);
+    params[1] = XDoubleToFixed(kh);
+    for (int i = 0; i < kw * kh; i++)
+        params[2 + i] = XDoubleToFixed(1.0 / (kw * kh));
+    XRenderSetPictureFilter(display, src, FilterConvolution, params, 2 + kw * kh);
+    XRenderComposite(display, PictOpSrc, src, None, dst, 0, 0, 0, 0, dx, 0, (unsigned)dw, (unsigned)dh);
+}
+
+// Scales the window contents on the X server with an XRender transform, and transfers only the
+// thumbnail-sized result. Requires a compositing manager, so that the window contents are kept
+// in an offscreen pixmap even when the window is obscured.
+cairo_surface_t *get_window_thumbnail_xrender(ThumbnailContext *ctx, Window win, size_t size)
+{
+    cairo_surface_t *result = NULL;
+    XWindowAttributes wa = {};
+    ThumbnailGeometry geometry;
+    if (!get_thumbnail_geometry(ctx, win, size, &wa, &geometry))
+        return NULL;
+    const size_t w = geometry.w, h = geometry.h;
+    const size_t tw = geometry.tw, th = geometry.th;
+    const size_t fw = geometry.fw, ox = geometry.ox;
+
+    XRenderPictFormat *src_format = XRenderFindVisualFormat(ctx->display, wa.visual);
+    XRenderPictFormat *dst_format = XRenderFindStandardFormat(ctx->display, PictStandardARGB32);
+    if (!src_format || !dst_format)
+        return NULL;
+
+    // The error handler is process-wide: only the main thread installs it. Errors on other
+    // connections are forwarded to thumbnail_x_error_handler by the main handlers.
+    gboolean on_main_display = ctx->display == server.display;
+    XSync(ctx->display, False);
+    ctx->x_error = FALSE;
+    XErrorHandler old = on_main_display ? XSetErrorHandler(thumbnail_x_error_handler) : NULL;
+
+    // Name the window pixmap if the window itself is redirected. Client windows are usually
+    // reparented into a redirected frame instead; in that case read through the window,
+    // which the server serves from the frame's backing pixmap.
+    Drawable src_drawable = win;
+    Pixmap window_pixmap = XCompositeNameWindowPixmap(ctx->display, win);
+    XSync(ctx->display, False);
+    if (ctx->x_error) {
+        ctx->x_error = FALSE;
+        window_pixmap = None;
+    } else {
+        src_drawable = window_pixmap;
+    }
+
+    // Pad the edges, so that the filter does not blend them with transparent pixels
+    XRenderPictureAttributes pa;
+    pa.subwindow_mode = IncludeInferiors;
+    pa.repeat = RepeatPad;
+    Picture src = XRenderCreatePicture(ctx->display, src_drawable, src_format, CPSubwindowMode | CPRepeat, &pa);
+
+    Pixmap dst_pixmap = XCreatePixmap(ctx->display, ctx->root_win, (unsigned)tw, (unsigned)th, 32);
+    Picture dst = XRenderCreatePicture(ctx->display, dst_pixmap, dst_format, 0, NULL);
+    XRenderColor black = {0, 0, 0, 0xffff};
+    XRenderFillRectangle(ctx->display, PictOpSrc, dst, &black, 0, 0, (unsigned)tw, (unsigned)th);
+    if (w > XRENDER_MAX_KERNEL_SIZE * fw || h > XRENDER_MAX_KERNEL_SIZE * th) {
+        // Split the scaling factor evenly between two passes, through an intermediate image
+        const int iw = MAX((int)fw, (int)sqrt((double)w * fw));
+        const int ih = MAX((int)th, (int)sqrt((double)h * th));
+        Pixmap mid_pixmap = XCreatePixmap(ctx->display, ctx->root_win, (unsigned)iw, (unsigned)ih, 32);
+        Picture mid = XRenderCreatePicture(ctx->display, mid_pixmap, dst_format, CPRepeat, &pa);
+        xrender_downscale(ctx->display, src, (int)w, (int)h, mid, 0, iw, ih);
+        xrender_downscale(ctx->display, mid, iw, ih, dst, (int)ox, (int)fw, (int)th);
+        XRenderFreePicture(ctx->display, mid);
+        XFreePixmap(ctx->display, mid_pixmap);
+    } else {
+        xrender_downscale(ctx->display, src, (int)w, (int)h, dst, (int)ox, (int)fw, (int)th);
+    }
+
+    XImage *ximg = XGetImage(ctx->display, dst_pixmap, 0, 0, (unsigned)tw, (unsigned)th, AllPlanes, ZPixmap);
+    XSync(ctx->display, False);
+
+    // The image of a pixmap has no visual, hence no channel masks: they are those of the picture format.
+    // As in get_window_thumbnail_ximage, the byte order is that of the server.
+    DownscaleSource source = {.width = (int)tw, .height = (int)th};
+    if (ximg && !ctx->x_error &&
+        downscale_source_set_format(&source,
+                                    ximg->bits_per_pixel,
+                                    ximg->byte_order == MSBFirst,
+                                    (unsigned long)dst_format->direct.redMask << dst_format->direct.red,
+                                    (unsigned long)dst_format->direct.greenMask << dst_format->direct.green,
+                                    (unsigned long)dst_format->direct.blueMask << dst_format->direct.blue)) {
+        if (debug_thumbnails) {
+            fprintf(stderr,
+                    "tint2: creating cairo surface with size %zu x %zu = %zu px\n",
+                    tw, th, tw * th);
+        }
+        source.data = (const unsigned char *)ximg->data;
+        source.bytes_per_line = ximg->bytes_per_line;
+        result = cairo_image_surface_create(CAIRO_FORMAT_RGB24, (int)tw, (int)th);
+        u_int32_t *data = (u_int32_t *)cairo_image_surface_get_data(result);
+        const int stride = cairo_image_surface_get_stride(result) / 4;
+        cairo_surface_flush(result);
+        // Same size: only converts the pixels
+        downscale_area_average(&source, data, stride, (int)tw, (int)th);
+        cairo_surface_mark_dirty(result);
+    } else if (debug_thumbnails) {
+        fprintf(stderr, YELLOW "tint2: could not get thumbnail with XRender" RESET "\n");
+    }
+
+    if (ximg)
+        XDestroyImage(ximg);
+    XRenderFreePicture(ctx->display, dst);
+    XFreePixmap(ctx->display, dst_pixmap);
+    XRenderFreePicture(ctx->display, src);
+    if (window_pixmap)
+        XFreePixmap(ctx->display, window_pixmap);
+    XSync(ctx->display, False);
+    if (on_main_display)
+        XSetErrorHandler(old);
+
+    return result;
+}
+
+gboolean thumb_use_xrender = TRUE;
 gboolean thumb_use_shm = FALSE;
 
-cairo_surface_t *get_window_thumbnail(Window win, int size)
+cairo_surface_t *get_window_thumbnail_with(ThumbnailContext *ctx, Window win, int size)
 {
+    current_context = ctx;
     cairo_surface_t *image_surface = NULL;
-    if (thumb_use_shm && server.has_shm && server.composite_manager) {
-        image_surface = get_window_thumbnail_ximage(win, (size_t)size, TRUE);
+    if (thumb_use_xrender && server.composite_manager) {
+        image_surface = get_window_thumbnail_xrender(ctx, win, (size_t)size);
+        if (image_surface && cairo_surface_is_blank(image_surface)) {
+            cairo_surface_destroy(image_surface);
+            image_surface = NULL;
+        }
+        if (debug_thumbnails) {
+            if (!image_surface)
+                fprintf(stderr, YELLOW "tint2: XRender scaling failed, trying slower method" RESET "\n");
+            else
+                fprintf(stderr, "tint2: captured window using XRender\n");
+        }
+    }
+
+    if (!image_surface && thumb_use_shm && ctx->has_shm && server.composite_manager) {
+        image_surface = get_window_thumbnail_ximage(ctx, win, (size_t)size, TRUE);
         if (image_surface && cairo_surface_is_blank(image_surface)) {
             cairo_surface_destroy(image_surface);
             image_surface = NULL;
@@ -643,7 +1047,7 @@ cairo_surface_t *get_window_thumbnail(Window win, int size)
     }
 
     if (!image_surface) {
-        image_surface = get_window_thumbnail_ximage(win, (size_t)size, FALSE);
+        image_surface = get_window_thumbnail_ximage(ctx, win, (size_t)size, FALSE);
         if (image_surface && cairo_surface_is_blank(image_surface)) {
             cairo_surface_destroy(image_surface);
             image_surface = NULL;
@@ -656,8 +1060,13 @@ cairo_surface_t *get_window_thumbnail(Window win, int size)
         }
     }
 
-    if (!image_surface)
-        return NULL;
-
+    current_context = NULL;
     return image_surface;
 }
+
+cairo_surface_t *get_window_thumbnail(Window win, int size)
+{
+    if (!main_context)
+        main_context = thumbnail_context_new(server.display);
+    return get_window_thumbnail_with(main_context, win, size);
+}
@@ -33,7 +33,39 @@ void change_window_desktop(Window win, int desktop);
 int get_icon_count(gulong *data, int num);
 gulong *get_best_icon(gulong *data, int icon_count, int num, int *iw, int *ih, int best_icon_size);
 
+// Position of an entry inside the _NET_WM_ICON property of a window, in 32-bit units.
+// A zeroed location (width == 0) is invalid.
+typedef struct WindowIconLocation {
+    long offset;
+    int width;
+    int height;
+    int requested_size;
+} WindowIconLocation;
+
+// Fetches from _NET_WM_ICON only the ARGB data of the icon that best matches best_icon_size.
+// First only the (width, height) headers are read, then the pixels of the chosen entry.
+// If location is not NULL, it is used as a hint for where the entry was found last time,
+// and it is updated with the location of the returned entry.
+// Returns the entry including its 2-element (width, height) header, so the pixels start at index 2,
+// or NULL if the window has no usable icon. The caller must XFree the result.
+gulong *get_window_icon(Window win, int best_icon_size, int *iw, int *ih, WindowIconLocation *location);
+
 char *get_window_name(Window win);
 cairo_surface_t *get_window_thumbnail(Window win, int size);
+void init_window_thumbnails();
+// Releases the resources kept between thumbnail captures (e.g. MIT-SHM segments).
+void cleanup_window_thumbnails();
+
+// Thumbnail capture state bound to one X connection. Captures on a connection other than
+// server.display (e.g. from a worker thread) must use their own context.
+typedef struct ThumbnailContext ThumbnailContext;
+ThumbnailContext *thumbnail_context_new(Display *display);
+void thumbnail_context_free(ThumbnailContext *ctx);
+// Releases idle resources. Returns TRUE if some are still held.
+gboolean thumbnail_context_expire(ThumbnailContext *ctx);
+cairo_surface_t *get_window_thumbnail_with(ThumbnailContext *ctx, Window win, int size);
+// X error handler for thumbnail captures. Error handlers installed on the main thread must forward
+// errors from other connections here, since Xlib error handlers are process-wide.
+int thumbnail_x_error_handler(Display *d, XErrorEvent *e);
 
 #endif